@@ -21,10 +21,11 @@
 
 #include <eos/form-factors/form-factors.hh>
 #include <eos/b-decays/b-to-d-l-nu.hh>
-#include <eos/utils/integrate.hh>
+#include <eos/utils/integrate-impl.hh>
 #include <eos/utils/kinematic.hh>
 #include <eos/utils/options-impl.hh>
 #include <eos/utils/model.hh>
+#include <eos/utils/parameter_cache.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/save.hh>
@@ -58,6 +59,9 @@ namespace eos
 
         UsedParameter hbar;
 
+        // normalization of the pdfs, keyed on the integration range
+        ParameterCache<std::pair<double, double>, double> normalization_cache;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "SM"), p, o)),
             parameters(p),
@@ -69,7 +73,8 @@ namespace eos
             opt_l(o, "l", {"e", "mu", "tau"}, "mu"),
             m_l(p["mass::" + opt_l.value()], u),
             g_fermi(p["G_Fermi"], u),
-            hbar(p["hbar"], u)
+            hbar(p["hbar"], u),
+            normalization_cache(p, u)
         {
             form_factors = FormFactorFactory<PToP>::create("B->D::" + o.get("form-factors", "BCL2008"), p, o);
 
@@ -78,19 +83,22 @@ namespace eos
 
             u.uses(*form_factors);
             u.uses(*model);
+
+            // the lepton-flavour ratios rebind m_l to these masses
+            u.uses(p["mass::mu"].id());
+            u.uses(p["mass::tau"].id());
         }
 
-        //* normalized(|Vcb|=1) two-fold-distribution, cf. [DSD2014], eq. (12), p. 6
-        double normalized_two_differential_decay_width(const double & s, const double & c_theta_l) const
+        // kinematic factors and helicity amplitudes, shared by all distributions
+        struct Amplitudes
         {
-            //  d^2 Gamma, cf. [DSD2014], p. 6, eq. (13)
-            // Trigonometric identities
-            double c_theta_l_2 = c_theta_l * c_theta_l;
-            double s_theta_l_2 = 1.0 - c_theta_l_2;
-            double s_theta_l = std::sqrt(s_theta_l_2);
-            double c_2_theta_l = 2.0 * c_theta_l_2 - 1.0;
-            double s_2_theta_l = 2.0 * s_theta_l * c_theta_l;
+            double nD, p, v, ml_hat;
 
+            complex<double> hh0, hhtS, hhT;
+        };
+
+        Amplitudes amplitudes(const double & s) const
+        {
             double fp = form_factors->f_p(s);
             double f0 = form_factors->f_0(s);
             double fT = form_factors->f_t(s);
@@ -125,93 +133,57 @@ namespace eos
             const complex<double> hhT = - 2.0 * m_B * p * fT * tl / (m_B + m_D);
             const complex<double> hhtS = hht - hhS / ml_hat;
 
-            double result = 2.0 * nD * p * (
-                                            std::norm(hh0) * s_theta_l_2 + (1.0 - v) * power_of<2>(std::abs(hh0) * c_theta_l - std::abs(hhtS))
-                                            + 8.0 * ( ((2.0 - v) + v * c_2_theta_l) * std::norm(hhT) - ml_hat * std::real(hhT * (std::conj(hh0) - std::conj(hhtS) * c_theta_l)))
+            return Amplitudes{ nD, p, v, ml_hat, hh0, hhtS, hhT };
+        }
+
+        //* normalized(|Vcb|=1) two-fold-distribution, cf. [DSD2014], eq. (12), p. 6
+        double normalized_two_differential_decay_width(const double & s, const double & c_theta_l) const
+        {
+            //  d^2 Gamma, cf. [DSD2014], p. 6, eq. (13)
+            // Trigonometric identities
+            double c_theta_l_2 = c_theta_l * c_theta_l;
+            double s_theta_l_2 = 1.0 - c_theta_l_2;
+            double c_2_theta_l = 2.0 * c_theta_l_2 - 1.0;
+
+            const Amplitudes a = amplitudes(s);
+
+            double result = 2.0 * a.nD * a.p * (
+                                            std::norm(a.hh0) * s_theta_l_2 + (1.0 - a.v) * power_of<2>(std::abs(a.hh0) * c_theta_l - std::abs(a.hhtS))
+                                            + 8.0 * ( ((2.0 - a.v) + a.v * c_2_theta_l) * std::norm(a.hhT) - a.ml_hat * std::real(a.hhT * (std::conj(a.hh0) - std::conj(a.hhtS) * c_theta_l)))
                                             );
 
             return result;
         }
 
         // normalized to V_cb = 1, obtained using cf. [DSD2014], eq. (12), agrees with Sakaki'13 et al cf. [STTW2013]
-        double normalized_differential_decay_width(const double & s) const
+        double normalized_differential_decay_width(const Amplitudes & a) const
         {
-            double fp = form_factors->f_p(s);
-            double f0 = form_factors->f_0(s);
-            double fT = form_factors->f_t(s);
-            // running quark masses
-            double mbatmu = model->m_b_msbar(mu);
-            double mcatmu = model->m_c_msbar(mu);
-
-            double lam = lambda(m_B * m_B, m_D * m_D, s);
-            double p = sqrt(lam) / (2.0 * m_B);
-            // make sure we return NaN if s < m_l^2, v = lepton velocity in the dilepton rest frame
-            double v = (1.0 - m_l * m_l / s);
-            double v2 = v * v;
-            double ml_hat = sqrt(1.0 - v);
-            // universal electroweak correction, cf. [S1982]
-            double etaEW = 1.0066;
-            double nD = v2 * m_B * s * power_of<2>(g_fermi() * etaEW) / (256.0 * power_of<3>(M_PI * m_B));
-            // NP contributions in EFT including tensor operator (cf. [DSD2014]). (in SM cvl=1, and all other couplings are zero)
-            const WilsonCoefficients<BToC> wc = model->wilson_coefficients_b_to_c(opt_l.value(), false);
-            const complex<double> vl = wc.cvl() - 1.0;
-            const complex<double> vr = wc.cvr();
-            const complex<double> sl = wc.csl();
-            const complex<double> sr = wc.csr();
-            const complex<double> gV = vr + vl;
-            const complex<double> gA = vr - vl;
-            const complex<double> gS = sr + sl;
-            const complex<double> gP = sr - sl;
-            const complex<double> tl = wc.ct();
-            // helicity amplitudes, cf. [DSD2014] eqs. 13-14
-            const complex<double> hh0 = 2.0 * m_B * p * fp * (1.0 + gV) / sqrt(s) ;
-            const complex<double> hht = (1.0 + gV) * (m_B * m_B - m_D * m_D) * f0 / sqrt(s);
-            const complex<double> hhS = - gS * (m_B * m_B - m_D * m_D) * f0 / (mbatmu - mcatmu);
-            const complex<double> hhT = - 2.0 * m_B * p * fT * tl / (m_B + m_D);
-            const complex<double> hhtS = hht - hhS / ml_hat;
-
             // normalized(|V_cb|=1) differential decay width
-            return 4.0 / 3.0 * nD * p * ( std::norm(hh0) * (3.0 - v) + 3.0 * std::norm(hhtS) * (1.0 - v) + 16.0 * std::norm(hhT) * (3.0 - 2.0 * v) - 24.0 * ml_hat * std::real(hhT * std::conj(hh0)) );
+            return 4.0 / 3.0 * a.nD * a.p * ( std::norm(a.hh0) * (3.0 - a.v) + 3.0 * std::norm(a.hhtS) * (1.0 - a.v) + 16.0 * std::norm(a.hhT) * (3.0 - 2.0 * a.v) - 24.0 * a.ml_hat * std::real(a.hhT * std::conj(a.hh0)) );
+        }
+
+        double normalized_differential_decay_width(const double & s) const
+        {
+            return normalized_differential_decay_width(amplitudes(s));
         }
 
         // obtained using cf. [DSD2014], eq. (12), defined as int_1^0 d^2Gamma - int_0^-1 d^2Gamma
+        double numerator_differential_a_fb_leptonic(const Amplitudes & a) const
+        {
+            return - 4.0 * a.nD * a.p * ( std::abs(a.hh0) * std::abs(a.hhtS) * (1.0 - a.v) - 4.0 * a.ml_hat * std::real(a.hhT * std::conj(a.hhtS)) );
+        }
+
         double numerator_differential_a_fb_leptonic(const double & s) const
         {
-            double fp = form_factors->f_p(s);
-            double f0 = form_factors->f_0(s);
-            double fT = form_factors->f_t(s);
-            // running quark masses
-            double mbatmu = model->m_b_msbar(mu);
-            double mcatmu = model->m_c_msbar(mu);
+            return numerator_differential_a_fb_leptonic(amplitudes(s));
+        }
 
-            double lam = lambda(m_B * m_B, m_D * m_D, s);
-            double p = sqrt(lam) / (2.0 * m_B);
-            // make sure we return NaN if s < m_l^2, v = lepton velocity in the dilepton rest frame
-            double v = (1.0 - m_l * m_l / s);
-            double v2 = v * v;
-            double ml_hat = sqrt(1.0 - v);
-            // universal electroweak correction, cf. [S1982]
-            double etaEW = 1.0066;
-            double nD = v2 * m_B * s * power_of<2>(g_fermi() * etaEW) / (256.0 * power_of<3>(M_PI * m_B));
-            // NP contributions in EFT including tensor operator (cf. [DSD2014]). (in SM cvl=1, and all other couplings are zero)
-            const WilsonCoefficients<BToC> wc = model->wilson_coefficients_b_to_c(opt_l.value(), false);
-            const complex<double> vl = wc.cvl() - 1.0;
-            const complex<double> vr = wc.cvr();
-            const complex<double> sl = wc.csl();
-            const complex<double> sr = wc.csr();
-            const complex<double> gV = vr + vl;
-            const complex<double> gA = vr - vl;
-            const complex<double> gS = sr + sl;
-            const complex<double> gP = sr - sl;
-            const complex<double> tl = wc.ct();
-            // helicity amplitudes, cf. [DSD2014] eqs. 13-14
-            const complex<double> hh0 = 2.0 * m_B * p * fp * (1.0 + gV) / sqrt(s) ;
-            const complex<double> hht = (1.0 + gV) * (m_B * m_B - m_D * m_D) * f0 / sqrt(s);
-            const complex<double> hhS = - gS * (m_B * m_B - m_D * m_D) * f0 / (mbatmu - mcatmu);
-            const complex<double> hhT = - 2.0 * m_B * p * fT * tl / (m_B + m_D);
-            const complex<double> hhtS = hht - hhS / ml_hat;
+        // numerator and denominator of A_FB, evaluated from the same amplitudes
+        std::array<double, 2> a_fb_leptonic_integrands(const double & s) const
+        {
+            const Amplitudes a = amplitudes(s);
 
-            return - 4.0 * nD * p * ( std::abs(hh0) * std::abs(hhtS) * (1.0 - v) - 4.0 * ml_hat * std::real(hhT * std::conj(hhtS)) );
+            return std::array<double, 2>{{ numerator_differential_a_fb_leptonic(a), normalized_differential_decay_width(a) }};
         }
 
         // differential decay width
@@ -232,14 +204,24 @@ namespace eos
             return normalized_differential_decay_width(s) * tau_B / hbar;
         }
 
+        // integrated branching ratio, computed once per parameter point and shared by all pdfs
+        double normalization(const double & q2_min, const double & q2_max) const
+        {
+            return normalization_cache(std::make_pair(q2_min, q2_max), [&] ()
+            {
+                std::function<double (const double &)> f = std::bind(&Implementation<BToDLeptonNeutrino>::normalized_differential_branching_ratio, this, std::placeholders::_1);
+
+                return integrate<GSL::QAGS>(f, q2_min, q2_max);
+            });
+        }
+
         double pdf_q2(const double & q2) const
         {
             const double q2_min = power_of<2>(m_l());
             const double q2_max = power_of<2>(m_B() - m_D());
 
-            std::function<double (const double &)> f = std::bind(&Implementation<BToDLeptonNeutrino>::normalized_differential_branching_ratio, this, std::placeholders::_1);
             const double num   = normalized_differential_branching_ratio(q2);
-            const double denom = integrate1D(f, 32, q2_min, q2_max);
+            const double denom = normalization(q2_min, q2_max);
 
             return num / denom;
         }
@@ -259,8 +241,8 @@ namespace eos
             const double q2_abs_max = power_of<2>(m_B() - m_D());
 
             std::function<double (const double &)> f = std::bind(&Implementation<BToDLeptonNeutrino>::normalized_differential_branching_ratio, this, std::placeholders::_1);
-            const double num   = integrate<GSL::QAGS>(f, q2_min,     q2_max);
-            const double denom = integrate<GSL::QAGS>(f, q2_abs_min, q2_abs_max);
+            const double num   = integrate<GSL::QAGS>(f, q2_min, q2_max);
+            const double denom = normalization(q2_abs_min, q2_abs_max);
 
             return num / denom;
         }
@@ -275,33 +257,8 @@ namespace eos
             return integrated_pdf_q2(q2_min, q2_max) / (w_max - w_min);
         }
 
-        double lepton_polarization_numerator(const double & q2) const
-        {
-            const double m_l2 = m_l() * m_l();
-            const double m_B  = this->m_B(), m_B2 = m_B * m_B;
-            const double m_D  = this->m_D(), m_D2 = m_D * m_D;
-            const double p_D  = sqrt(eos::lambda(m_B2, m_D2, q2)) / (2.0 * m_B);
-            const double sqrt_q2  = sqrt(q2);
-
-            const double f_p = form_factors->f_p(q2);
-            const double f_0 = form_factors->f_0(q2);
-
-            // cf. [CJLP2012]
-            const double H_0 = 2.0 * m_B * p_D / sqrt_q2 * f_p;
-            const double H_t = (m_B2 - m_D2) / sqrt_q2 * f_0;
-
-            const double H_02 = H_0 * H_0;
-            const double H_t2 = H_t * H_t;
-
-            const double nf = p_D * q2 * pow(1.0 - m_l2 / q2, 2);
-
-            // cf. [CJLP2012]], eq. (20), p. 13
-            const double num  = H_02 * (1.0 - 0.5 * m_l2 / q2) - 3.0 / 2.0 * m_l2 / q2 * H_t2;
-
-            return nf * num;
-        }
-
-        double lepton_polarization_denominator(const double & q2) const
+        // numerator and denominator of the lepton polarization, evaluated from the same amplitudes
+        std::array<double, 2> lepton_polarization_integrands(const double & q2) const
         {
             const double m_l2 = m_l() * m_l();
             const double m_B  = this->m_B(), m_B2 = m_B * m_B;
@@ -322,19 +279,18 @@ namespace eos
             const double nf = p_D * q2 * pow(1.0 - m_l2 / q2, 2);
 
             // cf. [CJLP2012]], eq. (20), p. 13
+            const double num    = H_02 * (1.0 - 0.5 * m_l2 / q2) - 3.0 / 2.0 * m_l2 / q2 * H_t2;
             const double denom  = H_02 * (1.0 + 0.5 * m_l2 / q2) + 3.0 / 2.0 * m_l2 / q2 * H_t2;
 
-            return nf * denom;
+            return std::array<double, 2>{{ nf * num, nf * denom }};
         }
 
         double lepton_polarization(const double & q2_min, const double & q2_max) const
         {
-            std::function<double (const double &)> integrand_num   = std::bind(&Implementation<BToDLeptonNeutrino>::lepton_polarization_numerator,   this, std::placeholders::_1);
-            std::function<double (const double &)> integrand_denom = std::bind(&Implementation<BToDLeptonNeutrino>::lepton_polarization_denominator, this, std::placeholders::_1);
-            const auto num   = integrate<GSL::QAGS>(integrand_num,   q2_min, q2_max);
-            const auto denom = integrate<GSL::QAGS>(integrand_denom, q2_min, q2_max);
+            std::function<std::array<double, 2> (const double &)> integrand = std::bind(&Implementation<BToDLeptonNeutrino>::lepton_polarization_integrands, this, std::placeholders::_1);
+            const auto integrals = integrate<GSL::QAG>(integrand, q2_min, q2_max);
 
-            return num / denom;
+            return integrals[0] / integrals[1];
         }
     };
 
@@ -401,21 +357,11 @@ namespace eos
     double
     BToDLeptonNeutrino::integrated_a_fb_leptonic(const double & s_min, const double & s_max) const
     {
-        double integrated_numerator;
-        {
-            std::function<double (const double &)> f = std::bind(&Implementation<BToDLeptonNeutrino>::numerator_differential_a_fb_leptonic,
-                                                                 _imp.get(), std::placeholders::_1);
-            integrated_numerator = integrate<GSL::QAGS>(f, s_min, s_max);
-        }
-
-        double integrated_denominator;
-        {
-            std::function<double (const double &)> f = std::bind(&Implementation<BToDLeptonNeutrino>::normalized_differential_decay_width,
-                                                                 _imp.get(), std::placeholders::_1);
-            integrated_denominator = integrate<GSL::QAGS>(f, s_min, s_max);
-        }
+        std::function<std::array<double, 2> (const double &)> f = std::bind(&Implementation<BToDLeptonNeutrino>::a_fb_leptonic_integrands,
+                                                                                 _imp.get(), std::placeholders::_1);
+        const std::array<double, 2> integrals = integrate<GSL::QAG>(f, s_min, s_max);
 
-        return integrated_numerator / integrated_denominator;
+        return integrals[0] / integrals[1];
     }
 
     double
@@ -423,14 +369,14 @@ namespace eos
     {
         double br_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_opt_l(_imp->opt_l._value, "mu");
             br_muons = _imp->differential_branching_ratio(s);
         }
 
         double br_taus;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]);
             Save<std::string> save_opt_l(_imp->opt_l._value, "tau");
             br_taus = _imp->differential_branching_ratio(s);
         }
@@ -447,7 +393,7 @@ namespace eos
         double br_muons;
         {
 
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_opt_l(_imp->opt_l._value, "mu");
 
             br_muons = integrate<GSL::QAGS>(f, s_min_mu, s_max_mu);
@@ -455,7 +401,7 @@ namespace eos
 
         double br_taus;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]);
             Save<std::string> save_opt_l(_imp->opt_l._value, "tau");
 
             br_taus = integrate<GSL::QAGS>(f, s_min_tau, s_max_tau);
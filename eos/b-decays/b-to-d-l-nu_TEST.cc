@@ -21,6 +21,8 @@
 #include <eos/observable.hh>
 #include <eos/b-decays/b-to-d-l-nu.hh>
 #include <eos/utils/complex.hh>
+#include <eos/utils/observable_cache.hh>
+#include <eos/utils/power_of.hh>
 #include <eos/utils/wilson-polynomial.hh>
 
 #include <array>
@@ -234,5 +236,56 @@ class BToDLeptonNeutrinoTest :
                 TEST_CHECK_RELATIVE_ERROR(d.integrated_a_fb_leptonic(0.011164, 11.62), -0.621944, eps);
                 TEST_CHECK_RELATIVE_ERROR(d.integrated_r_d(0.011164, 3.15702, 11.62, 11.62), 1.43554, eps);
             }
+
+            // the cached pdf normalization follows changes of the parameters
+            {
+                Parameters p = Parameters::Defaults();
+                Options o{
+                    { "l",            "mu"      },
+                    { "form-factors", "BCL2008" }
+                };
+
+                BToDLeptonNeutrino d(p, o);
+
+                const double w_max = (power_of<2>(p["mass::B_d"]()) + power_of<2>(p["mass::D_d"]()) - power_of<2>(p["mass::mu"]()))
+                                   / (2.0 * p["mass::B_d"]() * p["mass::D_d"]());
+
+                const double eps = 1e-5;
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_pdf_w(1.0, w_max) * (w_max - 1.0), 1.0, eps);
+
+                const double pdf_before = d.differential_pdf_w(1.2);
+                TEST_CHECK_NEARLY_EQUAL(d.differential_pdf_w(1.2), pdf_before, 1e-15);
+
+                p["B->D::b_+^1@BCL2008"] = p["B->D::b_+^1@BCL2008"]() + 1.0;
+
+                BToDLeptonNeutrino fresh(p, o);
+                TEST_CHECK(std::abs(d.differential_pdf_w(1.2) - pdf_before) > 1e-6);
+                TEST_CHECK_NEARLY_EQUAL(d.differential_pdf_w(1.2),          fresh.differential_pdf_w(1.2),          1e-12);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_pdf_w(1.1, 1.3),       fresh.integrated_pdf_w(1.1, 1.3),       1e-12);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_pdf_w(1.0, w_max) * (w_max - 1.0), 1.0, eps);
+            }
+
+            // an incremental ObservableCache follows changes of the tau mass in R_D, with muons as the default lepton
+            {
+                Parameters p = Parameters::Defaults();
+                Kinematics k{ { "q2", 5.0 } };
+                Options o{
+                    { "l",            "mu"      },
+                    { "form-factors", "BCL2008" }
+                };
+
+                ObservableCache cache(p);
+                cache.set_incremental(true);
+                ObservableCache::Id id = cache.add(Observable::make("B->Dlnu::R_D(q2)", p, k, o));
+
+                cache.update();
+                const double r_d_before = cache[id];
+
+                p["mass::tau"] = p["mass::tau"]() + 0.1;
+                cache.update();
+
+                TEST_CHECK(std::abs(cache[id] - r_d_before) > 1e-6);
+                TEST_CHECK_NEARLY_EQUAL(cache[id], Observable::make("B->Dlnu::R_D(q2)", p, k, o)->evaluate(), 1e-12);
+            }
         }
 } b_to_d_l_nu_test;
@@ -6,6 +6,7 @@
 #include <eos/utils/integrate-impl.hh>
 #include <eos/utils/kinematic.hh>
 #include <eos/utils/options-impl.hh>
+#include <eos/utils/parameter_cache.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 
@@ -33,13 +34,23 @@ namespace eos
         // form factors
         std::shared_ptr<FormFactors<PToV>> ff;
 
+        // normalization and integrated angular coefficients of the pdfs, keyed on the q^2 range
+        ParameterCache<std::pair<double, double>, double> normalization_cache;
+        ParameterCache<std::pair<double, double>, std::array<double, 2u>> coefficients_d_cache;
+        ParameterCache<std::pair<double, double>, std::array<double, 3u>> coefficients_l_cache;
+        ParameterCache<std::pair<double, double>, std::array<double, 3u>> coefficients_chi_cache;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             opt_model(o, "model", { "SM", "CKMScan" }, "SM"),
             m_B(p["mass::B_d"], u),
             m_Dstar(p["mass::D_d^*"], u),
             opt_l(o, "l", { "e", "mu", "tau" }, "mu"),
             m_l(p["mass::" + opt_l.value()], u),
-            ff(FormFactorFactory<PToV>::create("B->D^*::" + o.get("form-factors", "HQET"), p, o))
+            ff(FormFactorFactory<PToV>::create("B->D^*::" + o.get("form-factors", "HQET"), p, o)),
+            normalization_cache(p, u),
+            coefficients_d_cache(p, u),
+            coefficients_l_cache(p, u),
+            coefficients_chi_cache(p, u)
         {
             if (! ff.get())
                 throw InternalError("Form factors not found!");
@@ -109,7 +120,8 @@ namespace eos
             return sqrt(lambda / q2) * ff->a_0(q2);
         }
 
-        double lepton_polarization_numerator(const double & q2) const
+        // numerator and denominator of the lepton polarization, evaluated from the same amplitudes
+        std::array<double, 2> lepton_polarization_integrands(const double & q2) const
         {
             const double nf = pdf_normalization(q2);
 
@@ -139,52 +151,17 @@ namespace eos
 
             // cf. [CJLP2012]], eq. (22), p. 17
             const double num   = (H_pp2 + H_mm2 + H_002) * (1.0 - m_l2 / (2.0 * q2)) - 3.0 * m_l2 / (2.0 * q2) * H_0t2;
-
-            return nf * num;
-        }
-
-        double lepton_polarization_denominator(const double & q2) const
-        {
-            const double nf = pdf_normalization(q2);
-
-            const double m_l2     = m_l() * m_l();
-            const double m_B      = this->m_B(),     m_B2     = m_B     * m_B;
-            const double m_Dstar  = this->m_Dstar(), m_Dstar2 = m_Dstar * m_Dstar;
-            const double p_Dstar  = sqrt(eos::lambda(m_B2, m_Dstar2, q2)) / (2.0 * m_B),
-                         p_Dstar2 = p_Dstar * p_Dstar;
-            const double sqrt_q2  = sqrt(q2);
-
-            const double a_0 = ff->a_0(q2);
-            const double a_1 = ff->a_1(q2);
-            const double a_2 = ff->a_2(q2);
-            const double v   = ff->v(q2);
-
-            // cf. [CJLP2012]
-            const double H_pp = (m_B + m_Dstar) * a_1 - 2.0 * m_B / (m_B + m_Dstar) * p_Dstar * v;
-            const double H_mm = (m_B + m_Dstar) * a_1 + 2.0 * m_B / (m_B + m_Dstar) * p_Dstar * v;
-            const double H_00 = ((m_B2 - m_Dstar2 - q2) * (m_B + m_Dstar) * a_1 - 4.0 * m_B2 * p_Dstar2 * a_2 / (m_B + m_Dstar))
-                              / (2.0 * m_Dstar * sqrt_q2);
-            const double H_0t = 2.0 * m_B * p_Dstar / sqrt_q2 * a_0;
-
-            const double H_pp2 = H_pp * H_pp;
-            const double H_mm2 = H_mm * H_mm;
-            const double H_002 = H_00 * H_00;
-            const double H_0t2 = H_0t * H_0t;
-
-            // cf. [CJLP2012]], eq. (22), p. 17
             const double denom = (H_pp2 + H_mm2 + H_002) * (1.0 + m_l2 / (2.0 * q2)) + 3.0 * m_l2 / (2.0 * q2) * H_0t2;
 
-            return nf * denom;
+            return std::array<double, 2>{{ nf * num, nf * denom }};
         }
 
         double lepton_polarization(const double & q2_min, const double & q2_max) const
         {
-            std::function<double (const double &)> integrand_num   = std::bind(&Implementation<BToDPiLeptonNeutrino>::lepton_polarization_numerator,   this, std::placeholders::_1);
-            std::function<double (const double &)> integrand_denom = std::bind(&Implementation<BToDPiLeptonNeutrino>::lepton_polarization_denominator, this, std::placeholders::_1);
-            const auto num   = integrate<GSL::QAGS>(integrand_num,   q2_min, q2_max);
-            const auto denom = integrate<GSL::QAGS>(integrand_denom, q2_min, q2_max);
+            std::function<std::array<double, 2> (const double &)> integrand = std::bind(&Implementation<BToDPiLeptonNeutrino>::lepton_polarization_integrands, this, std::placeholders::_1);
+            const auto integrals = integrate<GSL::QAG>(integrand, q2_min, q2_max);
 
-            return num / denom;
+            return integrals[0] / integrals[1];
         }
 
         double dist_q2(const double & q2) const
@@ -203,14 +180,24 @@ namespace eos
             return nf * a;
         }
 
+        // integrated q^2 distribution, computed once per parameter point and shared by all pdfs
+        double normalization(const double & q2_min, const double & q2_max) const
+        {
+            return normalization_cache(std::make_pair(q2_min, q2_max), [&] ()
+            {
+                std::function<double (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::dist_q2, this, std::placeholders::_1);
+
+                return integrate<GSL::QAGS>(f, q2_min, q2_max);
+            });
+        }
+
         double pdf_q2(const double & q2) const
         {
             const double q2_min = power_of<2>(m_l());
             const double q2_max = 10.68;
 
-            std::function<double (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::dist_q2, this, std::placeholders::_1);
             const double num   = dist_q2(q2);
-            const double denom = integrate1D(f, 32, q2_min, q2_max);
+            const double denom = normalization(q2_min, q2_max);
 
             return num / denom;
         }
@@ -230,8 +217,8 @@ namespace eos
             const double q2_abs_max = power_of<2>(m_B() - m_Dstar());
 
             std::function<double (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::dist_q2, this, std::placeholders::_1);
-            const double num   = integrate<GSL::QAGS>(f, q2_min,     q2_max);
-            const double denom = integrate<GSL::QAGS>(f, q2_abs_min, q2_abs_max);
+            const double num   = integrate<GSL::QAGS>(f, q2_min, q2_max);
+            const double denom = normalization(q2_abs_min, q2_abs_max);
 
             return num / denom;
         }
@@ -264,6 +251,20 @@ namespace eos
             return { nf * a, nf * b };
         }
 
+        // angular coefficients integrated over the full q^2 range, computed once per parameter point
+        std::array<double, 2u> integrated_coefficients_d() const
+        {
+            const double q2_min = power_of<2>(m_l());
+            const double q2_max = 10.68;
+
+            return coefficients_d_cache(std::make_pair(q2_min, q2_max), [&] ()
+            {
+                std::function<std::array<double, 2> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2d, this, std::placeholders::_1);
+
+                return integrate1D(f, 32, q2_min, q2_max);
+            });
+        }
+
         double pdf_q2d(const double & q2, const double & c_d) const
         {
             auto coeffs = pdf_coefficients_q2d(q2);
@@ -273,11 +274,7 @@ namespace eos
 
         double pdf_d(const double & c_d) const
         {
-            const double q2_min = power_of<2>(m_l());
-            const double q2_max = 10.68;
-
-            std::function<std::array<double, 2> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2d, this, std::placeholders::_1);
-            const auto coeffs = integrate1D(f, 32, q2_min, q2_max);
+            const auto coeffs = integrated_coefficients_d();
 
             const double num   = 3.0 / 2.0 * (coeffs[0] + coeffs[1] * c_d * c_d);
             const double denom = 3.0 * coeffs[0] + coeffs[1];
@@ -287,14 +284,10 @@ namespace eos
 
         double pdf_d(const double & c_d_min, const double & c_d_max) const
         {
-            const double q2_min = power_of<2>(m_l());
-            const double q2_max = 10.68;
-
             const double c_d_max3 = pow(c_d_max, 3);
             const double c_d_min3 = pow(c_d_min, 3);
 
-            std::function<std::array<double, 2> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2d, this, std::placeholders::_1);
-            const auto coeffs = integrate1D(f, 32, q2_min, q2_max);
+            const auto coeffs = integrated_coefficients_d();
 
             const double num   = 3.0 / 2.0 * (coeffs[0] * (c_d_max - c_d_min) + coeffs[1] * (c_d_max3 - c_d_min3) / 3.0);
             const double denom = 3.0 * coeffs[0] + coeffs[1];
@@ -329,6 +322,20 @@ namespace eos
             return { nf * a, nf * b, nf * c };
         }
 
+        // angular coefficients integrated over the full q^2 range, computed once per parameter point
+        std::array<double, 3u> integrated_coefficients_l() const
+        {
+            const double q2_min = power_of<2>(m_l());
+            const double q2_max = 10.68;
+
+            return coefficients_l_cache(std::make_pair(q2_min, q2_max), [&] ()
+            {
+                std::function<std::array<double, 3> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2l, this, std::placeholders::_1);
+
+                return integrate1D(f, 32, q2_min, q2_max);
+            });
+        }
+
         double pdf_q2l(const double & q2, const double & c_l) const
         {
             auto coeffs = pdf_coefficients_q2chi(q2);
@@ -338,11 +345,7 @@ namespace eos
 
         double pdf_l(const double & c_l) const
         {
-            const double q2_min = power_of<2>(m_l());
-            const double q2_max = 10.68;
-
-            std::function<std::array<double, 3> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2l, this, std::placeholders::_1);
-            const auto coeffs = integrate1D(f, 32, q2_min, q2_max);
+            const auto coeffs = integrated_coefficients_l();
 
             const double num   = 3.0 / 4.0 * (coeffs[0] + coeffs[1] * c_l + coeffs[2] * c_l * c_l);
             const double denom = (3.0 * coeffs[0] + coeffs[2]) / 2.0;
@@ -352,11 +355,7 @@ namespace eos
 
         double pdf_l(const double & c_l_min, const double & c_l_max) const
         {
-            const double q2_min = power_of<2>(m_l());
-            const double q2_max = 10.68;
-
-            std::function<std::array<double, 3> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2l, this, std::placeholders::_1);
-            const auto coeffs = integrate1D(f, 32, q2_min, q2_max);
+            const auto coeffs = integrated_coefficients_l();
 
             double num         = coeffs[0] * (c_l_max - c_l_min);
             num               += coeffs[1] * (c_l_max * c_l_max - c_l_min * c_l_min) / 2.0;
@@ -395,6 +394,20 @@ namespace eos
             return { nf * a, nf * b, nf * c };
         }
 
+        // angular coefficients integrated over the full q^2 range, computed once per parameter point
+        std::array<double, 3u> integrated_coefficients_chi() const
+        {
+            const double q2_min = power_of<2>(m_l());
+            const double q2_max = 10.68;
+
+            return coefficients_chi_cache(std::make_pair(q2_min, q2_max), [&] ()
+            {
+                std::function<std::array<double, 3> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2chi, this, std::placeholders::_1);
+
+                return integrate1D(f, 32, q2_min, q2_max);
+            });
+        }
+
         double pdf_q2chi(const double & q2, const double & c_chi) const
         {
             auto coeffs = pdf_coefficients_q2chi(q2);
@@ -404,11 +417,7 @@ namespace eos
 
         double pdf_chi(const double & chi) const
         {
-            const double q2_min = power_of<2>(m_l());
-            const double q2_max = 10.68;
-
-            std::function<std::array<double, 3> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2chi, this, std::placeholders::_1);
-            const auto coeffs = integrate1D(f, 32, q2_min, q2_max);
+            const auto coeffs = integrated_coefficients_chi();
 
             const double c_chi = cos(chi);
 
@@ -420,11 +429,7 @@ namespace eos
 
         double pdf_chi(const double & chi_min, const double & chi_max) const
         {
-            const double q2_min = power_of<2>(m_l());
-            const double q2_max = 10.68;
-
-            std::function<std::array<double, 3> (const double &)> f = std::bind(&Implementation<BToDPiLeptonNeutrino>::pdf_coefficients_q2chi, this, std::placeholders::_1);
-            const auto coeffs = integrate1D(f, 32, q2_min, q2_max);
+            const auto coeffs = integrated_coefficients_chi();
 
             const double c_chi_min = cos(chi_min), c_chi_max = cos(chi_max);
             const double s_chi_min = sin(chi_min), s_chi_max = sin(chi_max);
@@ -229,6 +229,10 @@ namespace eos
             u.uses(*form_factors);
             u.uses(*model);
 
+            // the lepton-flavour ratios rebind m_l to these masses
+            u.uses(p["mass::mu"].id());
+            u.uses(p["mass::tau"].id());
+
         }
 
         // normalization cf. [DSD2014] eq. (7), p. 5
@@ -261,13 +265,14 @@ namespace eos
             const complex<double> TL = wc.ct();
 
             // form factors
-            double aff0  = form_factors->a_0(s);
-            double aff1  = form_factors->a_1(s);
-            double aff2  = form_factors->a_2(s);
-            double vff   = form_factors->v(s);
-            double tff1  = form_factors->t_1(s);
-            double tff2  = form_factors->t_2(s);
-            double tff3  = form_factors->t_3(s);
+            const FormFactors<PToV>::Values ff = form_factors->compute_all(s);
+            double aff0  = ff.a_0;
+            double aff1  = ff.a_1;
+            double aff2  = ff.a_2;
+            double vff   = ff.v;
+            double tff1  = ff.t_1;
+            double tff2  = ff.t_2;
+            double tff3  = ff.t_3;
             // running quark masses
             double mbatmu = model->m_b_msbar(mu);
             double mcatmu = model->m_c_msbar(mu);
@@ -359,14 +364,14 @@ namespace eos
     {
         double br_tau;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]);
             Save<std::string> save_opt_l(_imp->opt_l._value, "tau");
             br_tau = this->normalized_differential_branching_ratio(s);
         }
 
         double br_mu;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_opt_l(_imp->opt_l._value, "mu");
             br_mu = this->normalized_differential_branching_ratio(s);
         }
@@ -401,7 +406,7 @@ namespace eos
 
         double br_mu;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_opt_l(_imp->opt_l._value, "mu");
             
             br_mu = this->normalized_integrated_branching_ratio(s_min_mu, s_max_mu);
@@ -409,7 +414,7 @@ namespace eos
 
         double br_tau;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]);
             Save<std::string> save_opt_l(_imp->opt_l._value, "tau");
             
             br_tau = this->normalized_integrated_branching_ratio(s_min_tau, s_max_tau);
@@ -69,6 +69,10 @@ namespace eos
 
             u.uses(*form_factors);
             u.uses(*model);
+
+            // the lepton-flavour ratios rebind m_l to these masses
+            u.uses(p["mass::mu"].id());
+            u.uses(p["mass::tau"].id());
         }
 
         double F12T(const double & s) const { return form_factors->f_time12_v(s); };
@@ -275,13 +279,13 @@ namespace eos
     {
         double br_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             br_muons = _imp->differential_branching_ratio(s);
         }
 
         double br_taus;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]);
             br_taus = _imp->differential_branching_ratio(s);
         }
 
@@ -296,13 +300,13 @@ namespace eos
 
         double br_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             br_muons = integrate<GSL::QAGS>(f, power_of<2>(_imp->parameters["mass::mu"]()), power_of<2>(_imp->m_LambdaB - _imp->m_LambdaC2625));
         }
 
         double br_taus;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::tau"]);
             br_taus = integrate<GSL::QAGS>(f, power_of<2>(_imp->parameters["mass::tau"]()), power_of<2>(_imp->m_LambdaB - _imp->m_LambdaC2625));
         }
 
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=marker foldmarker={{{,}}} : */
 
 /*
- * Copyright (c) 2011-2018 Danny van Dyk
+ * Copyright (c) 2011-2018, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,7 +21,12 @@
 
 #include <eos/constraint.hh>
 #include <eos/statistics/log-likelihood.hh>
+#include <eos/utils/binary-database.hh>
 #include <eos/utils/exception.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
@@ -35,6 +40,7 @@
 
 #include <cmath>
 #include <map>
+#include <set>
 #include <vector>
 
 namespace fs = boost::filesystem;
@@ -1611,104 +1617,254 @@ namespace eos
         return std::bind(&Factory_::make, f, std::placeholders::_1, std::placeholders::_2);
     }
 
-    std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>
-    load_constraint_entries()
+    namespace
     {
-        using ValueType = std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>::value_type;
+        fs::path constraints_base_directory()
+        {
+            fs::path base;
+            if (std::getenv("EOS_TESTS_CONSTRAINTS"))
+            {
+                std::string envvar = std::string(std::getenv("EOS_TESTS_CONSTRAINTS"));
+                base = fs::system_complete(envvar);
+            }
+            else if (std::getenv("EOS_HOME"))
+            {
+                std::string envvar = std::string(std::getenv("EOS_HOME"));
+                base = fs::system_complete(envvar) / "constraints";
+            }
+            else
+            {
+                base = fs::system_complete(EOS_DATADIR "/eos/constraints/");
+            }
 
-        std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> result;
+            if (! fs::exists(base))
+            {
+                throw InternalError("Could not find the constraint input files");
+            }
 
-        fs::path base;
-        if (std::getenv("EOS_TESTS_CONSTRAINTS"))
-        {
-            std::string envvar = std::string(std::getenv("EOS_TESTS_CONSTRAINTS"));
-            base = fs::system_complete(envvar);
-        }
-        else if (std::getenv("EOS_HOME"))
-        {
-            std::string envvar = std::string(std::getenv("EOS_HOME"));
-            base = fs::system_complete(envvar) / "constraints";
-        }
-        else
-        {
-            base = fs::system_complete(EOS_DATADIR "/eos/constraints/");
-        }
+            if (! fs::is_directory(base))
+            {
+                throw InternalError("Expect '" + base.string() + " to be a directory");
+            }
 
-        if (! fs::exists(base))
-        {
-            throw InternalError("Could not find the constraint input files");
+            return base;
         }
 
-        if (! fs::is_directory(base))
+        /*
+         * Call f(name, node) for each entry of all constraint input files.
+         */
+        void
+        for_each_constraint_source(const fs::path & base,
+                const std::function<void (const std::string & file, const std::string & keyname, const YAML::Node & node)> & f)
         {
-            throw InternalError("Expect '" + base.string() + " to be a directory");
+            for (fs::directory_iterator i(base), i_end ; i != i_end ; ++i)
+            {
+                auto file_path = i->path();
+
+                if (! fs::is_regular_file(status(file_path)))
+                    continue;
+
+                if (".yaml" != file_path.extension().string())
+                    continue;
+
+                std::string file = file_path.string();
+                try
+                {
+                    YAML::Node node = YAML::LoadFile(file);
+
+                    for (auto && p : node)
+                    {
+                        std::string keyname = p.first.Scalar();
+
+                        if ("@metadata@" == keyname)
+                            continue;
+
+                        f(file, keyname, p.second);
+                    }
+                }
+                catch (ConstraintDeserializationError & e)
+                {
+                    throw ConstraintInputFileParseError(file, e.what());
+                }
+            }
         }
 
-        for (fs::directory_iterator f(base), f_end ; f != f_end ; ++f)
+        /*
+         * The known constraint entries.
+         *
+         * If the constraint directory contains an up-to-date binary database, the
+         * entries are deserialized only on first access. Otherwise, all input files
+         * are parsed at once.
+         */
+        struct ConstraintEntries :
+            public InstantiationPolicy<ConstraintEntries, Singleton>
         {
-            auto file_path = f->path();
+            using ValueType = std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>>::value_type;
 
-            if (! fs::is_regular_file(status(file_path)))
-                continue;
+            std::string database_file;
 
-            if (".yaml" != file_path.extension().string())
-                continue;
+            std::unique_ptr<BinaryDatabase> database;
 
-            std::string file = file_path.string();
-            try
+            std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> entries;
+
+            // true if all entries have been deserialized
+            bool complete;
+
+            Mutex mutex;
+
+            ConstraintEntries() :
+                complete(false)
             {
-                YAML::Node node = YAML::LoadFile(file);
+                fs::path base = constraints_base_directory();
 
-                for (auto && p : node)
+                database_file = (base / "constraints.db").string();
+                if (BinaryDatabase::up_to_date(database_file, base.string()))
                 {
-                    std::string keyname = p.first.Scalar();
+                    try
+                    {
+                        database.reset(new BinaryDatabase(database_file));
 
-                    if ("@metadata@" == keyname)
-                        continue;
+                        return;
+                    }
+                    catch (BinaryDatabaseError & e)
+                    {
+                        Log::instance()->message("[constraints.entries]", ll_warning)
+                            << "Ignoring the constraint database: " << e.what();
+                    }
+                }
+
+                read_yaml();
+            }
 
+            // requires the mutex to be locked, unless called from the constructor
+            void read_yaml()
+            {
+                entries.clear();
+
+                for_each_constraint_source(constraints_base_directory(), [&] (const std::string & file, const std::string & keyname, const YAML::Node & node)
+                {
                     QualifiedName name(keyname);
-                    std::shared_ptr<const ConstraintEntry> entry{ ConstraintEntry::FromYAML(name, p.second) };
+                    std::shared_ptr<const ConstraintEntry> entry{ ConstraintEntry::FromYAML(name, node) };
 
-                    if (! result.insert(ValueType{ name, entry }).second)
+                    if (! entries.insert(ValueType{ name, entry }).second)
                     {
                         throw ConstraintInputFileParseError(file, "encountered duplicate constraint '" + keyname + "'");
                     }
+                });
+                complete = true;
+            }
+
+            // requires the mutex to be locked
+            // returns an empty pointer if the record is corrupt; all entries are then read from the input files instead
+            std::shared_ptr<const ConstraintEntry> deserialize(const BinaryDatabase::Record & record)
+            {
+                std::string keyname, source;
+                YAML::Node node;
+                try
+                {
+                    BinaryRecordReader reader(record);
+                    reader >> keyname >> source;
+                    node = YAML::Load(source);
+                }
+                catch (InternalError & e)
+                {
+                    ignore_database(e.what());
+
+                    return {};
+                }
+                catch (YAML::Exception & e)
+                {
+                    ignore_database(e.what());
+
+                    return {};
+                }
+
+                QualifiedName name(keyname);
+                try
+                {
+                    std::shared_ptr<const ConstraintEntry> entry{ ConstraintEntry::FromYAML(name, node) };
+                    entries.insert(ValueType{ name, entry });
+
+                    return entry;
+                }
+                catch (ConstraintDeserializationError & e)
+                {
+                    throw ConstraintInputFileParseError(database_file, e.what());
                 }
             }
-            catch (ConstraintDeserializationError & e)
+
+            // requires the mutex to be locked
+            void ignore_database(const std::string & reason)
             {
-                throw ConstraintInputFileParseError(file, e.what());
+                Log::instance()->message("[constraints.entries]", ll_warning)
+                    << "Ignoring the corrupt constraint database: " << reason;
+
+                database.reset();
+                read_yaml();
             }
-        }
 
-        return result;
-    }
+            std::shared_ptr<const ConstraintEntry> find(const QualifiedName & name)
+            {
+                Lock l(mutex);
 
-    static
-    const std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> &
-    make_constraint_entries()
-    {
-        static const std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> entries = load_constraint_entries();
+                auto e = entries.find(name);
+                if (entries.end() != e)
+                    return e->second;
+
+                if (complete)
+                    return {};
+
+                BinaryDatabase::Record record;
+                if (! database->find(name.str(), record))
+                    return {};
+
+                if (auto entry = deserialize(record))
+                    return entry;
+
+                e = entries.find(name);
+                if (entries.end() != e)
+                    return e->second;
+
+                return {};
+            }
 
-        return entries;
+            const std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> & all()
+            {
+                Lock l(mutex);
+
+                if (! complete)
+                {
+                    // a corrupt record replaces the database by the input files, and completes the entries
+                    for (std::size_t i = 0 ; (! complete) && (i < database->size()) ; ++i)
+                    {
+                        if (entries.end() != entries.find(QualifiedName(database->key(i))))
+                            continue;
+
+                        deserialize(database->value(i));
+                    }
+
+                    complete = true;
+                }
+
+                return entries;
+            }
+        };
     }
 
     /*
      * Adding a new constraint:
      * 1. Instantiate an existing ConstraintEntry in namespace entries{...}
-     * 2. Add an entry to the map in make_constraint_entries
+     * 2. Add an entry to one of the constraint input files
      * 4. Run constraint_TEST and check text output for new constraint
      */
     Constraint
     Constraint::make(const QualifiedName & name, const Options & options)
     {
-        auto & entries = make_constraint_entries();
-
-        auto e = entries.find(name);
-        if (e == entries.end())
+        auto entry = ConstraintEntries::instance()->find(name);
+        if (! entry)
             throw UnknownConstraintError(name);
 
-        return e->second->make(e->first, options);
+        return entry->make(entry->name(), options);
     }
 
     template <>
@@ -1724,7 +1880,7 @@ namespace eos
         const std::map<QualifiedName, std::shared_ptr<const ConstraintEntry>> constraint_entries;
 
         Implementation() :
-            constraint_entries(make_constraint_entries())
+            constraint_entries(ConstraintEntries::instance()->all())
         {
         }
     };
@@ -1738,6 +1894,35 @@ namespace eos
     {
     }
 
+    void
+    Constraints::compile_database(const std::string & directory, const std::string & file)
+    {
+        std::vector<std::pair<std::string, std::string>> records;
+        std::set<QualifiedName> names;
+
+        // compute the digest before reading the input files, such that a concurrent modification leaves the database stale
+        const std::uint64_t digest = BinaryDatabase::input_digest(fs::system_complete(directory).string());
+
+        for_each_constraint_source(fs::system_complete(directory), [&] (const std::string & file, const std::string & keyname, const YAML::Node & node)
+        {
+            // make sure that the entry can be deserialized later on
+            QualifiedName name(keyname);
+            std::unique_ptr<const ConstraintEntry> entry{ ConstraintEntry::FromYAML(name, node) };
+
+            if (! names.insert(name).second)
+            {
+                throw ConstraintInputFileParseError(file, "encountered duplicate constraint '" + keyname + "'");
+            }
+
+            BinaryRecordWriter writer;
+            writer << keyname << YAML::Dump(node);
+
+            records.push_back(std::make_pair(name.str(), writer.str()));
+        });
+
+        BinaryDatabase::write(file, records, digest);
+    }
+
     Constraints::ConstraintIterator
     Constraints::begin() const
     {
@@ -164,6 +164,19 @@ namespace eos
          * @param name  The name of the ConstraintEntry that shall be retrieved.
          */
         std::shared_ptr<const ConstraintEntry> operator[] (const QualifiedName & name) const;
+
+        /*!
+         * Compile the constraint input files into a binary database.
+         *
+         * Constraint::make reads the file 'constraints.db' instead of the input files,
+         * if it is present and was compiled from the current input files, as
+         * determined by a digest of their names and contents. Only the requested
+         * entries are then deserialized.
+         *
+         * @param directory The directory of the constraint input files.
+         * @param file      The name of the database file.
+         */
+        static void compile_database(const std::string & directory, const std::string & file);
     };
 
     extern template class WrappedForwardIterator<Constraints::ConstraintIteratorTag, const std::pair<const QualifiedName, std::shared_ptr<const ConstraintEntry>>>;
@@ -17,12 +17,15 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <config.h>
 #include <test/test.hh>
 #include <eos/constraint.hh>
 #include <eos/statistics/log-likelihood.hh>
+#include <eos/utils/binary-database.hh>
 
 #include <yaml-cpp/yaml.h>
 
+#include <cstdio>
 #include <iostream>
 #include <vector>
 
@@ -924,5 +927,25 @@ class ConstraintTest :
                     TEST_CHECK(c.get() != nullptr);
                 }
             }
+
+            /* Test compiling the constraint database */
+            {
+                static const std::string filename(EOS_BUILDDIR "/eos/constraint_TEST.db");
+
+                Constraints::compile_database(EOS_SRCDIR "/eos/constraints", filename);
+
+                BinaryDatabase database(filename);
+                BinaryDatabase::Record record;
+
+                unsigned n = 0;
+                for (auto & c : Constraints())
+                {
+                    TEST_CHECK(database.find(c.first.str(), record));
+                    ++n;
+                }
+                TEST_CHECK_EQUAL(n, database.size());
+
+                std::remove(filename.c_str());
+            }
         }
 } constraint_test;
@@ -2755,45 +2755,46 @@ namespace eos
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_fp_2pt_m1(sigma_0, q2);
 
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
+            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
+            const double surface_2pt     = 0.0 - surface_fp_2pt(sigma_0, q2);
+
+            double integral_3pt_m1 = 0.0, integral_3pt = 0.0;
+            double surface_3pt_m1  = 0.0, surface_3pt  = 0.0;
 
             if (switch_3pt != 0.0)
             {
                 const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_fp_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
                 const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_fp_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_fp_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_fp_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fp_3pt_B, this, std::placeholders::_1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fp_3pt_C, this, std::placeholders::_1, sigma_0, q2);
 
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
+                // integrate the moment and the form factor on a common subdivision of their domains
+                const cubature::fvd<3, 2> integrand_3pt = [this, &q2] (const std::array<double, 3> & x) -> std::array<double, 2>
+                {
+                    return {{ this->integrand_fp_3pt_m1(x, q2), this->integrand_fp_3pt(x, q2) }};
+                };
+                const cubature::fvd<2, 2> surface_3pt_A = [this, &sigma_0, &q2] (const std::array<double, 2> & x) -> std::array<double, 2>
+                {
+                    return {{ this->surface_fp_3pt_A_m1(x, sigma_0, q2), this->surface_fp_3pt_A(x, sigma_0, q2) }};
+                };
+
+                const std::array<double, 2> integrals_3pt  = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
+                const std::array<double, 2> surfaces_3pt_A = integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()); // integrate over x_1 and x_2
+
+                integral_3pt_m1 = integrals_3pt[0];
+                integral_3pt    = integrals_3pt[1];
                 surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
+                                - surfaces_3pt_A[0]
                                 - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
                                 - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
                                 - surface_fp_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_fp_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fp_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fp_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fp_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fp_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
                 surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
+                                - surfaces_3pt_A[1]
+                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                               // integrate over x_1
+                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                               // integrate over x_2
                                 - surface_fp_3pt_D(sigma_0, q2);
             }
+            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
             const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
 
             return numerator / denominator;
@@ -5494,45 +5495,46 @@ namespace eos
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_fpm_2pt_m1(sigma_0, q2);
 
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
+            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
+            const double surface_2pt     = 0.0 - surface_fpm_2pt(sigma_0, q2);
+
+            double integral_3pt_m1 = 0.0, integral_3pt = 0.0;
+            double surface_3pt_m1  = 0.0, surface_3pt  = 0.0;
 
             if (switch_3pt != 0.0)
             {
                 const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_fpm_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
                 const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_fpm_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_fpm_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_fpm_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fpm_3pt_B, this, std::placeholders::_1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fpm_3pt_C, this, std::placeholders::_1, sigma_0, q2);
 
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
+                // integrate the moment and the form factor on a common subdivision of their domains
+                const cubature::fvd<3, 2> integrand_3pt = [this, &q2] (const std::array<double, 3> & x) -> std::array<double, 2>
+                {
+                    return {{ this->integrand_fpm_3pt_m1(x, q2), this->integrand_fpm_3pt(x, q2) }};
+                };
+                const cubature::fvd<2, 2> surface_3pt_A = [this, &sigma_0, &q2] (const std::array<double, 2> & x) -> std::array<double, 2>
+                {
+                    return {{ this->surface_fpm_3pt_A_m1(x, sigma_0, q2), this->surface_fpm_3pt_A(x, sigma_0, q2) }};
+                };
+
+                const std::array<double, 2> integrals_3pt  = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
+                const std::array<double, 2> surfaces_3pt_A = integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()); // integrate over x_1 and x_2
+
+                integral_3pt_m1 = integrals_3pt[0];
+                integral_3pt    = integrals_3pt[1];
                 surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
+                                - surfaces_3pt_A[0]
                                 - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
                                 - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
                                 - surface_fpm_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_fpm_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fpm_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fpm_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fpm_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fpm_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
                 surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
+                                - surfaces_3pt_A[1]
+                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                               // integrate over x_1
+                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                               // integrate over x_2
                                 - surface_fpm_3pt_D(sigma_0, q2);
             }
+            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
             const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
 
             return numerator / denominator;
@@ -8369,45 +8371,46 @@ namespace eos
             const double integral_2pt_m1 = integrate<GSL::QAGS>(integrand_2pt_m1, 0.0, sigma_0);
             const double surface_2pt_m1  = 0.0 - surface_fT_2pt_m1(sigma_0, q2);
 
-            double integral_3pt_m1 = 0.0;
-            double surface_3pt_m1  = 0.0;
+            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
+            const double surface_2pt     = 0.0 - surface_fT_2pt(sigma_0, q2);
+
+            double integral_3pt_m1 = 0.0, integral_3pt = 0.0;
+            double surface_3pt_m1  = 0.0, surface_3pt  = 0.0;
 
             if (switch_3pt != 0.0)
             {
                 const std::function<double (const double &)> surface_3pt_B_m1 = std::bind(&Implementation::surface_fT_3pt_B_m1, this, std::placeholders::_1, sigma_0, q2);
                 const std::function<double (const double &)> surface_3pt_C_m1 = std::bind(&Implementation::surface_fT_3pt_C_m1, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt_m1 = std::bind(&Implementation::integrand_fT_3pt_m1, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A_m1 = std::bind(&Implementation::surface_fT_3pt_A_m1, this, std::placeholders::_1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fT_3pt_B, this, std::placeholders::_1, sigma_0, q2);
+                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fT_3pt_C, this, std::placeholders::_1, sigma_0, q2);
 
-                integral_3pt_m1 = integrate(integrand_3pt_m1, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
+                // integrate the moment and the form factor on a common subdivision of their domains
+                const cubature::fvd<3, 2> integrand_3pt = [this, &q2] (const std::array<double, 3> & x) -> std::array<double, 2>
+                {
+                    return {{ this->integrand_fT_3pt_m1(x, q2), this->integrand_fT_3pt(x, q2) }};
+                };
+                const cubature::fvd<2, 2> surface_3pt_A = [this, &sigma_0, &q2] (const std::array<double, 2> & x) -> std::array<double, 2>
+                {
+                    return {{ this->surface_fT_3pt_A_m1(x, sigma_0, q2), this->surface_fT_3pt_A(x, sigma_0, q2) }};
+                };
+
+                const std::array<double, 2> integrals_3pt  = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
+                const std::array<double, 2> surfaces_3pt_A = integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()); // integrate over x_1 and x_2
+
+                integral_3pt_m1 = integrals_3pt[0];
+                integral_3pt    = integrals_3pt[1];
                 surface_3pt_m1  = 0.0
-                                - integrate(surface_3pt_A_m1, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
+                                - surfaces_3pt_A[0]
                                 - integrate<GSL::QAGS>(surface_3pt_B_m1, 0.0, 1.0)                            // integrate over x_1
                                 - integrate<GSL::QAGS>(surface_3pt_C_m1, 0.0, 1.0)                            // integrate over x_2
                                 - surface_fT_3pt_D_m1(sigma_0, q2);
-            }
-            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
-
-            const double integral_2pt    = integrate<GSL::QAGS>(integrand_2pt, 0.0, sigma_0);
-            const double surface_2pt     = 0.0 - surface_fT_2pt(sigma_0, q2);
-
-            double integral_3pt    = 0.0;
-            double surface_3pt     = 0.0;
-
-            if (switch_3pt != 0.0)
-            {
-                const std::function<double (const double &)> surface_3pt_B    = std::bind(&Implementation::surface_fT_3pt_B, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const double &)> surface_3pt_C    = std::bind(&Implementation::surface_fT_3pt_C, this, std::placeholders::_1, sigma_0, q2);
-                const std::function<double (const std::array<double, 3> &)> integrand_3pt = std::bind(&Implementation::integrand_fT_3pt, this, std::placeholders::_1, q2);
-                const std::function<double (const std::array<double, 2> &)> surface_3pt_A = std::bind(&Implementation::surface_fT_3pt_A, this, std::placeholders::_1, sigma_0, q2);
-
-                integral_3pt    = integrate(integrand_3pt, { 0.0, 0.0, 0.0 }, { sigma_0, 1.0, 1.0 }, cubature::Config());
                 surface_3pt     = 0.0
-                                - integrate(surface_3pt_A, { 0.0, 0.0 }, { 1.0, 1.0 }, cubature::Config()) // integrate over x_1 and x_2
-                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                            // integrate over x_1
-                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                            // integrate over x_2
+                                - surfaces_3pt_A[1]
+                                - integrate<GSL::QAGS>(surface_3pt_B, 0.0, 1.0)                               // integrate over x_1
+                                - integrate<GSL::QAGS>(surface_3pt_C, 0.0, 1.0)                               // integrate over x_2
                                 - surface_fT_3pt_D(sigma_0, q2);
             }
+            const double numerator       = integral_2pt_m1 + surface_2pt_m1 + integral_3pt_m1 + surface_3pt_m1;
             const double denominator     = integral_2pt + surface_2pt + integral_3pt + surface_3pt;
 
             return numerator / denominator;
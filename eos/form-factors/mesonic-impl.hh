@@ -237,6 +237,31 @@ namespace eos
                 return ((mB2 - mV2) * (mB2 + 3.0 * mV2 - s) * this->t_2(s)
                         - lambda * this->t_3(s)) / (8.0 * mB * mV2 * (mB - mV));
             }
+
+            using FormFactors<PToV>::compute_all;
+
+            virtual Values compute_all(const double & s) const
+            {
+                const double mB = Process_::mB, mB2 = mB * mB;
+                const double mV = Process_::mV, mV2 = mV * mV;
+                const double lambda = eos::lambda(mB2, mV2, s);
+
+                Values result;
+                result.v    = _v_factor * _calc_eq59(s, _v_r1, _v_r2, _v_m2r, _v_m2fit);
+                result.a_0  = _a0_factor * _calc_eq59(s, _a0_r1, _a0_r2, _a0_m2r, _a0_m2fit);
+                result.a_1  = _a1_factor * _calc_eq61(s, _a1_r2, _a1_m2fit);
+                result.a_2  = _a2_factor * _calc_eq60(s, _a2_r1, _a2_r2, _a2_m2fit);
+                result.a_12 = ((mB + mV) * (mB + mV) * (mB2 - mV2 - s) * result.a_1
+                    - lambda * result.a_2) / (16.0 * mB * mV2 * (mB + mV));
+                result.t_1  = _t1_factor * _calc_eq59(s, _t1_r1, _t1_r2, _t1_m2r, _t1_m2fit);
+                result.t_2  = _t2_factor * _calc_eq61(s, _t2_r2, _t2_m2fit);
+                result.t_3  = (mB2 - mV2) / s
+                   * (_t3_factor * _calc_eq60(s, _t3t_r1, _t3t_r2, _t3t_m2fit) - result.t_2);
+                result.t_23 = ((mB2 - mV2) * (mB2 + 3.0 * mV2 - s) * result.t_2
+                        - lambda * result.t_3) / (8.0 * mB * mV2 * (mB - mV));
+
+                return result;
+            }
     };
 
     template <> class KMPW2010FormFactors<PToV> :
@@ -337,6 +362,37 @@ namespace eos
                 return ((mB2 - mV2) * (mB2 + 3.0 * mV2 - s) * this->t_2(s)
                         - lambda * this->t_3(s)) / (8.0 * mB * mV2 * (mB - mV));
             }
+
+            using FormFactors<PToV>::compute_all;
+
+            virtual Values compute_all(const double & s) const
+            {
+                const double mB = BToKstar::mB, mB2 = mB * mB;
+                const double mV = BToKstar::mV, mV2 = mV * mV;
+                const double lambda = eos::lambda(mB2, mV2, s);
+
+                // all form factors share the same dependence on z, cf. [KMPW2010], Eq. (8.8), p. 30
+                const double zs = _calc_z(s), z0 = _calc_z(0.0);
+                const double diff_z = zs - z0 + 0.5 * (zs * zs - z0 * z0);
+                const double pole_1m = 1.0 - s / _m_Bs2_1m;
+                const double pole_0m = 1.0 - s / _m_Bs2_0m;
+                const double pole_1p = 1.0 - s / _m_Bs2_1p;
+
+                Values result;
+                result.v    = _f0_V()  / pole_1m * (1.0 + _b1_V()  * diff_z);
+                result.a_0  = _f0_A0() / pole_0m * (1.0 + _b1_A0() * diff_z);
+                result.a_1  = _f0_A1() / pole_1p * (1.0 + _b1_A1() * diff_z);
+                result.a_2  = _f0_A2() / pole_1p * (1.0 + _b1_A2() * diff_z);
+                result.a_12 = ((mB + mV) * (mB + mV) * (mB2 - mV2 - s) * result.a_1
+                    - lambda * result.a_2) / (16.0 * mB * mV2 * (mB + mV));
+                result.t_1  = _f0_T1() / pole_1m * (1.0 + _b1_T1() * diff_z);
+                result.t_2  = _f0_T2() / pole_1p * (1.0 + _b1_T2() * diff_z);
+                result.t_3  = _f0_T3() / pole_1p * (1.0 + _b1_T3() * diff_z);
+                result.t_23 = ((mB2 - mV2) * (mB2 + 3.0 * mV2 - s) * result.t_2
+                        - lambda * result.t_3) / (8.0 * mB * mV2 * (mB - mV));
+
+                return result;
+            }
     };
 
     template <typename Tag_> class BFW2010FormFactors<Tag_, PToV> :
@@ -742,6 +798,81 @@ namespace eos
             {
                 return _calc_ff(s, Process_::mR2_1p, _a_T23);
             }
+
+            using FormFactors<PToV>::compute_all;
+
+            virtual Values compute_all(const double & s) const
+            {
+                Values result;
+                _fill(Coefficients(*this), s, _calc_z(s) - _z_0, result);
+
+                return result;
+            }
+
+            virtual void compute_all(const std::vector<double> & s, std::vector<Values> & values) const
+            {
+                const std::size_t size = s.size();
+                values.resize(size);
+
+                // compute z(s) - z(0) for all points first, without any dependency between iterations
+                std::vector<double> diff_z(size);
+                const double sqrt_tau_0 = std::sqrt(_tau_p - _tau_0);
+                for (std::size_t i = 0 ; i < size ; ++i)
+                {
+                    const double sqrt_tau_s = std::sqrt(_tau_p - s[i]);
+                    diff_z[i] = (sqrt_tau_s - sqrt_tau_0) / (sqrt_tau_s + sqrt_tau_0) - _z_0;
+                }
+
+                const Coefficients c(*this);
+                for (std::size_t i = 0 ; i < size ; ++i)
+                {
+                    _fill(c, s[i], diff_z[i], values[i]);
+                }
+            }
+
+        private:
+            // numerical values of the expansion coefficients, read once per call of compute_all
+            struct Coefficients
+            {
+                std::array<double, 3> v, a_0, a_1, a_12, t_1, t_2, t_23;
+
+                Coefficients(const BSZ2015FormFactors & ff) :
+                    v{{    ff._a_V[0],   ff._a_V[1],   ff._a_V[2]   }},
+                    a_0{{  ff._a_A0[0],  ff._a_A0[1],  ff._a_A0[2]  }},
+                    a_1{{  ff._a_A1[0],  ff._a_A1[1],  ff._a_A1[2]  }},
+                    a_12{{ ff._kin_factor * ff._a_A0[0], ff._a_A12[1 - 1], ff._a_A12[2 - 1] }},
+                    t_1{{  ff._a_T1[0],  ff._a_T1[1],  ff._a_T1[2]  }},
+                    t_2{{  ff._a_T1[0],  ff._a_T2[1 - 1],  ff._a_T2[2 - 1]  }},
+                    t_23{{ ff._a_T23[0], ff._a_T23[1], ff._a_T23[2] }}
+                {
+                }
+            };
+
+            static inline double _series(const std::array<double, 3> & a, const double & diff_z)
+            {
+                return a[0] + a[1] * diff_z + a[2] * power_of<2>(diff_z);
+            }
+
+            // shares z(s) and the pole factors among all form factors
+            inline void _fill(const Coefficients & c, const double & s, const double & diff_z, Values & result) const
+            {
+                const double pole_1m = 1.0 / (1.0 - s / Process_::mR2_1m);
+                const double pole_0m = 1.0 / (1.0 - s / Process_::mR2_0m);
+                const double pole_1p = 1.0 / (1.0 - s / Process_::mR2_1p);
+                const double lambda = eos::lambda(_mB2, _mV2, s);
+
+                result.v    = pole_1m * _series(c.v,    diff_z);
+                result.a_0  = pole_0m * _series(c.a_0,  diff_z);
+                result.a_1  = pole_1p * _series(c.a_1,  diff_z);
+                result.a_12 = pole_1p * _series(c.a_12, diff_z);
+                result.a_2  = (power_of<2>(_mB + _mV) * (_mB2 - _mV2 - s) * result.a_1
+                              - 16.0 * _mB * _mV2 * (_mB + _mV) * result.a_12) / lambda;
+                result.t_1  = pole_1m * _series(c.t_1,  diff_z);
+                result.t_2  = pole_1p * _series(c.t_2,  diff_z);
+                result.t_23 = pole_1p * _series(c.t_23, diff_z);
+                result.t_3  = ((_mB2 - _mV2) * (_mB2 + 3.0 * _mV2 - s) * result.t_2
+                              - 8.0 * _mB * _mV2 * (_mB - _mV) * result.t_23) / lambda;
+            }
     };
 
     /* P -> P Processes */
@@ -142,6 +142,33 @@ namespace eos
     {
     }
 
+    FormFactors<PToV>::Values
+    FormFactors<PToV>::compute_all(const double & s) const
+    {
+        Values result;
+        result.v    = this->v(s);
+        result.a_0  = this->a_0(s);
+        result.a_1  = this->a_1(s);
+        result.a_2  = this->a_2(s);
+        result.a_12 = this->a_12(s);
+        result.t_1  = this->t_1(s);
+        result.t_2  = this->t_2(s);
+        result.t_3  = this->t_3(s);
+        result.t_23 = this->t_23(s);
+
+        return result;
+    }
+
+    void
+    FormFactors<PToV>::compute_all(const std::vector<double> & s, std::vector<Values> & values) const
+    {
+        values.resize(s.size());
+        for (std::size_t i = 0 ; i < s.size() ; ++i)
+        {
+            values[i] = this->compute_all(s[i]);
+        }
+    }
+
     std::shared_ptr<FormFactors<PToV>>
     FormFactorFactory<PToV>::create(const QualifiedName & name, const Parameters & parameters, const Options & options)
     {
@@ -30,6 +30,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace eos
 {
@@ -69,6 +70,30 @@ namespace eos
             virtual double t_2(const double & s) const = 0;
             virtual double t_3(const double & s) const = 0;
             virtual double t_23(const double & s) const = 0;
+
+            /// The values of all form factors at one point s.
+            struct Values
+            {
+                double v;
+                double a_0, a_1, a_2, a_12;
+                double t_1, t_2, t_3, t_23;
+            };
+
+            /*!
+             * Compute all form factors at one point s.
+             *
+             * The default implementation calls the individual form factors. Parametrisations
+             * override it to share intermediate results, e.g. the conformal variable z(s).
+             */
+            virtual Values compute_all(const double & s) const;
+
+            /*!
+             * Compute all form factors for a batch of points.
+             *
+             * @param s      The points at which to compute the form factors.
+             * @param values Returns one set of values per point.
+             */
+            virtual void compute_all(const std::vector<double> & s, std::vector<Values> & values) const;
     };
 
     template <>
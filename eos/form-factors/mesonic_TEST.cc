@@ -1108,3 +1108,49 @@ class BToPiPiFvDV2018FormFactorsTest :
             TEST_CHECK_NEARLY_EQUAL( 0.001215, imag(ff->f_perp(0.05, 16.0, -0.5)), eps);
         }
 } b_to_pi_pi_fvdv2018_form_factors_test;
+
+class PToVComputeAllTest :
+    public TestCase
+{
+    public:
+        PToVComputeAllTest() :
+            TestCase("p_to_v_compute_all_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1.0e-12;
+
+            Parameters p = Parameters::Defaults();
+            const std::vector<double> s{ 0.1, 2.1, 4.1, 6.1, 8.1, 10.1 };
+
+            for (const auto & name : { "B->K^*::BSZ2015", "B->D^*::BSZ2015", "B->K^*::BZ2004", "B->K^*::KMPW2010" })
+            {
+                std::shared_ptr<FormFactors<PToV>> ff = FormFactorFactory<PToV>::create(name, p, Options{ });
+                TEST_CHECK(ff.get() != nullptr);
+
+                std::vector<FormFactors<PToV>::Values> values;
+                ff->compute_all(s, values);
+                TEST_CHECK_EQUAL(s.size(), values.size());
+
+                for (std::size_t i = 0 ; i < s.size() ; ++i)
+                {
+                    const FormFactors<PToV>::Values single = ff->compute_all(s[i]);
+
+                    for (const auto & v : { single, values[i] })
+                    {
+                        TEST_CHECK_RELATIVE_ERROR(ff->v(s[i]),    v.v,    eps);
+                        TEST_CHECK_RELATIVE_ERROR(ff->a_0(s[i]),  v.a_0,  eps);
+                        TEST_CHECK_RELATIVE_ERROR(ff->a_1(s[i]),  v.a_1,  eps);
+                        TEST_CHECK_RELATIVE_ERROR(ff->a_2(s[i]),  v.a_2,  eps);
+                        TEST_CHECK_RELATIVE_ERROR(ff->a_12(s[i]), v.a_12, eps);
+                        TEST_CHECK_RELATIVE_ERROR(ff->t_1(s[i]),  v.t_1,  eps);
+                        TEST_CHECK_RELATIVE_ERROR(ff->t_2(s[i]),  v.t_2,  eps);
+                        TEST_CHECK_RELATIVE_ERROR(ff->t_3(s[i]),  v.t_3,  eps);
+                        TEST_CHECK_RELATIVE_ERROR(ff->t_23(s[i]), v.t_23, eps);
+                    }
+                }
+            }
+        }
+} p_to_v_compute_all_test;
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2020 Danny van Dyk
  * Copyright (c) 2011 Christian Wacker
  * Copyright (c) 2018, 2019 Ahmet Kokulu
  * Copyright (c) 2018, 2019 Nico Gubernari
@@ -27,6 +27,7 @@
 //#include <eos/utils/concrete_observable.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/observable_stub.hh>
+#include <eos/utils/thread_pool.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 #include <eos/observable-impl.hh>
 
@@ -85,6 +86,60 @@ namespace eos
         return ObservablePtr();
     }
 
+    std::vector<const void *>
+    Observable::shared_objects() const
+    {
+        return std::vector<const void *>();
+    }
+
+    void
+    Observable::evaluate_grid(const std::vector<std::string> & variables, const double * values, const std::size_t & n, double * out) const
+    {
+        if (0 == n)
+            return;
+
+        struct Clone
+        {
+            ObservablePtr observable;
+
+            std::vector<KinematicVariable> variables;
+        };
+
+        const std::size_t dim = variables.size();
+        const std::size_t number_of_clones = std::min<std::size_t>(n, ThreadPool::instance()->number_of_threads());
+
+        std::vector<Clone> clones;
+        clones.reserve(number_of_clones);
+        for (std::size_t c = 0 ; c < number_of_clones ; ++c)
+        {
+            Clone clone{ this->clone(), {} };
+
+            Kinematics k = clone.observable->kinematics();
+            for (const auto & v : variables)
+            {
+                clone.variables.push_back(k[v]);
+            }
+
+            clones.push_back(std::move(clone));
+        }
+
+        // contiguous ranges of points, one per clone
+        ThreadPool::instance()->parallel_for_parts(n, number_of_clones, [&] (const unsigned long & c, const unsigned long & i_begin, const unsigned long & i_end)
+        {
+            Clone & clone = clones[c];
+
+            for (auto i = i_begin ; i != i_end ; ++i)
+            {
+                for (std::size_t j = 0 ; j != dim ; ++j)
+                {
+                    clone.variables[j] = values[i * dim + j];
+                }
+
+                out[i] = clone.observable->evaluate();
+            }
+        });
+    }
+
     /* ObservableEntry */
 
     ObservableEntry::ObservableEntry()
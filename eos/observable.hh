@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et tw=150 foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2016-2019 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2016-2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -28,6 +28,7 @@
 #include <eos/utils/qualified-name.hh>
 
 #include <string>
+#include <vector>
 
 namespace eos
 {
@@ -54,6 +55,29 @@ namespace eos
             virtual ObservablePtr clone(const Parameters & parameters) const = 0;
 
             static ObservablePtr make(const QualifiedName & name, const Parameters & parameters, const Kinematics & kinematics, const Options & options);
+
+            /*!
+             * Retrieve the identities of the objects with mutable state that this observable
+             * shares with other observables, e.g. a shared decay object.
+             *
+             * Observables that share any such object must not be evaluated concurrently.
+             * By default, no objects are shared.
+             */
+            virtual std::vector<const void *> shared_objects() const;
+
+            /*!
+             * Evaluate the observable on a grid of kinematic points.
+             *
+             * The points are distributed over clones of this observable, which are evaluated
+             * concurrently by the ThreadPool. The clones use the current parameter values.
+             * The kinematics of this observable are left unchanged.
+             *
+             * @param variables The names of the kinematic variables that are varied.
+             * @param values    The points, as n consecutive rows of one value per variable.
+             * @param n         The number of points.
+             * @param out       The n values of the observable.
+             */
+            void evaluate_grid(const std::vector<std::string> & variables, const double * values, const std::size_t & n, double * out) const;
     };
 
     /**
@@ -0,0 +1,102 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/observable.hh>
+
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class ObservableEvaluateGridTest :
+    public TestCase
+{
+    public:
+        ObservableEvaluateGridTest() :
+            TestCase("observable_evaluate_grid_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // evaluation on a grid of kinematic points
+            {
+                Parameters p = Parameters::Defaults();
+                Kinematics k{ { "q2", 1.0 } };
+                Options o{ { "form-factors", "BCL2008" } };
+
+                ObservablePtr observable = Observable::make("B->Dlnu::dBR/dq2", p, k, o);
+
+                std::vector<double> q2_values;
+                for (double q2 = 0.5 ; q2 < 11.5 ; q2 += 0.25)
+                {
+                    q2_values.push_back(q2);
+                }
+
+                std::vector<double> values(q2_values.size());
+                observable->evaluate_grid({ "q2" }, q2_values.data(), q2_values.size(), values.data());
+                TEST_CHECK_EQUAL(k["q2"](), 1.0);
+
+                for (unsigned i = 0 ; i < q2_values.size() ; ++i)
+                {
+                    k["q2"] = q2_values[i];
+                    TEST_CHECK_RELATIVE_ERROR(values[i], observable->evaluate(), 1e-14);
+                }
+
+                TEST_CHECK_THROWS(UnknownKinematicVariableError, observable->evaluate_grid({ "w" }, q2_values.data(), q2_values.size(), values.data()));
+            }
+        }
+} observable_evaluate_grid_test;
+
+class ObservableSharedDecayTest :
+    public TestCase
+{
+    public:
+        ObservableSharedDecayTest() :
+            TestCase("observable_shared_decay_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // observables of the same process share their decay object for identical parameters and options
+            {
+                Parameters p1 = Parameters::Defaults();
+                Parameters p2 = Parameters::Defaults();
+                Options o{ { "form-factors", "BCL2008" } };
+
+                ObservablePtr a = Observable::make("B->Dlnu::dBR/dq2", p1, Kinematics{ { "q2", 1.0 } }, o);
+                ObservablePtr b = Observable::make("B->Dlnu::BR",      p1, Kinematics{ { "q2_min", 1.0 }, { "q2_max", 2.0 } }, o);
+                ObservablePtr c = Observable::make("B->Dlnu::dBR/dq2", p2, Kinematics{ { "q2", 1.0 } }, o);
+                ObservablePtr d = Observable::make("B->Dlnu::dBR/dq2", p1, Kinematics{ { "q2", 1.0 } }, o + Options{ { "l", "tau" } });
+
+                TEST_CHECK_EQUAL(1u, a->shared_objects().size());
+                TEST_CHECK(a->shared_objects() == b->shared_objects());
+                TEST_CHECK(a->shared_objects() != c->shared_objects());
+                TEST_CHECK(a->shared_objects() != d->shared_objects());
+
+                // a new observable shares the decay object as long as any of its users is alive
+                const std::vector<const void *> shared = a->shared_objects();
+                a.reset();
+                ObservablePtr e = Observable::make("B->Dlnu::dBR/dq2", p1, Kinematics{ { "q2", 3.0 } }, o);
+                TEST_CHECK(shared == e->shared_objects());
+            }
+        }
+} observable_shared_decay_test;
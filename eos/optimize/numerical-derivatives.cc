@@ -0,0 +1,240 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/optimize/numerical-derivatives.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+
+namespace eos
+{
+    template <>
+    struct Implementation<NumericalDerivatives>
+    {
+        // one independent copy of the density per concurrent evaluation
+        std::vector<DensityPtr> densities;
+
+        std::vector<double> min, max, step;
+
+        unsigned dimension;
+
+        // the copies of the density must not be used by two sweeps at once
+        Mutex mutex;
+
+        Implementation(const DensityPtr & density, const double & relative_step) :
+            dimension(0)
+        {
+            for (auto d = density->begin(), d_end = density->end() ; d != d_end ; ++d, ++dimension)
+            {
+                min.push_back(d->min);
+                max.push_back(d->max);
+                step.push_back(relative_step * (d->max - d->min));
+            }
+
+            if (0 == dimension)
+                throw InternalError("NumericalDerivatives: density has no parameters");
+
+            const unsigned number_of_copies = std::max(1u, ThreadPool::instance()->number_of_threads());
+            for (unsigned i = 0 ; i < number_of_copies ; ++i)
+            {
+                densities.push_back(density->clone());
+            }
+        }
+
+        void check(const std::vector<double> & point) const
+        {
+            if (point.size() != dimension)
+                throw InternalError("NumericalDerivatives: point has dimension " + stringify(point.size())
+                        + ", but the density has dimension " + stringify(dimension));
+        }
+
+        // evaluate the density at all points, which are stored row by row
+        std::vector<double> evaluate(const std::vector<double> & points) const
+        {
+            const unsigned long number_of_points = points.size() / dimension;
+            const unsigned long grain = (number_of_points + densities.size() - 1) / densities.size();
+
+            std::vector<double> result(number_of_points);
+            ThreadPool::instance()->parallel_for(0, number_of_points, grain,
+                    [&] (const unsigned long & begin, const unsigned long & end)
+            {
+                // chunks do not overlap, and each chunk uses its own copy of the density
+                const DensityPtr & density = densities[begin / grain];
+
+                for (unsigned long k = begin ; k < end ; ++k)
+                {
+                    auto x = points.cbegin() + k * dimension;
+                    for (auto d = density->begin(), d_end = density->end() ; d != d_end ; ++d, ++x)
+                    {
+                        d->parameter->set(*x);
+                    }
+
+                    result[k] = density->evaluate();
+                }
+            });
+
+            return result;
+        }
+
+        // append the stencil of the central differences in all directions
+        void gradient_points(const std::vector<double> & point, std::vector<double> & points, std::vector<double> & distances) const
+        {
+            distances.resize(dimension);
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                const double upper = std::min(point[i] + step[i], max[i]);
+                const double lower = std::max(point[i] - step[i], min[i]);
+                distances[i] = upper - lower;
+
+                points.insert(points.end(), point.cbegin(), point.cend());
+                points[points.size() - dimension + i] = upper;
+
+                points.insert(points.end(), point.cbegin(), point.cend());
+                points[points.size() - dimension + i] = lower;
+            }
+        }
+
+        std::vector<double> gradient(const std::vector<double> & values, const std::vector<double> & distances) const
+        {
+            std::vector<double> result(dimension);
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                result[i] = (values[2 * i] - values[2 * i + 1]) / distances[i];
+            }
+
+            return result;
+        }
+    };
+
+    NumericalDerivatives::NumericalDerivatives(const DensityPtr & density, const double & relative_step) :
+        PrivateImplementationPattern<NumericalDerivatives>(new Implementation<NumericalDerivatives>(density, relative_step))
+    {
+    }
+
+    NumericalDerivatives::~NumericalDerivatives()
+    {
+    }
+
+    unsigned
+    NumericalDerivatives::dimension() const
+    {
+        return _imp->dimension;
+    }
+
+    std::vector<double>
+    NumericalDerivatives::gradient(const std::vector<double> & point) const
+    {
+        _imp->check(point);
+
+        Lock l(_imp->mutex);
+
+        std::vector<double> points, distances;
+        points.reserve(2 * _imp->dimension * _imp->dimension);
+        _imp->gradient_points(point, points, distances);
+
+        return _imp->gradient(_imp->evaluate(points), distances);
+    }
+
+    double
+    NumericalDerivatives::value_and_gradient(const std::vector<double> & point, std::vector<double> & gradient) const
+    {
+        _imp->check(point);
+
+        Lock l(_imp->mutex);
+
+        std::vector<double> points, distances;
+        points.reserve((2 * _imp->dimension + 1) * _imp->dimension);
+        _imp->gradient_points(point, points, distances);
+        points.insert(points.end(), point.cbegin(), point.cend());
+
+        std::vector<double> values = _imp->evaluate(points);
+        gradient = _imp->gradient(values, distances);
+
+        return values.back();
+    }
+
+    std::vector<double>
+    NumericalDerivatives::hessian(const std::vector<double> & point) const
+    {
+        _imp->check(point);
+
+        Lock l(_imp->mutex);
+
+        const unsigned & dim = _imp->dimension;
+        const std::vector<double> & h = _imp->step;
+
+        // stencil: the point, x +/- h_i e_i, and x +/- (h_i e_i + h_j e_j) for i < j
+        std::vector<double> points;
+        points.reserve((dim * (dim + 1) + 1) * dim);
+        points.insert(points.end(), point.cbegin(), point.cend());
+        for (unsigned i = 0 ; i < dim ; ++i)
+        {
+            for (double sign : { +1.0, -1.0 })
+            {
+                points.insert(points.end(), point.cbegin(), point.cend());
+                points[points.size() - dim + i] += sign * h[i];
+            }
+        }
+        for (unsigned i = 0 ; i < dim ; ++i)
+        {
+            for (unsigned j = i + 1 ; j < dim ; ++j)
+            {
+                for (double sign : { +1.0, -1.0 })
+                {
+                    points.insert(points.end(), point.cbegin(), point.cend());
+                    points[points.size() - dim + i] += sign * h[i];
+                    points[points.size() - dim + j] += sign * h[j];
+                }
+            }
+        }
+
+        const std::vector<double> values = _imp->evaluate(points);
+        const double f0 = values[0];
+        auto f_plus  = [&] (const unsigned & i) { return values[1 + 2 * i]; };
+        auto f_minus = [&] (const unsigned & i) { return values[2 + 2 * i]; };
+
+        std::vector<double> result(dim * dim);
+        for (unsigned i = 0 ; i < dim ; ++i)
+        {
+            result[i * dim + i] = (f_plus(i) - 2.0 * f0 + f_minus(i)) / (h[i] * h[i]);
+        }
+
+        auto f = values.cbegin() + 1 + 2 * dim;
+        for (unsigned i = 0 ; i < dim ; ++i)
+        {
+            for (unsigned j = i + 1 ; j < dim ; ++j, f += 2)
+            {
+                const double f_plus_plus = *f, f_minus_minus = *(f + 1);
+
+                const double value = (f_plus_plus - f_plus(i) - f_plus(j) + 2.0 * f0 - f_minus(i) - f_minus(j) + f_minus_minus)
+                    / (2.0 * h[i] * h[j]);
+
+                result[i * dim + j] = value;
+                result[j * dim + i] = value;
+            }
+        }
+
+        return result;
+    }
+}
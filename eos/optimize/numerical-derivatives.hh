@@ -0,0 +1,99 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_OPTIMIZE_NUMERICAL_DERIVATIVES_HH
+#define EOS_GUARD_EOS_OPTIMIZE_NUMERICAL_DERIVATIVES_HH 1
+
+#include <eos/utils/density.hh>
+#include <eos/utils/instantiation_policy.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * NumericalDerivatives computes the gradient and the Hessian of a Density
+     * with respect to its parameters by finite differences.
+     *
+     * All displaced points of a finite-difference stencil are evaluated concurrently
+     * on the ThreadPool. Each concurrent evaluation uses its own clone of the density,
+     * which is created once at construction. The step size for each parameter is a
+     * fixed fraction of the parameter's range.
+     *
+     * @note The clones do not follow later changes of parameters that are not
+     * explored by the density.
+     */
+    class NumericalDerivatives :
+        public InstantiationPolicy<NumericalDerivatives, NonCopyable>,
+        public PrivateImplementationPattern<NumericalDerivatives>
+    {
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param density       The density to be differentiated. It is not modified.
+             * @param relative_step The step size as a fraction of each parameter's range.
+             */
+            NumericalDerivatives(const DensityPtr & density, const double & relative_step = 1e-4);
+
+            /// Destructor.
+            ~NumericalDerivatives();
+            ///@}
+
+            /// The number of parameters of the density.
+            unsigned dimension() const;
+
+            /*!
+             * Compute the gradient of the density at a given point.
+             *
+             * Central differences are used, which require 2N evaluations of the density.
+             * Steps that would leave a parameter's range are truncated at its boundary.
+             *
+             * @param point The values of the density's parameters.
+             */
+            std::vector<double> gradient(const std::vector<double> & point) const;
+
+            /*!
+             * Compute the value and the gradient of the density at a given point
+             * with 2N + 1 concurrent evaluations.
+             *
+             * @param point    The values of the density's parameters.
+             * @param gradient Returns the gradient.
+             * @return The value of the density at point.
+             */
+            double value_and_gradient(const std::vector<double> & point, std::vector<double> & gradient) const;
+
+            /*!
+             * Compute the Hessian of the density at a given point.
+             *
+             * Symmetric differences are used, which require N (N + 1) + 1 evaluations
+             * of the density. The point should lie at least one step away from the
+             * boundaries of the parameters' ranges.
+             *
+             * @param point The values of the density's parameters.
+             * @return The Hessian in row-major format.
+             */
+            std::vector<double> hessian(const std::vector<double> & point) const;
+    };
+}
+
+#endif
@@ -0,0 +1,150 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/optimize/numerical-derivatives.hh>
+#include <eos/statistics/density-wrapper.hh>
+#include <eos/utils/power_of.hh>
+#include <test/test.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+namespace
+{
+    /*!
+     * f(x) = -1/2 sum_i (i + 1) x_i^2 - 1/4 sum_i x_i x_{i+1} + sin(x_0)
+     */
+    double test_function(const std::vector<double> & x)
+    {
+        double result = std::sin(x[0]);
+
+        for (unsigned i = 0 ; i < x.size() ; ++i)
+        {
+            result -= 0.5 * (i + 1) * power_of<2>(x[i]);
+
+            if (i + 1 < x.size())
+                result -= 0.25 * x[i] * x[i + 1];
+        }
+
+        return result;
+    }
+
+    DensityPtr make_test_density(const unsigned & dim)
+    {
+        DensityWrapper * density = new DensityWrapper(&test_function);
+        for (unsigned i = 0 ; i < dim ; ++i)
+        {
+            density->add_parameter("x" + stringify(i), -5.0, +5.0);
+        }
+
+        return DensityPtr(density);
+    }
+}
+
+class NumericalDerivativesTest :
+    public TestCase
+{
+    public:
+        NumericalDerivativesTest() :
+            TestCase("numerical_derivatives_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const unsigned dim = 6;
+
+            DensityPtr density = make_test_density(dim);
+            NumericalDerivatives derivatives(density);
+            TEST_CHECK_EQUAL(dim, derivatives.dimension());
+
+            const std::vector<double> point{ 0.3, -1.2, 0.7, 2.0, -0.4, 1.1 };
+
+            // gradient
+            {
+                static const double eps = 1e-6;
+
+                std::vector<double> gradient = derivatives.gradient(point);
+                TEST_CHECK_EQUAL(dim, gradient.size());
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    double reference = -1.0 * (i + 1) * point[i];
+                    if (i > 0)       reference -= 0.25 * point[i - 1];
+                    if (i + 1 < dim) reference -= 0.25 * point[i + 1];
+                    if (0 == i)      reference += std::cos(point[0]);
+
+                    TEST_CHECK_NEARLY_EQUAL(reference, gradient[i], eps);
+                }
+
+                std::vector<double> gradient2;
+                double value = derivatives.value_and_gradient(point, gradient2);
+                TEST_CHECK_NEARLY_EQUAL(test_function(point), value, 1e-14);
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    TEST_CHECK_EQUAL(gradient[i], gradient2[i]);
+                }
+            }
+
+            // gradient at the boundary of the range uses one-sided differences
+            {
+                std::vector<double> boundary(point);
+                boundary[1] = -5.0;
+
+                std::vector<double> gradient = derivatives.gradient(boundary);
+                TEST_CHECK_NEARLY_EQUAL(2.0 * 5.0 - 0.25 * (boundary[0] + boundary[2]), gradient[1], 1e-2);
+            }
+
+            // hessian
+            {
+                static const double eps = 1e-5;
+
+                std::vector<double> hessian = derivatives.hessian(point);
+                TEST_CHECK_EQUAL(dim * dim, hessian.size());
+
+                for (unsigned i = 0 ; i < dim ; ++i)
+                {
+                    for (unsigned j = 0 ; j < dim ; ++j)
+                    {
+                        double reference = 0.0;
+                        if (i == j)                         reference = -1.0 * (i + 1);
+                        if ((i + 1 == j) || (j + 1 == i))   reference = -0.25;
+                        if ((0 == i) && (0 == j))           reference -= std::sin(point[0]);
+
+                        TEST_CHECK_NEARLY_EQUAL(reference, hessian[i * dim + j], eps);
+                    }
+                }
+            }
+
+            // the density itself is left unchanged
+            {
+                for (auto d = density->begin(), d_end = density->end() ; d != d_end ; ++d)
+                {
+                    TEST_CHECK_EQUAL(0.0, d->parameter->evaluate());
+                }
+            }
+
+            // wrong dimension
+            {
+                TEST_CHECK_THROWS(InternalError, derivatives.gradient(std::vector<double>{ 0.1, 0.2 }));
+            }
+        }
+} numerical_derivatives_test;
@@ -20,9 +20,36 @@
 #include <eos/optimize/optimizer-gsl.hh>
 #include <eos/utils/stringify.hh>
 
+#include <cmath>
+#include <map>
+
 namespace eos
 {
-    OptimizerGSL::OptimizerGSL(const DensityPtr & density, const unsigned & max_iterations, const double & target_size) :
+    namespace
+    {
+        const gsl_multimin_fdfminimizer_type * fdf_type(const std::string & algorithm)
+        {
+            static const std::map<std::string, const gsl_multimin_fdfminimizer_type *> types
+            {
+                { "bfgs2",            gsl_multimin_fdfminimizer_vector_bfgs2    },
+                { "conjugate-fr",     gsl_multimin_fdfminimizer_conjugate_fr    },
+                { "conjugate-pr",     gsl_multimin_fdfminimizer_conjugate_pr    },
+                { "steepest-descent", gsl_multimin_fdfminimizer_steepest_descent },
+            };
+
+            if ("simplex" == algorithm)
+                return nullptr;
+
+            auto t = types.find(algorithm);
+            if (types.end() == t)
+                throw OptimizerError("Unknown GSL minimization algorithm: '" + algorithm + "'");
+
+            return t->second;
+        }
+    }
+
+    OptimizerGSL::OptimizerGSL(const DensityPtr & density, const unsigned & max_iterations, const double & target_size,
+            const std::string & algorithm) :
         _density(density),
         _max_iterations(max_iterations),
         _target_size(target_size),
@@ -30,7 +57,9 @@ namespace eos
         _gsl_parameters(gsl_vector_alloc(_number_of_parameters)),
         _gsl_step_size(gsl_vector_alloc(_number_of_parameters)),
         _gsl_type(gsl_multimin_fminimizer_nmsimplex2),
-        _gsl_state(gsl_multimin_fminimizer_alloc(_gsl_type, _number_of_parameters))
+        _gsl_state(nullptr),
+        _gsl_fdf_type(fdf_type(algorithm)),
+        _gsl_fdf_state(nullptr)
     {
         _update_gsl_parameters(_gsl_parameters);
 
@@ -39,13 +68,28 @@ namespace eos
         {
             gsl_vector_set(_gsl_step_size, i, (p->max - p->min) / 100);
         }
+
+        if (_gsl_fdf_type)
+        {
+            _gsl_fdf_state = gsl_multimin_fdfminimizer_alloc(_gsl_fdf_type, _number_of_parameters);
+            _derivatives = std::make_shared<NumericalDerivatives>(density);
+        }
+        else
+        {
+            _gsl_state = gsl_multimin_fminimizer_alloc(_gsl_type, _number_of_parameters);
+        }
     }
 
     OptimizerGSL::~OptimizerGSL()
     {
         gsl_vector_free(_gsl_step_size);
         gsl_vector_free(_gsl_parameters);
-        gsl_multimin_fminimizer_free(_gsl_state);
+
+        if (_gsl_state)
+            gsl_multimin_fminimizer_free(_gsl_state);
+
+        if (_gsl_fdf_state)
+            gsl_multimin_fdfminimizer_free(_gsl_fdf_state);
     }
 
     void
@@ -78,6 +122,43 @@ namespace eos
         return _density->evaluate();
     }
 
+    void
+    OptimizerGSL::_gradient(const gsl_vector * gsl_parameters, gsl_vector * gsl_gradient, const double & sign)
+    {
+        std::vector<double> point(_number_of_parameters);
+        for (unsigned i = 0 ; i < _number_of_parameters ; ++i)
+        {
+            point[i] = gsl_vector_get(gsl_parameters, i);
+        }
+
+        std::vector<double> gradient = _derivatives->gradient(point);
+
+        for (unsigned i = 0 ; i < _number_of_parameters ; ++i)
+        {
+            gsl_vector_set(gsl_gradient, i, sign * gradient[i]);
+        }
+    }
+
+    double
+    OptimizerGSL::_evaluate_with_gradient(const gsl_vector * gsl_parameters, gsl_vector * gsl_gradient, const double & sign)
+    {
+        std::vector<double> point(_number_of_parameters), gradient;
+        for (unsigned i = 0 ; i < _number_of_parameters ; ++i)
+        {
+            point[i] = gsl_vector_get(gsl_parameters, i);
+        }
+
+        // the value is evaluated alongside the displaced points
+        const double result = _derivatives->value_and_gradient(point, gradient);
+
+        for (unsigned i = 0 ; i < _number_of_parameters ; ++i)
+        {
+            gsl_vector_set(gsl_gradient, i, sign * gradient[i]);
+        }
+
+        return sign * result;
+    }
+
     double
     OptimizerGSL::_evaluate_original_adapter(const gsl_vector * gsl_parameters, void * _this)
     {
@@ -90,6 +171,30 @@ namespace eos
         return -static_cast<OptimizerGSL *>(_this)->_evaluate(gsl_parameters);
     }
 
+    void
+    OptimizerGSL::_gradient_original_adapter(const gsl_vector * gsl_parameters, void * _this, gsl_vector * gsl_gradient)
+    {
+        static_cast<OptimizerGSL *>(_this)->_gradient(gsl_parameters, gsl_gradient, +1.0);
+    }
+
+    void
+    OptimizerGSL::_gradient_negative_adapter(const gsl_vector * gsl_parameters, void * _this, gsl_vector * gsl_gradient)
+    {
+        static_cast<OptimizerGSL *>(_this)->_gradient(gsl_parameters, gsl_gradient, -1.0);
+    }
+
+    void
+    OptimizerGSL::_evaluate_with_gradient_original_adapter(const gsl_vector * gsl_parameters, void * _this, double * f, gsl_vector * gsl_gradient)
+    {
+        *f = static_cast<OptimizerGSL *>(_this)->_evaluate_with_gradient(gsl_parameters, gsl_gradient, +1.0);
+    }
+
+    void
+    OptimizerGSL::_evaluate_with_gradient_negative_adapter(const gsl_vector * gsl_parameters, void * _this, double * f, gsl_vector * gsl_gradient)
+    {
+        *f = static_cast<OptimizerGSL *>(_this)->_evaluate_with_gradient(gsl_parameters, gsl_gradient, -1.0);
+    }
+
     double
     OptimizerGSL::_optimize()
     {
@@ -123,9 +228,62 @@ namespace eos
         throw OptimizerError("GSL multimin did not converge after " + stringify(_max_iterations) + " iterations!");
     }
 
+    double
+    OptimizerGSL::_optimize_with_gradient()
+    {
+        // the length of the first trial step is based on the parameter ranges
+        double step_size = 0.0;
+        for (unsigned i = 0 ; i < _number_of_parameters ; ++i)
+        {
+            step_size += gsl_vector_get(_gsl_step_size, i) * gsl_vector_get(_gsl_step_size, i);
+        }
+        step_size = std::sqrt(step_size);
+
+        // tolerance of the line minimization, as recommended by the GSL manual
+        static const double line_tolerance = 0.1;
+
+        gsl_multimin_fdfminimizer_set(_gsl_fdf_state, &_gsl_fdf_func, _gsl_parameters, step_size, line_tolerance);
+
+        unsigned iterations = 0;
+        int status;
+
+        do
+        {
+            iterations++;
+            status = gsl_multimin_fdfminimizer_iterate(_gsl_fdf_state);
+
+            if (status)
+                break;
+
+            status = gsl_multimin_test_gradient(gsl_multimin_fdfminimizer_gradient(_gsl_fdf_state), _target_size);
+        }
+        while ((GSL_CONTINUE == status) && (iterations < _max_iterations));
+
+        // leave the density at the best point found
+        _update_density(gsl_multimin_fdfminimizer_x(_gsl_fdf_state));
+
+        if (GSL_SUCCESS == status)
+        {
+            return gsl_multimin_fdfminimizer_minimum(_gsl_fdf_state);
+        }
+
+        throw OptimizerError("GSL multimin did not converge after " + stringify(iterations) + " iterations!");
+    }
+
     double
     OptimizerGSL::maximize()
     {
+        if (_gsl_fdf_type)
+        {
+            _gsl_fdf_func.n = _number_of_parameters;
+            _gsl_fdf_func.f = &OptimizerGSL::_evaluate_negative_adapter;
+            _gsl_fdf_func.df = &OptimizerGSL::_gradient_negative_adapter;
+            _gsl_fdf_func.fdf = &OptimizerGSL::_evaluate_with_gradient_negative_adapter;
+            _gsl_fdf_func.params = static_cast<void *>(this);
+
+            return _optimize_with_gradient();
+        }
+
         _gsl_func.n = _number_of_parameters;
         _gsl_func.f = &OptimizerGSL::_evaluate_negative_adapter;
         _gsl_func.params = static_cast<void *>(this);
@@ -138,6 +296,17 @@ namespace eos
     double
     OptimizerGSL::minimize()
     {
+        if (_gsl_fdf_type)
+        {
+            _gsl_fdf_func.n = _number_of_parameters;
+            _gsl_fdf_func.f = &OptimizerGSL::_evaluate_original_adapter;
+            _gsl_fdf_func.df = &OptimizerGSL::_gradient_original_adapter;
+            _gsl_fdf_func.fdf = &OptimizerGSL::_evaluate_with_gradient_original_adapter;
+            _gsl_fdf_func.params = static_cast<void *>(this);
+
+            return _optimize_with_gradient();
+        }
+
         _gsl_func.n = _number_of_parameters;
         _gsl_func.f = &OptimizerGSL::_evaluate_original_adapter;
         _gsl_func.params = static_cast<void *>(this);
@@ -20,8 +20,12 @@
 #ifndef EOS_GUARD_EOS_OPTIMIZE_OPTIMIZER_MINUIT2_HH
 #define EOS_GUARD_EOS_OPTIMIZE_OPTIMIZER_MINUIT2_HH 1
 
+#include <eos/optimize/numerical-derivatives.hh>
 #include <eos/optimize/optimizer.hh>
 
+#include <memory>
+#include <string>
+
 #include <gsl/gsl_multimin.h>
 
 namespace eos
@@ -57,6 +61,18 @@ namespace eos
             // GSL function.
             gsl_multimin_function _gsl_func;
 
+            // GSL gradient-based minimization algorithm; nullptr if the simplex is used.
+            const gsl_multimin_fdfminimizer_type * _gsl_fdf_type;
+
+            // GSL gradient-based minimization state.
+            gsl_multimin_fdfminimizer * _gsl_fdf_state;
+
+            // GSL function with gradient.
+            gsl_multimin_function_fdf _gsl_fdf_func;
+
+            // numerical gradient of the target function
+            std::shared_ptr<NumericalDerivatives> _derivatives;
+
             // copy parameter values from the density to the GSL vector
             void _update_gsl_parameters(gsl_vector * gsl_parameters);
 
@@ -66,15 +82,43 @@ namespace eos
             // evaluate the target function for a given GSL vector of parameters
             double _evaluate(const gsl_vector * gsl_parameters);
 
+            // evaluate the gradient of the target function for a given GSL vector of parameters
+            void _gradient(const gsl_vector * gsl_parameters, gsl_vector * gsl_gradient, const double & sign);
+
+            // evaluate the target function and its gradient for a given GSL vector of parameters
+            double _evaluate_with_gradient(const gsl_vector * gsl_parameters, gsl_vector * gsl_gradient, const double & sign);
+
             // optimize until either limit of iterations has been reached, or
             // target size of the simplex has been achieved
             double _optimize();
 
+            // optimize until either limit of iterations has been reached, or
+            // the norm of the gradient has fallen below the target size
+            double _optimize_with_gradient();
+
         public:
             static double _evaluate_original_adapter(const gsl_vector * gsl_parameters, void * _this);
             static double _evaluate_negative_adapter(const gsl_vector * gsl_parameters, void * _this);
 
-            OptimizerGSL(const DensityPtr & density, const unsigned & max_iterations, const double & target_size);
+            static void _gradient_original_adapter(const gsl_vector * gsl_parameters, void * _this, gsl_vector * gsl_gradient);
+            static void _gradient_negative_adapter(const gsl_vector * gsl_parameters, void * _this, gsl_vector * gsl_gradient);
+
+            static void _evaluate_with_gradient_original_adapter(const gsl_vector * gsl_parameters, void * _this, double * f, gsl_vector * gsl_gradient);
+            static void _evaluate_with_gradient_negative_adapter(const gsl_vector * gsl_parameters, void * _this, double * f, gsl_vector * gsl_gradient);
+
+            /*!
+             * Constructor.
+             *
+             * @param density        The density to be optimized.
+             * @param max_iterations The maximum number of iterations.
+             * @param target_size    The target size of the simplex, or the target norm of the gradient
+             *                       for the gradient-based algorithms.
+             * @param algorithm      One of "simplex", "bfgs2", "conjugate-fr", "conjugate-pr" or "steepest-descent".
+             *                       The gradient-based algorithms use a NumericalDerivatives object, which
+             *                       evaluates the density's gradient concurrently.
+             */
+            OptimizerGSL(const DensityPtr & density, const unsigned & max_iterations, const double & target_size,
+                    const std::string & algorithm = "simplex");
 
             ~OptimizerGSL();
 
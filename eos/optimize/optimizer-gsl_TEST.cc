@@ -201,5 +201,34 @@ class OptimizerGSLTest :
                     TEST_CHECK_NEARLY_EQUAL(p.parameter->evaluate(), value, eps);
                 }
             }
+
+            // shifted_multivariate_unit_normal: 20D, gradient-based algorithms
+            for (auto algorithm : { "bfgs2", "conjugate-fr", "conjugate-pr" })
+            {
+                static const double eps = 1e-5;
+                static const double target_size = 1e-7;
+                static const unsigned max_iterations = 200;
+
+                DensityPtr density(new DensityWrapper(make_shifted_multivariate_unit_normal(20)));
+
+                OptimizerPtr optimizer(new OptimizerGSL(density, max_iterations, target_size, algorithm));
+                optimizer->maximize();
+
+                unsigned i = 0;
+                for (auto & p : *density)
+                {
+                    unsigned index = i++;
+                    double value = index % 5;
+
+                    TEST_CHECK_NEARLY_EQUAL(p.parameter->evaluate(), value, eps);
+                }
+            }
+
+            // unknown algorithm
+            {
+                DensityPtr density(new DensityWrapper(make_multivariate_unit_normal(3)));
+
+                TEST_CHECK_THROWS(OptimizerError, OptimizerGSL(density, 100, 1e-6, "foo"));
+            }
         }
 } optimizer_gsl_test;
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2014, 2017 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2014, 2017, 2020 Danny van Dyk
  * Copyright (c) 2010 Christoph Bobeth
  * Copyright (c) 2010, 2011 Christian Wacker
  *
@@ -22,9 +22,12 @@
 #include <eos/rare-b-decays/charm-loops.hh>
 #include <eos/rare-b-decays/long-distance.hh>
 #include <eos/utils/exception.hh>
+#include <eos/utils/memoise.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/stringify.hh>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <complex>
 
@@ -516,554 +519,781 @@ namespace eos
         }
     }
 
-    // cf. [AAGW2001], Eq. (56), p. 20
-    complex<double>
-    CharmLoops::F27_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
+    namespace impl
     {
-        // cf. [ABGW2001], Appendix B, pp. 34-38
-        static double kap2700[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{6.85597, 3.10281}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{13.2214, -9.55118}, {31.3046, -11.1701}, {-3.55556, -22.3402}, {-2.37037, 0}, {0, 0}},
-            {{-11.182, 18.3741}, {27.9808, 0}, {0, -22.3402}, {-2.37037, 0}, {0, 0}},
-            {{7.26787, -17.3757}, {-17.9753, 14.8935}, {24.8889, 0}, {0, 0}, {0, 0}}
+        /*
+         * The massive two-loop functions F19, F27 and F29 are expansions up to third order in s_hat = s / m_b^2.
+         * Their coefficients depend only on m_q_hat = m_q / m_b and on L_mu = log(mu / m_b):
+         *
+         *   F = sum_k (c_k + L_mu d_k) b_k(s_hat) + L_mu^2 e,
+         *
+         * with the basis functions b_k = 1, L, s_hat, s_hat L, s_hat^2, s_hat^2 L, s_hat^3, s_hat^3 L and L = log(s_hat).
+         */
+        struct MassiveExpansion
+        {
+            complex<double> c[8];
+
+            complex<double> d[8];
+
+            double e;
+
+            MassiveExpansion() :
+                e(0.0)
+            {
+            }
+
+            MassiveExpansion(const MassiveExpansion & a, const double & alpha, const MassiveExpansion & b, const double & beta, const MassiveExpansion & c, const double & gamma) :
+                e(alpha * a.e + beta * b.e + gamma * c.e)
+            {
+                for (unsigned k = 0 ; k < 8 ; ++k)
+                {
+                    this->c[k] = alpha * a.c[k] + beta * b.c[k] + gamma * c.c[k];
+                    this->d[k] = alpha * a.d[k] + beta * b.d[k] + gamma * c.d[k];
+                }
+            }
         };
 
-        static double kap2710[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{12.4502, -8.37758}, {2.66667, -5.58505}, {0, 0}, {0, 0}, {0, 0}},
-            {{155.555, -34.6839}, {20.4061, -78.1908}, {26.9502, -22.3402}, {-2.37037, 0}, {2.37037, 0}},
-            {{-68.5374, 91.4251}, {204.484, -67.0206}, {-62.2222, -111.701}, {-14.2222, 0}, {0, 0}},
-            {{-70.5057, -94.1903}, {-113.738, 148.935}, {87.7037, 0}, {0, 0}, {0, 0}}
-        };
+        complex<double>
+        evaluate(const MassiveExpansion & x, const char * name, const double & mu, const double & s, const double & m_b)
+        {
+            const double s_hat = s / m_b / m_b;
+            const double l_mu = log(mu / m_b);
+
+            complex<double> log_s_hat = { std::log(std::abs(s_hat)), 0.0 };
+            if ((0.0 <= s_hat) && (s_hat <= 0.45))
+            {
+                log_s_hat.imag(0.0);
+            }
+            else if ((-0.45 <= s_hat) && (s_hat <= -0.00))
+            {
+                log_s_hat.imag(+M_PI);
+            }
+            else
+            {
+                throw InternalError("CharmLoop::" + std::string(name) + " used outside its domain of validity, s_hat = " + stringify(s_hat));
+            }
+
+            const complex<double> basis[8] = {
+                1.0, log_s_hat, s_hat, s_hat * log_s_hat, s_hat * s_hat, s_hat * s_hat * log_s_hat, pow(s_hat, 3), pow(s_hat, 3) * log_s_hat
+            };
 
-        static double kap2711[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-6.22222, -5.58505}, {-3.55556, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{27.9808, 0}, {0, -44.6804}, {-14.2222, 0}, {0, 0}, {0, 0}},
-            {{-40.4253, -11.1701}, {-7.11111, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}}
-        };
+            complex<double> result = x.e * l_mu * l_mu;
+            for (unsigned k = 0 ; k < 8 ; ++k)
+                result += (x.c[k] + l_mu * x.d[k]) * basis[k];
 
-        static double kap2720[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0333333, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{116.815, -9.54113}, {70.0677, -5.58505}, {17.7778, 0}, {2.37037, 0}, {0, 0}},
-            {{542.972, -88.6728}, {-89.5971, -134.041}, {146.628, -22.3402}, {-7.11111, 0}, {7.11111, 0}},
-            {{-143.29, 196.813}, {496.749, -234.572}, {-193.778, -268.083}, {-35.5556, 0}, {0, 0}},
-            {{-228.849, -209.21}, {-231.862, 484.038}, {249.481, 0}, {0, 0}, {0, 0}}
-        };
+            return result;
+        }
 
-        static double kap2721[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-14.2222, -11.1701}, {-7.11111, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{83.9424, -22.3402}, {-14.2222, -134.041}, {-42.6667, 0}, {0, 0}, {0, 0}},
-            {{-165.257, -22.3402}, {-14.2222, 178.722}, {56.8889, 0}, {0, 0}, {0, 0}}
-        };
+        // cf. [AAGW2001], Eq. (56), p. 20
+        MassiveExpansion
+        f27_expansion(const double & m_q_hat)
+        {
+            // cf. [ABGW2001], Appendix B, pp. 34-38
+            static double kap2700[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{6.85597, 3.10281}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{13.2214, -9.55118}, {31.3046, -11.1701}, {-3.55556, -22.3402}, {-2.37037, 0}, {0, 0}},
+                {{-11.182, 18.3741}, {27.9808, 0}, {0, -22.3402}, {-2.37037, 0}, {0, 0}},
+                {{7.26787, -17.3757}, {-17.9753, 14.8935}, {24.8889, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap2730[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.000646678, -0.015514}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-5.68087, 0.15514}, {-2.93333, 0}, {-0.592593, 0}, {0, 0}, {0, 0}},
-            {{251.971, -9.82039}, {181.255, -5.58505}, {37.3333, 0}, {7.11111, 0}, {0, 0}},
-            {{1136.13, -154.918}, {-255.94, -186.168}, {346.59, -22.3402}, {-16.5926, 0}, {14.2222, 0}},
-            {{-271.07, 314.524}, {871.089, -532.442}, {-425.481, -491.485}, {-66.3704, 0}, {0, 0}},
-            {{-464.161, -325.499}, {-350.695, 1109.56}, {576.593, 0}, {0, 0}, {0, 0}}
-        };
+            static double kap2710[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{12.4502, -8.37758}, {2.66667, -5.58505}, {0, 0}, {0, 0}, {0, 0}},
+                {{155.555, -34.6839}, {20.4061, -78.1908}, {26.9502, -22.3402}, {-2.37037, 0}, {2.37037, 0}},
+                {{-68.5374, 91.4251}, {204.484, -67.0206}, {-62.2222, -111.701}, {-14.2222, 0}, {0, 0}},
+                {{-70.5057, -94.1903}, {-113.738, 148.935}, {87.7037, 0}, {0, 0}, {0, 0}}
+            };
 
-        static double kap2731[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-23.1111, -16.7552}, {-10.6667, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{164.329, -78.1908}, {-49.7778, -268.083}, {-85.3333, 0}, {0, 0}, {0, 0}},
-            {{-416.697, -11.1701}, {-7.11111, 446.804}, {142.222, 0}, {0, 0}, {0, 0}}
-        };
+            static double kap2711[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-6.22222, -5.58505}, {-3.55556, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{27.9808, 0}, {0, -44.6804}, {-14.2222, 0}, {0, 0}, {0, 0}},
+                {{-40.4253, -11.1701}, {-7.11111, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}}
+            };
 
-        double m_q_hat = m_q / m_b, z = pow(m_q_hat, 2);
-        double s_hat = s / m_b / m_b;
+            static double kap2720[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0333333, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{116.815, -9.54113}, {70.0677, -5.58505}, {17.7778, 0}, {2.37037, 0}, {0, 0}},
+                {{542.972, -88.6728}, {-89.5971, -134.041}, {146.628, -22.3402}, {-7.11111, 0}, {7.11111, 0}},
+                {{-143.29, 196.813}, {496.749, -234.572}, {-193.778, -268.083}, {-35.5556, 0}, {0, 0}},
+                {{-228.849, -209.21}, {-231.862, 484.038}, {249.481, 0}, {0, 0}, {0, 0}}
+            };
 
-        const double rho27[4] = {
-            -11.6973 * pow(m_q_hat, 3), -70.1839 * m_q_hat, -421.103 * m_q_hat, 23.3946 / m_q_hat - 959.179 * m_q_hat
-        };
+            static double kap2721[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-14.2222, -11.1701}, {-7.11111, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{83.9424, -22.3402}, {-14.2222, -134.041}, {-42.6667, 0}, {0, 0}, {0, 0}},
+                {{-165.257, -22.3402}, {-14.2222, 178.722}, {56.8889, 0}, {0, 0}, {0, 0}}
+            };
 
-        if (s_hat == 0)
-        {
-            return impl::f27_0(mu, m_b, m_q);
-        }
+            static double kap2730[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.000646678, -0.015514}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-5.68087, 0.15514}, {-2.93333, 0}, {-0.592593, 0}, {0, 0}, {0, 0}},
+                {{251.971, -9.82039}, {181.255, -5.58505}, {37.3333, 0}, {7.11111, 0}, {0, 0}},
+                {{1136.13, -154.918}, {-255.94, -186.168}, {346.59, -22.3402}, {-16.5926, 0}, {14.2222, 0}},
+                {{-271.07, 314.524}, {871.089, -532.442}, {-425.481, -491.485}, {-66.3704, 0}, {0, 0}},
+                {{-464.161, -325.499}, {-350.695, 1109.56}, {576.593, 0}, {0, 0}, {0, 0}}
+            };
 
-        complex<double> log_s_hat = { std::log(std::abs(s_hat)), 0.0 };
-        if ((0.0 < s_hat) && (s_hat <= 0.45))
-        {
-            log_s_hat.imag(0.0);
-        }
-        else if ((-0.45 <= s_hat) && (s_hat <= -0.00))
-        {
-            log_s_hat.imag(+M_PI);
+            static double kap2731[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-23.1111, -16.7552}, {-10.6667, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{164.329, -78.1908}, {-49.7778, -268.083}, {-85.3333, 0}, {0, 0}, {0, 0}},
+                {{-416.697, -11.1701}, {-7.11111, 446.804}, {142.222, 0}, {0, 0}, {0, 0}}
+            };
+
+            const double z = pow(m_q_hat, 2);
+
+            const double rho27[4] = {
+                -11.6973 * pow(m_q_hat, 3), -70.1839 * m_q_hat, -421.103 * m_q_hat, 23.3946 / m_q_hat - 959.179 * m_q_hat
+            };
+
+            double re[8] = { 0.0 }, im[8] = { 0.0 };
+
+            // real part
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 4 ; m++)
+                    re[0] += kap2700[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[2] += kap2710[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[3] += kap2711[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 2 ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[4] += kap2720[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[5] += kap2721[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 1 ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[6] += kap2730[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[7] += kap2731[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 0 ; l < 4; l++)
+                re[2 * l] += rho27[l];
+
+            // imaginary part
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[0] += kap2700[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[2] += kap2710[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[3] += kap2711[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[4] += kap2720[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[5] += kap2721[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 1 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[6] += kap2730[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[7] += kap2731[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+
+            MassiveExpansion result;
+            for (unsigned k = 0 ; k < 8 ; ++k)
+                result.c[k] = complex<double>(re[k], im[k]);
+
+            // terms proportional to log(mu / m_b)
+            result.d[0] = 416.0 / 81.0;
+
+            return result;
         }
-        else
+
+        // cf. [AAGW2001], Eq. (54), p. 19
+        MassiveExpansion
+        f19_expansion(const double & m_q_hat)
         {
-            throw InternalError("CharmLoop::F27_massive used outside its domain of validity, s_hat = " + stringify(s_hat));
-        }
+            // cf. [ABGW2001], Appendix B, pp. 34-38
+            static double kap1900[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-4.61812, 3.67166}, {5.62963, 1.86168}, {0, 0}, {0, 0}, {0, 0}},
+                {{14.4621, -16.2155}, {9.59321, -11.1701}, {-1.18519, -7.44674}, {-0.790123, 0}, {0, 0}},
+                {{-16.0864, 26.7517}, {54.2439, -14.8935}, {-15.4074, -29.787}, {-3.95062, 0}, {0, 0}},
+                {{-14.73, -23.6892}, {-28.5761, 34.7514}, {20.1481, 0}, {0, 0}, {0, 0}}
+            };
 
-        // real part
-        complex<double> r = 416.0 / 81.0 * log(mu / m_b);
+            static double kap1901[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0493827, -0.103427}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.592593, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{4.95977, -1.86168}, {-1.18519, -7.44674}, {-2.37037, 0}, {0, 0}, {0, 0}},
+                {{-9.20287, -1.65483}, {-1.0535, 9.92898}, {3.16049, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 4 ; m++)
-                r = r + kap2700[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap1910[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-2.48507, -0.186168}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{4.47441, -0.310281}, {1.48148, -1.86168}, {0, 0}, {0, 0}, {0, 0}},
+                {{71.3855, -30.7987}, {8.47677, -33.5103}, {12.5389, -7.44674}, {-0.790123, 0}, {0.790123, 0}},
+                {{-18.1301, 66.1439}, {149.596, -67.0206}, {-49.1852, -81.9141}, {-11.0617, 0}, {0, 0}},
+                {{-72.89, -63.7828}, {-68.135, 134.041}, {63.6049, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2710[l][m][0] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap1911[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-2.66667, -1.86168}, {-1.18519, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{18.6539, -7.44674}, {-4.74074, -29.787}, {-9.48148, 0}, {0, 0}, {0, 0}},
+                {{-41.6104, -3.72337}, {-2.37037, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2711[l][m][0] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap1920[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.403158, -0.0199466}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0613169, 0.0620562}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{37.1282, -1.36524}, {22.0621, -1.86168}, {5.33333, 0}, {0.790123, 0}, {0, 0}},
+                {{212.74, -52.2081}, {-21.9215, -52.1272}, {57.1724, -7.44674}, {-2.37037, 0}, {2.37037, 0}},
+                {{-44.6829, 108.713}, {272.015, -163.828}, {-119.111, -156.382}, {-21.3333, 0}, {0, 0}},
+                {{-137.203, -106.832}, {-99.437, 330.139}, {168.889, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2720[l][m][0] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap1921[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-5.33333, -3.72337}, {-2.37037, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{40.786, -22.3402}, {-14.2222, -67.0206}, {-21.3333, 0}, {0, 0}, {0, 0}},
+                {{-111.356, 0}, {0, 119.148}, {37.9259, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2721[l][m][0] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap1930[7][5][2] = {
+                {{-0.0759415, -0.00295505}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.00480894, 0.00369382}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-1.81002, 0.0871741}, {-0.919459, 0}, {-0.197531, 0}, {0, 0}, {0, 0}},
+                {{79.7475, -1.72206}, {57.3171, -1.86168}, {11.2593, 0}, {2.37037, 0}, {0, 0}},
+                {{425.579, -76.6479}, {-68.8016, -69.5029}, {129.357, -7.44674}, {-5.53086, 0}, {4.74074, 0}},
+                {{-87.8946, 148.481}, {417.612, -311.522}, {-227.16, -253.189}, {-34.7654, 0}, {0, 0}},
+                {{-279.268, -135.118}, {-146.853, 652.831}, {331.259, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2730[l][m][0] * pow(s_hat, 3) * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap1931[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0219479, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-8.2963, -5.58505}, {-3.55556, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{70.2698, -49.6449}, {-31.6049, -119.148}, {-37.9259, 0}, {0, 0}, {0, 0}},
+                {{-231.893, 18.6168}, {11.8519, 248.225}, {79.0123, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2731[l][m][0] * pow(s_hat, 3) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            const double z = pow(m_q_hat, 2);
 
-        for (int l = 0 ; l < 4; l++)
-            r = r + rho27[l] * pow(s_hat, l);
+            const double rho19[4] = {
+                3.8991 * pow(m_q_hat, 3), -23.3946 * m_q_hat, -140.368 * m_q_hat, 7.79821 / m_q_hat - 319.726 * m_q_hat
+            };
 
-        // imaginary part
-        complex<double> i = 0.0;
+            double re[8] = { 0.0 }, im[8] = { 0.0 };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2700[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+            // real part
+            for (int l = 3  ; l < 7 ; l++)
+                for (int m = 0  ; m < 4  ; m++)
+                    re[0] += kap1900[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2710[l][m][1] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 3  ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[1] += kap1901[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2711[l][m][1] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 2  ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[2] += kap1910[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2720[l][m][1] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 4  ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[3] += kap1911[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2721[l][m][1] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 1  ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[4] += kap1920[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2730[l][m][1] * pow(s_hat, 3) * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 3  ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[5] += kap1921[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2731[l][m][1] * pow(s_hat, 3) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 0  ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[6] += kap1930[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        return r + complex<double>(0.0, 1.0) * i;
-    }
+            for (int l = 3  ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[7] += kap1931[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-    // cf. [AAGW2001], Eq. (54), p. 19
-    complex<double>
-    CharmLoops::F19_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
-    {
-        // F19(s) diverges for s -> 0. However, s * F19(s) -> 0 for s -> 0.
-        if (abs(s) < 1e-6) // allow for s = 1e-6, corresponding roughly to the dielectron threshold
-            throw InternalError("CharmLoops::F19_massive: F19 diverges for s -> 0. Check that F19 enters via 's * F19(s)' and replace by zero.");
+            for (int l = 0 ; l < 4; l++)
+                re[2 * l] += rho19[l];
 
-        // cf. [ABGW2001], Appendix B, pp. 34-38
-        static double kap1900[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-4.61812, 3.67166}, {5.62963, 1.86168}, {0, 0}, {0, 0}, {0, 0}},
-            {{14.4621, -16.2155}, {9.59321, -11.1701}, {-1.18519, -7.44674}, {-0.790123, 0}, {0, 0}},
-            {{-16.0864, 26.7517}, {54.2439, -14.8935}, {-15.4074, -29.787}, {-3.95062, 0}, {0, 0}},
-            {{-14.73, -23.6892}, {-28.5761, 34.7514}, {20.1481, 0}, {0, 0}, {0, 0}}
-        };
+            // imaginary part
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[0] += kap1900[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap1901[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0493827, -0.103427}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.592593, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{4.95977, -1.86168}, {-1.18519, -7.44674}, {-2.37037, 0}, {0, 0}, {0, 0}},
-            {{-9.20287, -1.65483}, {-1.0535, 9.92898}, {3.16049, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[1] += kap1901[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap1910[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-2.48507, -0.186168}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{4.47441, -0.310281}, {1.48148, -1.86168}, {0, 0}, {0, 0}, {0, 0}},
-            {{71.3855, -30.7987}, {8.47677, -33.5103}, {12.5389, -7.44674}, {-0.790123, 0}, {0.790123, 0}},
-            {{-18.1301, 66.1439}, {149.596, -67.0206}, {-49.1852, -81.9141}, {-11.0617, 0}, {0, 0}},
-            {{-72.89, -63.7828}, {-68.135, 134.041}, {63.6049, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 2 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[2] += kap1910[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap1911[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-2.66667, -1.86168}, {-1.18519, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{18.6539, -7.44674}, {-4.74074, -29.787}, {-9.48148, 0}, {0, 0}, {0, 0}},
-            {{-41.6104, -3.72337}, {-2.37037, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[3] += kap1911[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap1920[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.403158, -0.0199466}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0613169, 0.0620562}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{37.1282, -1.36524}, {22.0621, -1.86168}, {5.33333, 0}, {0.790123, 0}, {0, 0}},
-            {{212.74, -52.2081}, {-21.9215, -52.1272}, {57.1724, -7.44674}, {-2.37037, 0}, {2.37037, 0}},
-            {{-44.6829, 108.713}, {272.015, -163.828}, {-119.111, -156.382}, {-21.3333, 0}, {0, 0}},
-            {{-137.203, -106.832}, {-99.437, 330.139}, {168.889, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 1 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[4] += kap1920[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap1921[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0164609, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-5.33333, -3.72337}, {-2.37037, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{40.786, -22.3402}, {-14.2222, -67.0206}, {-21.3333, 0}, {0, 0}, {0, 0}},
-            {{-111.356, 0}, {0, 119.148}, {37.9259, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[5] += kap1921[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap1930[7][5][2] = {
-            {{-0.0759415, -0.00295505}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.00480894, 0.00369382}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-1.81002, 0.0871741}, {-0.919459, 0}, {-0.197531, 0}, {0, 0}, {0, 0}},
-            {{79.7475, -1.72206}, {57.3171, -1.86168}, {11.2593, 0}, {2.37037, 0}, {0, 0}},
-            {{425.579, -76.6479}, {-68.8016, -69.5029}, {129.357, -7.44674}, {-5.53086, 0}, {4.74074, 0}},
-            {{-87.8946, 148.481}, {417.612, -311.522}, {-227.16, -253.189}, {-34.7654, 0}, {0, 0}},
-            {{-279.268, -135.118}, {-146.853, 652.831}, {331.259, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 0 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[6] += kap1930[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap1931[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0219479, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-8.2963, -5.58505}, {-3.55556, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{70.2698, -49.6449}, {-31.6049, -119.148}, {-37.9259, 0}, {0, 0}, {0, 0}},
-            {{-231.893, 18.6168}, {11.8519, 248.225}, {79.0123, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[7] += kap1931[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        double m_q_hat = m_q / m_b, z = pow(m_q_hat, 2);
-        double s_hat = s / m_b / m_b;
+            MassiveExpansion result;
+            for (unsigned k = 0 ; k < 8 ; ++k)
+                result.c[k] = complex<double>(re[k], im[k]);
 
-        complex<double> log_s_hat = { std::log(std::abs(s_hat)), 0.0 };
-        if ((0.000 <= s_hat) && (s_hat <= 0.45))
-        {
-            log_s_hat.imag(0.0);
-        }
-        else if ((-0.45 <= s_hat) && (s_hat <= -0.000))
-        {
-            log_s_hat.imag(+M_PI);
+            // terms proportional to log(mu / m_b)
+            result.d[0] = complex<double>(-1424.0 / 729.0 + 64.0 / 27.0 * log(m_q_hat), 16.0 / 243.0 * M_PI);
+            result.d[1] = -16.0 / 243.0;
+            result.d[2] = 16.0 / 1215.0 - 32.0 / 135.0 / pow(m_q_hat, 2);
+            result.d[4] = 4.0 / 2835.0 - 8.0 / 315.0 / pow(m_q_hat, 4);
+            result.d[6] = 16.0 / 76545.0 - 32.0 / 8505.0 / pow(m_q_hat, 6);
+            result.e = -256.0 / 243.0;
+
+            return result;
         }
-        else
+
+        // cf. [AAGW2001], Eq. (54), p. 19
+        MassiveExpansion
+        f29_expansion(const double & m_q_hat)
         {
-            throw InternalError("CharmLoop::F19_massive used outside its domain of validity, s_hat = " + stringify(s_hat));
-        }
+            // cf. [ABGW2001], Appendix B, pp. 34-38
+            static double kap2900[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-24.2913, -22.0299}, {-23.1111, -11.1701}, {0, 0}, {0, 0}, {0, 0}},
+                {{-86.7723, 97.2931}, {-57.5593, 67.0206}, {7.11111, 44.6804}, {4.74074, 0}, {0, 0}},
+                {{96.5187, -160.51}, {-325.463, 89.3609}, {92.4444, 178.722}, {23.7037, 0}, {0, 0}},
+                {{88.3801, 142.135}, {171.457, -208.509}, {-120.889, 0}, {0, 0}, {0, 0}}
+            };
 
-        const double rho19[4] = {
-            3.8991 * pow(m_q_hat, 3), -23.3946 * m_q_hat, -140.368 * m_q_hat, 7.79821 / m_q_hat - 319.726 * m_q_hat
-        };
+            static double kap2901[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.296296, 0.620562}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{3.55556, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-29.7586, 11.1701}, {7.11111, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}},
+                {{55.2172, 9.92898}, {6.32099, -59.5739}, {-18.963, 0}, {0, 0}, {0, 0}}
+            };
 
-        // real part
-        complex<double> r = (-1424.0 / 729.0 + 64.0 / 27.0 * log(m_q_hat)) * log(mu/m_b)
-            - 16.0 / 243.0 * log(mu/m_b) * log_s_hat
-            + (16.0 / 1215.0 - 32.0 / 135.0 /pow(m_q_hat, 2)) * log(mu/m_b) * s_hat
-            + (4.0 / 2835.0 - 8.0 / 315.0 /pow(m_q_hat, 4)) * log(mu/m_b) * s_hat * s_hat
-            + (16.0 / 76545.0 - 32.0 /8505.0 / pow(m_q_hat, 6)) * log(mu/m_b) * pow(s_hat, 3)
-            - 256.0 / 243.0 * pow(log(mu/m_b), 2);
-
-        for (int l = 3  ; l < 7 ; l++)
-            for (int m = 0  ; m < 4  ; m++)
-                r = r + kap1900[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
-
-        for (int l = 3  ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1901[l][m][0] * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap2910[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.8462, 1.11701}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-26.8464, 1.86168}, {-8.88889, 11.1701}, {0, 0}, {0, 0}, {0, 0}},
+                {{-428.313, 184.792}, {-50.8606, 201.062}, {-75.2337, 44.6804}, {4.74074, 0}, {-4.74074, 0}},
+                {{108.781, -396.864}, {-897.575, 402.124}, {295.111, 491.485}, {66.3704, 0}, {0, 0}},
+                {{437.34, 382.697}, {408.81, -804.248}, {-381.63, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 2  ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1910[l][m][0] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap2911[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{16., 11.1701}, {7.11111, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-111.923, 44.6804}, {28.4444, 178.722}, {56.8889, 0}, {0, 0}, {0, 0}},
+                {{249.663, 22.3402}, {14.2222, -268.083}, {-85.3333, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 4  ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1911[l][m][0] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap2920[7][5][2] = {{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0132191, 0.11968}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.367901, -0.372337}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-222.769, 8.19141}, {-132.372, 11.1701}, {-32., 0}, {-4.74074, 0}, {0, 0}},
+                {{-1276.44, 313.249}, {131.529, 312.763}, {-343.034, 44.6804}, {14.2222, 0}, {-14.2222, 0}},
+                {{268.098, -652.279}, {-1632.09, 982.969}, {714.667, 938.289}, {128., 0}, {0, 0}},
+                {{823.218, 640.989}, {596.622, -1980.83}, {-1013.33, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 1  ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1920[l][m][0] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap2921[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{32., 22.3402}, {14.2222, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-244.716, 134.041}, {85.3333, 402.124}, {128., 0}, {0, 0}, {0, 0}},
+                {{668.137, 0}, {0, -714.887}, {-227.556, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3  ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1921[l][m][0] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap2930[7][5][2] = {
+                {{-0.0142243, 0.0177303}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0.0288536, -0.0221629}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{10.8601, -0.523045}, {5.51675, 0}, {1.18519, 0}, {0, 0}, {0, 0}},
+                {{-478.485, 10.3323}, {-343.902, 11.1701}, {-67.5556, 0}, {-14.2222, 0}, {0, 0}},
+                {{-2553.47, 459.887}, {412.809, 417.017}, {-776.143, 44.6804}, {33.1852, 0}, {-28.4444, 0}},
+                {{527.368, -890.889}, {-2505.67, 1869.13}, {1362.96, 1519.13}, {208.593, 0}, {0, 0}},
+                {{1675.61, 810.709}, {881.117, -3916.98}, {-1987.56, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 0  ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap1930[l][m][0] * pow(s_hat, 3) * pow(z, l-3) * pow(log(m_q_hat), m);
+            static double kap2931[7][5][2] = {
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-0.131687, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{49.7778, 33.5103}, {21.3333, 0}, {0, 0}, {0, 0}, {0, 0}},
+                {{-421.619, 297.87}, {189.63, 714.887}, {227.556, 0}, {0, 0}, {0, 0}},
+                {{1391.36, -111.701}, {-71.1111, -1489.35}, {-474.074, 0}, {0, 0}, {0, 0}}
+            };
 
-        for (int l = 3  ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap1931[l][m][0] * pow(s_hat, 3) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            const double z = pow(m_q_hat, 2);
 
-        for (int l = 0  ; l < 4; l++)
-            r = r + rho19[l] * pow(s_hat, l);
+            const double rho29[4] = {
+                -23.3946 * pow(m_q_hat, 3), 140.368 * m_q_hat, 842.206 * m_q_hat, -46.7892 / m_q_hat + 1918.36 * m_q_hat
+            };
 
-        // imaginary part
-        complex<double> i = 16.0 / 243.0 * M_PI * log(mu/m_b);
+            double re[8] = { 0.0 }, im[8] = { 0.0 };
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1900[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+            // real part
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 4 ; m++)
+                    re[0] += kap2900[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1901[l][m][1] * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[1] += kap2901[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1910[l][m][1] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 2 ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[2] += kap2910[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1911[l][m][1] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[3] += kap2911[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1920[l][m][1] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 1 ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[4] += kap2920[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1921[l][m][1] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[5] += kap2921[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 0 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap1930[l][m][1] * pow(s_hat, 3) * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 0 ; l < 7 ; l++)
+                for (int m = 0 ; m < 5 ; m++)
+                    re[6] += kap2930[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap1931[l][m][1] * pow(s_hat, 3) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    re[7] += kap2931[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        return r + complex<double>(0.0, 1.0) * i;
-    }
+            for (int l = 0 ; l < 4; l++)
+                re[2 * l] += rho29[l];
 
-    // cf. [AAGW2001], Eq. (54), p. 19
-    complex<double>
-    CharmLoops::F29_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
-    {
-        // F29(s) diverges for s -> 0. However, s * F29(s) -> 0 for s -> 0.
-        if (abs(s) < 1e-6) // allow for s = 1e-6, corresponding roughly to the dielectron threshold
-            throw InternalError("CharmLoops::F29_massive: F29 diverges for s -> 0. Check that F29 enters via 's * F29(s)' and replace by zero.");
+            // imaginary part
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[0] += kap2900[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        // cf. [ABGW2001], Appendix B, pp. 34-38
-        static double kap2900[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-24.2913, -22.0299}, {-23.1111, -11.1701}, {0, 0}, {0, 0}, {0, 0}},
-            {{-86.7723, 97.2931}, {-57.5593, 67.0206}, {7.11111, 44.6804}, {4.74074, 0}, {0, 0}},
-            {{96.5187, -160.51}, {-325.463, 89.3609}, {92.4444, 178.722}, {23.7037, 0}, {0, 0}},
-            {{88.3801, 142.135}, {171.457, -208.509}, {-120.889, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 3 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[1] += kap2901[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap2901[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.296296, 0.620562}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{3.55556, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-29.7586, 11.1701}, {7.11111, 44.6804}, {14.2222, 0}, {0, 0}, {0, 0}},
-            {{55.2172, 9.92898}, {6.32099, -59.5739}, {-18.963, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 2 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[2] += kap2910[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap2910[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.8462, 1.11701}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-26.8464, 1.86168}, {-8.88889, 11.1701}, {0, 0}, {0, 0}, {0, 0}},
-            {{-428.313, 184.792}, {-50.8606, 201.062}, {-75.2337, 44.6804}, {4.74074, 0}, {-4.74074, 0}},
-            {{108.781, -396.864}, {-897.575, 402.124}, {295.111, 491.485}, {66.3704, 0}, {0, 0}},
-            {{437.34, 382.697}, {408.81, -804.248}, {-381.63, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[3] += kap2911[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap2911[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{16., 11.1701}, {7.11111, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-111.923, 44.6804}, {28.4444, 178.722}, {56.8889, 0}, {0, 0}, {0, 0}},
-            {{249.663, 22.3402}, {14.2222, -268.083}, {-85.3333, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 1 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[4] += kap2920[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap2920[7][5][2] = {{{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0132191, 0.11968}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.367901, -0.372337}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-222.769, 8.19141}, {-132.372, 11.1701}, {-32., 0}, {-4.74074, 0}, {0, 0}},
-            {{-1276.44, 313.249}, {131.529, 312.763}, {-343.034, 44.6804}, {14.2222, 0}, {-14.2222, 0}},
-            {{268.098, -652.279}, {-1632.09, 982.969}, {714.667, 938.289}, {128., 0}, {0, 0}},
-            {{823.218, 640.989}, {596.622, -1980.83}, {-1013.33, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[5] += kap2921[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap2921[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.0987654, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{32., 22.3402}, {14.2222, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-244.716, 134.041}, {85.3333, 402.124}, {128., 0}, {0, 0}, {0, 0}},
-            {{668.137, 0}, {0, -714.887}, {-227.556, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 0 ; l < 7 ; l++)
+                for (int m = 0 ; m < 3 ; m++)
+                    im[6] += kap2930[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap2930[7][5][2] = {
-            {{-0.0142243, 0.0177303}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0.0288536, -0.0221629}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{10.8601, -0.523045}, {5.51675, 0}, {1.18519, 0}, {0, 0}, {0, 0}},
-            {{-478.485, 10.3323}, {-343.902, 11.1701}, {-67.5556, 0}, {-14.2222, 0}, {0, 0}},
-            {{-2553.47, 459.887}, {412.809, 417.017}, {-776.143, 44.6804}, {33.1852, 0}, {-28.4444, 0}},
-            {{527.368, -890.889}, {-2505.67, 1869.13}, {1362.96, 1519.13}, {208.593, 0}, {0, 0}},
-            {{1675.61, 810.709}, {881.117, -3916.98}, {-1987.56, 0}, {0, 0}, {0, 0}}
-        };
+            for (int l = 4 ; l < 7 ; l++)
+                for (int m = 0 ; m < 2 ; m++)
+                    im[7] += kap2931[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
 
-        static double kap2931[7][5][2] = {
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-0.131687, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{49.7778, 33.5103}, {21.3333, 0}, {0, 0}, {0, 0}, {0, 0}},
-            {{-421.619, 297.87}, {189.63, 714.887}, {227.556, 0}, {0, 0}, {0, 0}},
-            {{1391.36, -111.701}, {-71.1111, -1489.35}, {-474.074, 0}, {0, 0}, {0, 0}}
-        };
+            MassiveExpansion result;
+            for (unsigned k = 0 ; k < 8 ; ++k)
+                result.c[k] = complex<double>(re[k], im[k]);
 
-        double m_q_hat = m_q / m_b, z = pow(m_q_hat, 2);
-        double s_hat = s / m_b / m_b;
+            // terms proportional to log(mu / m_b)
+            result.d[0] = complex<double>(256.0 / 243.0 - 128.0 / 9.0 * log(m_q_hat), -32.0 / 81.0 * M_PI);
+            result.d[1] = 32.0 / 81.0;
+            result.d[2] = -32.0 / 405.0 + 64.0 / 45.0 / pow(m_q_hat, 2);
+            result.d[4] = -8.0 / 945.0 + 16.0 / 105.0 / pow(m_q_hat, 4);
+            result.d[6] = -32.0 / 25515.0 + 64.0 / 2835.0 / pow(m_q_hat, 6);
+            result.e = 512.0 / 81.0;
 
-        complex<double> log_s_hat = { std::log(std::abs(s_hat)), 0.0 };
-        if ((0.000 <= s_hat) && (s_hat <= 0.45))
-        {
-            log_s_hat.imag(0.0);
+            return result;
         }
-        else if ((-0.45 <= s_hat) && (s_hat <= -0.000))
+
+        /*
+         * Chebyshev interpolation of the coefficients of a massive expansion in x = log(m_q_hat).
+         *
+         * The interpolation is checked against the exact coefficients upon construction. Outside of
+         * its range, the exact coefficients are used.
+         */
+        class MassiveExpansionTable
         {
-            log_s_hat.imag(+M_PI);
-        }
-        else
+            private:
+                static constexpr unsigned order = 20;
+
+                MassiveExpansion (* _expansion)(const double &);
+
+                double _x_min, _x_max;
+
+                std::array<MassiveExpansion, order> _coefficients;
+
+                MassiveExpansion interpolate(const double & x) const
+                {
+                    const double y = (2.0 * x - _x_min - _x_max) / (_x_max - _x_min);
+
+                    // Clenshaw's recurrence
+                    MassiveExpansion b1, b2;
+                    for (unsigned n = order - 1 ; n > 0 ; --n)
+                    {
+                        MassiveExpansion b0(_coefficients[n], 1.0, b1, 2.0 * y, b2, -1.0);
+                        b2 = b1;
+                        b1 = b0;
+                    }
+
+                    return MassiveExpansion(_coefficients[0], 0.5, b1, y, b2, -1.0);
+                }
+
+            public:
+                MassiveExpansionTable(MassiveExpansion (* expansion)(const double &), const double & m_q_hat_min, const double & m_q_hat_max) :
+                    _expansion(expansion),
+                    _x_min(log(m_q_hat_min)),
+                    _x_max(log(m_q_hat_max))
+                {
+                    std::array<MassiveExpansion, order> samples;
+                    for (unsigned j = 0 ; j < order ; ++j)
+                    {
+                        const double y = std::cos(M_PI * (j + 0.5) / order);
+                        samples[j] = expansion(std::exp(0.5 * (_x_min + _x_max) + 0.5 * (_x_max - _x_min) * y));
+                    }
+
+                    for (unsigned n = 0 ; n < order ; ++n)
+                    {
+                        MassiveExpansion a;
+                        for (unsigned j = 0 ; j < order ; ++j)
+                        {
+                            a = MassiveExpansion(a, 1.0, samples[j], 2.0 / order * std::cos(M_PI * n * (j + 0.5) / order), a, 0.0);
+                        }
+                        _coefficients[n] = a;
+                    }
+
+                    // guarantee the accuracy of the interpolation between and beyond the nodes
+                    static const double tolerance = 1.0e-10;
+                    static const unsigned checks = 4 * order;
+                    for (unsigned i = 0 ; i <= checks ; ++i)
+                    {
+                        const double x = _x_min + (_x_max - _x_min) * i / checks;
+                        const MassiveExpansion exact = expansion(std::exp(x));
+                        const MassiveExpansion difference(interpolate(x), 1.0, exact, -1.0, exact, 0.0);
+
+                        double error = std::abs(difference.e) / std::max(1.0, std::abs(exact.e));
+                        for (unsigned k = 0 ; k < 8 ; ++k)
+                        {
+                            error = std::max(error, std::abs(difference.c[k]) / std::max(1.0, std::abs(exact.c[k])));
+                            error = std::max(error, std::abs(difference.d[k]) / std::max(1.0, std::abs(exact.d[k])));
+                        }
+
+                        if (error > tolerance)
+                            throw InternalError("MassiveExpansionTable: interpolation error " + stringify(error) + " exceeds the tolerance at m_q_hat = " + stringify(std::exp(x)));
+                    }
+                }
+
+                MassiveExpansion operator() (const double & m_q_hat) const
+                {
+                    const double x = log(m_q_hat);
+
+                    if ((x < _x_min) || (_x_max < x))
+                        return _expansion(m_q_hat);
+
+                    return interpolate(x);
+                }
+        };
+
+        // the range of m_q / m_b covered by the tables, for both pole and MSbar masses
+        const double table_m_q_hat_min = 0.15;
+        const double table_m_q_hat_max = 0.45;
+    }
+
+    // cf. [AAGW2001], Eq. (56), p. 20
+    complex<double>
+    CharmLoops::F27_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        if (s == 0)
         {
-            throw InternalError("CharmLoop::F29_massive used outside its domain of validity, s_hat = " + stringify(s_hat));
+            return impl::f27_0(mu, m_b, m_q);
         }
 
-        const double rho29[4] = {
-            -23.3946 * pow(m_q_hat, 3), 140.368 * m_q_hat, 842.206 * m_q_hat, -46.7892 / m_q_hat + 1918.36 * m_q_hat
-        };
+        return impl::evaluate(impl::f27_expansion(m_q / m_b), "F27_massive", mu, s, m_b);
+    }
 
-        // real part
-        complex<double> r = (256.0 / 243.0 - 128.0 / 9.0 * log(m_q_hat)) * log(mu / m_b)
-            + 32.0 / 81.0 * log(mu / m_b) * log_s_hat
-            + (-32.0 / 405.0 + 64.0 / 45 / pow(m_q_hat, 2)) * log(mu / m_b) * s_hat
-            + (-8.0 / 945.0 + 16.0 / 105 / pow(m_q_hat, 4)) * log(mu / m_b) * s_hat * s_hat
-            + (-32.0 / 25515.0 + 64.0 / 2835 / pow(m_q_hat, 6)) * log(mu / m_b) * pow(s_hat, 3)
-            + 512.0 / 81.0 * pow(log(mu / m_b), 2);
+    // cf. [AAGW2001], Eq. (54), p. 19
+    complex<double>
+    CharmLoops::F19_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        // F19(s) diverges for s -> 0. However, s * F19(s) -> 0 for s -> 0.
+        if (abs(s) < 1e-6) // allow for s = 1e-6, corresponding roughly to the dielectron threshold
+            throw InternalError("CharmLoops::F19_massive: F19 diverges for s -> 0. Check that F19 enters via 's * F19(s)' and replace by zero.");
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 4 ; m++)
-                r = r + kap2900[l][m][0] * pow(z, l-3) * pow(log(m_q_hat), m);
+        return impl::evaluate(impl::f19_expansion(m_q / m_b), "F19_massive", mu, s, m_b);
+    }
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2901[l][m][0] * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    // cf. [AAGW2001], Eq. (54), p. 19
+    complex<double>
+    CharmLoops::F29_massive(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        // F29(s) diverges for s -> 0. However, s * F29(s) -> 0 for s -> 0.
+        if (abs(s) < 1e-6) // allow for s = 1e-6, corresponding roughly to the dielectron threshold
+            throw InternalError("CharmLoops::F29_massive: F29 diverges for s -> 0. Check that F29 enters via 's * F29(s)' and replace by zero.");
 
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2910[l][m][0] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        return impl::evaluate(impl::f29_expansion(m_q / m_b), "F29_massive", mu, s, m_b);
+    }
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2911[l][m][0] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    CharmLoops::F27_massive_tabulated(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        static const impl::MassiveExpansionTable table(&impl::f27_expansion, impl::table_m_q_hat_min, impl::table_m_q_hat_max);
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2920[l][m][0] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        const impl::MassiveExpansion expansion = table(m_q / m_b);
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2921[l][m][0] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        if (s == 0)
+        {
+            return expansion.c[0] + log(mu / m_b) * expansion.d[0];
+        }
 
-        for (int l = 0 ; l < 7 ; l++)
-            for (int m = 0 ; m < 5 ; m++)
-                r = r + kap2930[l][m][0] * pow(s_hat, 3) * pow(z, l-3) * pow(log(m_q_hat), m);
+        return impl::evaluate(expansion, "F27_massive", mu, s, m_b);
+    }
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                r = r + kap2931[l][m][0] * pow(s_hat, 3) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    CharmLoops::F19_massive_tabulated(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        static const impl::MassiveExpansionTable table(&impl::f19_expansion, impl::table_m_q_hat_min, impl::table_m_q_hat_max);
 
-        for (int l = 0 ; l < 4; l++)
-            r = r + rho29[l] * pow(s_hat, l);
+        if (abs(s) < 1e-6)
+            throw InternalError("CharmLoops::F19_massive: F19 diverges for s -> 0. Check that F19 enters via 's * F19(s)' and replace by zero.");
 
-        // imaginary part
-        complex<double> i = - 32.0 / 81.0 * M_PI * log(mu/m_b);
+        return impl::evaluate(table(m_q / m_b), "F19_massive", mu, s, m_b);
+    }
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2900[l][m][1] * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    CharmLoops::F29_massive_tabulated(const double & mu, const double & s, const double & m_b, const double & m_q)
+    {
+        static const impl::MassiveExpansionTable table(&impl::f29_expansion, impl::table_m_q_hat_min, impl::table_m_q_hat_max);
 
-        for (int l = 3 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2901[l][m][1] * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        if (abs(s) < 1e-6)
+            throw InternalError("CharmLoops::F29_massive: F29 diverges for s -> 0. Check that F29 enters via 's * F29(s)' and replace by zero.");
 
-        for (int l = 2 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2910[l][m][1] * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        return impl::evaluate(table(m_q / m_b), "F29_massive", mu, s, m_b);
+    }
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2911[l][m][1] * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    MassiveCharmLoops::MassiveCharmLoops(const Options & options) :
+        _tabulated(false)
+    {
+        const std::string charm_loops = options.get("charm-loops", "exact");
+        if ("tabulated" == charm_loops)
+        {
+            _tabulated = true;
+        }
+        else if ("exact" != charm_loops)
+        {
+            throw InvalidOptionValueError("charm-loops", charm_loops, "exact, tabulated");
+        }
+    }
 
-        for (int l = 1 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2920[l][m][1] * s_hat * s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    MassiveCharmLoops::F19(const double & mu, const double & s, const double & m_b, const double & m_c) const
+    {
+        if (_tabulated)
+            return CharmLoops::F19_massive_tabulated(mu, s, m_b, m_c);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2921[l][m][1] * s_hat * s_hat * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        return memoise(CharmLoops::F19_massive, mu, s, m_b, m_c);
+    }
 
-        for (int l = 0 ; l < 7 ; l++)
-            for (int m = 0 ; m < 3 ; m++)
-                i = i + kap2930[l][m][1] * pow(s_hat, 3) * pow(z, l-3) * pow(log(m_q_hat), m);
+    complex<double>
+    MassiveCharmLoops::F27(const double & mu, const double & s, const double & m_b, const double & m_c) const
+    {
+        if (_tabulated)
+            return CharmLoops::F27_massive_tabulated(mu, s, m_b, m_c);
 
-        for (int l = 4 ; l < 7 ; l++)
-            for (int m = 0 ; m < 2 ; m++)
-                i = i + kap2931[l][m][1] * pow(s_hat, 3) * log_s_hat * pow(z, l-3) * pow(log(m_q_hat), m);
+        return memoise(CharmLoops::F27_massive, mu, s, m_b, m_c);
+    }
 
-        return r + complex<double>(0.0, 1.0) * i;
+    complex<double>
+    MassiveCharmLoops::F29(const double & mu, const double & s, const double & m_b, const double & m_c) const
+    {
+        if (_tabulated)
+            return CharmLoops::F29_massive_tabulated(mu, s, m_b, m_c);
+
+        return memoise(CharmLoops::F29_massive, mu, s, m_b, m_c);
     }
 
     // cf. [AAGW2001], eqs. (48) and (49), p. 18
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2014 Danny van Dyk
+ * Copyright (c) 2010, 2014, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -58,11 +58,36 @@ namespace eos
         static complex<double> F29_massive(const double & mu, const double & s, const double & m_b, const double & m_c);
         static complex<double> delta_F29_massive(const double & mu, const double & s, const double & m_c);
 
+        // massive case, with the coefficients of the expansion in s / m_b^2 interpolated in m_c / m_b
+        static complex<double> F19_massive_tabulated(const double & mu, const double & s, const double & m_b, const double & m_c);
+        static complex<double> F27_massive_tabulated(const double & mu, const double & s, const double & m_b, const double & m_c);
+        static complex<double> F29_massive_tabulated(const double & mu, const double & s, const double & m_b, const double & m_c);
+
         // helper functions for F8j, cf. [BFS2001], Eqs. (29) and (84), pp. 8 and 30
         static complex<double> B0(const double & s, const double & m_q);
         static complex<double> C0(const double & s, const double & m_q);
     };
 
+    /*!
+     * The massive two-loop functions F19, F27 and F29, as used by the decays.
+     *
+     * The option 'charm-loops' selects either the exact functions (value 'exact', the default),
+     * whose results are memoised, or the tabulated ones (value 'tabulated'). The latter do not
+     * rely on repeated calls with identical quark masses, e.g. when sampling the quark masses.
+     */
+    class MassiveCharmLoops
+    {
+        private:
+            bool _tabulated;
+
+        public:
+            MassiveCharmLoops(const Options & options);
+
+            complex<double> F19(const double & mu, const double & s, const double & m_b, const double & m_c) const;
+            complex<double> F27(const double & mu, const double & s, const double & m_b, const double & m_c) const;
+            complex<double> F29(const double & mu, const double & s, const double & m_b, const double & m_c) const;
+    };
+
     struct ShortDistanceLowRecoil
     {
         /*!
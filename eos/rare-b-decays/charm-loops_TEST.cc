@@ -417,6 +417,31 @@ class FormFactorsTest :
                 TEST_CHECK_RELATIVE_ERROR(+ 4.0282600,  real(CharmLoops::F29_massive(mu, -1.0, m_b, m_c)), eps);
                 TEST_CHECK_RELATIVE_ERROR(- 0.6601020,  imag(CharmLoops::F29_massive(mu, -1.0, m_b, m_c)), eps);
             }
+
+            /* Formfactors, tabulated massive loops */
+            {
+                static const double mu = 4.2, m_b = 4.6, eps = 1e-9;
+
+                for (double m_c : { 0.9, 1.2, 1.27, 1.5, 1.9 })
+                {
+                    for (double s : { -8.0, -1.0, 0.5, 6.0, 9.0 })
+                    {
+                        TEST_CHECK_NEARLY_EQUAL(real(CharmLoops::F27_massive(mu, s, m_b, m_c)), real(CharmLoops::F27_massive_tabulated(mu, s, m_b, m_c)), eps);
+                        TEST_CHECK_NEARLY_EQUAL(imag(CharmLoops::F27_massive(mu, s, m_b, m_c)), imag(CharmLoops::F27_massive_tabulated(mu, s, m_b, m_c)), eps);
+                        TEST_CHECK_NEARLY_EQUAL(real(CharmLoops::F19_massive(mu, s, m_b, m_c)), real(CharmLoops::F19_massive_tabulated(mu, s, m_b, m_c)), eps);
+                        TEST_CHECK_NEARLY_EQUAL(imag(CharmLoops::F19_massive(mu, s, m_b, m_c)), imag(CharmLoops::F19_massive_tabulated(mu, s, m_b, m_c)), eps);
+                        TEST_CHECK_NEARLY_EQUAL(real(CharmLoops::F29_massive(mu, s, m_b, m_c)), real(CharmLoops::F29_massive_tabulated(mu, s, m_b, m_c)), eps);
+                        TEST_CHECK_NEARLY_EQUAL(imag(CharmLoops::F29_massive(mu, s, m_b, m_c)), imag(CharmLoops::F29_massive_tabulated(mu, s, m_b, m_c)), eps);
+                    }
+
+                    TEST_CHECK_NEARLY_EQUAL(real(CharmLoops::F27_massive(mu, 0.0, m_b, m_c)), real(CharmLoops::F27_massive_tabulated(mu, 0.0, m_b, m_c)), eps);
+                    TEST_CHECK_NEARLY_EQUAL(imag(CharmLoops::F27_massive(mu, 0.0, m_b, m_c)), imag(CharmLoops::F27_massive_tabulated(mu, 0.0, m_b, m_c)), eps);
+                }
+
+                // outside of the tabulated range
+                TEST_CHECK_EQUAL(real(CharmLoops::F27_massive(mu, 6.0, m_b, 0.4)), real(CharmLoops::F27_massive_tabulated(mu, 6.0, m_b, 0.4)));
+                TEST_CHECK_EQUAL(imag(CharmLoops::F27_massive(mu, 6.0, m_b, 0.4)), imag(CharmLoops::F27_massive_tabulated(mu, 6.0, m_b, 0.4)));
+            }
         }
 } two_loop_test;
 
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2012, 2013, 2014, 2015, 2016 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2020 Danny van Dyk
  * Copyright (c) 2011 Christian Wacker
  * Copyright (c) 2014 Frederik Beaujean
  * Copyright (c) 2014 Christoph Bobeth
@@ -30,9 +30,9 @@
 #include <eos/utils/destringify.hh>
 #include <eos/utils/integrate-impl.hh>
 #include <eos/utils/kinematic.hh>
-#include <eos/utils/memoise.hh>
 #include <eos/utils/model.hh>
 #include <eos/utils/options.hh>
+#include <eos/utils/parameter_cache.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qcd.hh>
@@ -40,6 +40,7 @@
 
 #include <cmath>
 #include <functional>
+#include <tuple>
 
 #include <gsl/gsl_sf.h>
 
@@ -120,6 +121,13 @@ namespace eos
 
         std::shared_ptr<FormFactors<PToV>> form_factors;
 
+        MassiveCharmLoops charm_loops;
+
+        DileptonQCDFIntegrals qcdf_integrals;
+
+        // integrated angular coefficients, keyed on the bin, the CP state, the spectator quark and the lepton flavour
+        ParameterCache<std::tuple<double, double, bool, char, std::string>, std::array<double, 12>> integrated_angular_coefficients_cache;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "WilsonScan"), p, o)),
             parameters(p),
@@ -149,7 +157,10 @@ namespace eos
             tau(p["life_time::B_" + o.get("q", "d")], u),
             e_q(-1.0/3.0),
             lepton_flavour(o.get("l", "mu")),
-            cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false")))
+            cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false"))),
+            charm_loops(o),
+            qcdf_integrals(o),
+            integrated_angular_coefficients_cache(p, u)
         {
             if (0.0 == m_l())
             {
@@ -164,6 +175,10 @@ namespace eos
             u.uses(*form_factors);
             u.uses(*model);
 
+            // the lepton-flavour ratios rebind m_l to these masses
+            u.uses(p["mass::e"].id());
+            u.uses(p["mass::mu"].id());
+
             std::string spectator_quark = o.get("q", "d");
             if (spectator_quark.size() != 1)
                 throw InternalError("Option q should only be one character!");
@@ -268,9 +283,9 @@ namespace eos
             // Compute the QCDF Integrals
             double invm1_par = 3.0 * (1.0 + a_1_par + a_2_par); // <ubar^-1>_par
             double invm1_perp = 3.0 * (1.0 + a_1_perp + a_2_perp); // <ubar^-1>_perp
-            QCDFIntegrals::Results qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
-            QCDFIntegrals::Results qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
-            QCDFIntegrals::Results qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            QCDFIntegrals::Results qcdf_0 = qcdf_integrals.massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            QCDFIntegrals::Results qcdf_c = qcdf_integrals.charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            QCDFIntegrals::Results qcdf_b = qcdf_integrals.bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
 
             // inverse of the "negative" moment of the B meson LCDA
             // cf. [BFS2001], Eq. (54), p. 15
@@ -308,10 +323,10 @@ namespace eos
             complex<double> C1f_top_perp_right = (c7eff + wc.c7prime()) * (8.0 * std::log(m_b_PS / mu()) - L - 4.0 * (1.0 - mu_f() / m_b_PS));
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             complex<double> C1nf_top_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * charm_loops.F27(mu(), s, m_b_PS, m_c_pole) + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
+                        wc.c1() * charm_loops.F19(mu(), s, m_b_PS, m_c_pole)
+                        + wc.c2() * charm_loops.F29(mu(), s, m_b_PS, m_c_pole)
                         + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
 
             /* perpendicular, up sector */
@@ -321,10 +336,10 @@ namespace eos
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
             complex<double> C1nf_up_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (charm_loops.F27(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (charm_loops.F19(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
+                        + wc.c2() * (charm_loops.F29(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
 
             /* parallel, top sector */
             // cf. [BFS2001], Eqs. (14), (15), p. 5, in comparison with \delta_{2,3} = 1
@@ -333,11 +348,11 @@ namespace eos
             complex<double> C1f_top_par = -1.0 * (c7eff - wc.c7prime()) * (8.0 * std::log(m_b_PS / mu) + 2.0 * L - 4.0 * (1.0 - mu_f() / m_b_PS));
             // cf. [BFS2001], Eqs. (38), p. 9
             complex<double> C1nf_top_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
+                    (wc.c2() - wc.c1() / 6.0) * charm_loops.F27(mu(), s, m_b_PS, m_c_pole)
                     + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
+                        wc.c1() * charm_loops.F19(mu(), s, m_b_PS, m_c_pole)
+                        + wc.c2() * charm_loops.F29(mu(), s, m_b_PS, m_c_pole)
                         + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
 
             /* parallel, up sector */
@@ -347,10 +362,10 @@ namespace eos
             // cf. [BFS2004], last paragraph in Sec A.1, p. 24
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
             complex<double> C1nf_up_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (charm_loops.F27(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (charm_loops.F19(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
+                        + wc.c2() * (charm_loops.F29(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
 
             // compute the factorizing contributions
             complex<double> C_perp_left  = C0_top_perp_left  + lambda_hat_u * C0_up_perp
@@ -492,9 +507,9 @@ namespace eos
                 lambda_hat_u = std::conj(lambda_hat_u);
 
             QCDFIntegrals::Results
-                qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
-                qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
-                qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+                qcdf_0 = qcdf_integrals.massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
+                qcdf_c = qcdf_integrals.charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
+                qcdf_b = qcdf_integrals.bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
 
             // inverse of the "negative" moment of the B meson LCDA
             // cf. [BFS2001], Eq. (54), p. 15
@@ -513,40 +528,40 @@ namespace eos
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             const complex<double>
                 C1nf_top_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
+                    (wc.c2() - wc.c1() / 6.0) * charm_loops.F27(mu(), s, m_b_PS, m_c_pole)
                     + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
+                        wc.c1() * charm_loops.F19(mu(), s, m_b_PS, m_c_pole)
+                        + wc.c2() * charm_loops.F29(mu(), s, m_b_PS, m_c_pole)
                         + c8eff * CharmLoops::F89_massless(s, m_b_PS))),
 
             /* perpendicular, up sector */
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
                 C1nf_up_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (charm_loops.F27(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS)))),
+                        wc.c1() * (charm_loops.F19(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
+                        + wc.c2() * (charm_loops.F29(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS)))),
 
             /* parallel, top sector */
             // cf. [BFS2001], Eqs. (38), p. 9
                 C1nf_top_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
+                    (wc.c2() - wc.c1() / 6.0) * charm_loops.F27(mu(), s, m_b_PS, m_c_pole)
                     + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
+                        wc.c1() * charm_loops.F19(mu(), s, m_b_PS, m_c_pole)
+                        + wc.c2() * charm_loops.F29(mu(), s, m_b_PS, m_c_pole)
                         + c8eff * CharmLoops::F89_massless(s, m_b_PS))),
 
             /* parallel, up sector */
             // cf. [BFS2004], last paragraph in Sec A.1, p. 24
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
                 C1nf_up_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (charm_loops.F27(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (charm_loops.F19(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
+                        + wc.c2() * (charm_loops.F29(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
 
             // compute the factorizing contributions
             // in ABBBSW2008: C0 is included in naively factorizing part and C1f = 0
@@ -729,6 +744,7 @@ namespace eos
                 sqrt_s = std::sqrt(s);
 
             DipoleFormFactors dff = calT_BFS2004(s, wc);
+            const FormFactors<PToV>::Values ff = form_factors->compute_all(s);
 
             const complex<double>
                 wilson_minus_right = (wc.c9() - wc.c9prime()) + (wc.c10() - wc.c10prime()),
@@ -770,17 +786,17 @@ namespace eos
             // timelike amplitude
             result.a_timelike = norm_s * sqrt_lam / sqrt_s
                 * (2.0 * (wc.c10() - wc.c10prime()) + s / m_l / (m_b_MSbar + m_s_MSbar) * (wc.cP() - wc.cPprime()))
-                * form_factors->a_0(s);
+                * ff.a_0;
 
             // scalar amplitude
-            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s_MSbar) * form_factors->a_0(s);
+            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s_MSbar) * ff.a_0;
 
             // tensor amplitudes [BHvD2012]  eqs. (B18 - B20)
             // no form factor relations used
             const double
-                ff_T1  = form_factors->t_1(s),
-                ff_T2  = form_factors->t_2(s),
-                ff_T3  = form_factors->t_3(s),
+                ff_T1  = ff.t_1,
+                ff_T2  = ff.t_2,
+                ff_T3  = ff.t_3,
 
                 kin_tensor_1 = norm_s / m_Kstar() * ((m_B2 + 3.0 * m_K2 - s) * ff_T2 - lam(s) / m2_diff * ff_T3),
                 kin_tensor_2 = 2.0 * norm_s * sqrt_lam / sqrt_s * ff_T1,
@@ -823,14 +839,15 @@ namespace eos
                 norm_s = this->norm(s),
                 sqrt_lam = std::sqrt(lam(s));
 
+            const FormFactors<PToV>::Values ff = form_factors->compute_all(s);
             const double
-                ff_V   = form_factors->v(s),
-                ff_A0  = form_factors->a_0(s),
-                ff_A1  = form_factors->a_1(s),
-                ff_A2  = form_factors->a_2(s),
-                ff_T1  = form_factors->t_1(s),
-                ff_T2  = form_factors->t_2(s),
-                ff_T3  = form_factors->t_3(s);
+                ff_V   = ff.v,
+                ff_A0  = ff.a_0,
+                ff_A1  = ff.a_1,
+                ff_A2  = ff.a_2,
+                ff_T1  = ff.t_1,
+                ff_T2  = ff.t_2,
+                ff_T3  = ff.t_3;
 
             const double
                 m_c_pole = model->m_c_pole(),
@@ -990,9 +1007,15 @@ namespace eos
 
         AngularCoefficients integrated_angular_coefficients(const double & s_min, const double & s_max) const
         {
-            std::function<std::array<double, 12> (const double &)> integrand =
-                    std::bind(&Implementation<BToKstarDilepton<LargeRecoil>>::differential_angular_coefficients_array, this, std::placeholders::_1);
-            std::array<double, 12> integrated_angular_coefficients_array = integrate1D(integrand, 64, s_min, s_max);
+            // all observables of one bin share the same integration
+            const auto key = std::make_tuple(s_min, s_max, cp_conjugate, q, lepton_flavour);
+            std::array<double, 12> integrated_angular_coefficients_array = integrated_angular_coefficients_cache(key, [&] ()
+            {
+                std::function<std::array<double, 12> (const double &)> integrand =
+                        std::bind(&Implementation<BToKstarDilepton<LargeRecoil>>::differential_angular_coefficients_array, this, std::placeholders::_1);
+
+                return integrate1D(integrand, 64, s_min, s_max);
+            });
 
             return array_to_angular_coefficients(integrated_angular_coefficients_array);
         }
@@ -1489,7 +1512,7 @@ namespace eos
     {
         double J4_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
 
             J4_electrons = differential_j_4(s);
@@ -1497,7 +1520,7 @@ namespace eos
 
         double J4_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
 
             J4_muons = differential_j_4(s);
@@ -1511,7 +1534,7 @@ namespace eos
     {
         double J5_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
 
             J5_electrons = differential_j_5(s);
@@ -1519,7 +1542,7 @@ namespace eos
 
         double J5_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
 
             J5_muons = differential_j_5(s);
@@ -1533,7 +1556,7 @@ namespace eos
     {
         double J6s_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
 
             J6s_electrons = differential_j_6s(s);
@@ -1541,7 +1564,7 @@ namespace eos
 
         double J6s_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
 
             J6s_muons = differential_j_6s(s);
@@ -1555,7 +1578,7 @@ namespace eos
     {
         double gamma_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
 
             gamma_electrons = differential_decay_width(s);
@@ -1563,7 +1586,7 @@ namespace eos
 
         double gamma_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
 
             gamma_muons = differential_decay_width(s);
@@ -2020,7 +2043,7 @@ namespace eos
     {
         double J4_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
 
             J4_electrons = integrated_j_4(s_min, s_max);
@@ -2028,7 +2051,7 @@ namespace eos
 
         double J4_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
 
             J4_muons = integrated_j_4(s_min, s_max);
@@ -2042,7 +2065,7 @@ namespace eos
     {
         double J5_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
 
             J5_electrons = integrated_j_5(s_min, s_max);
@@ -2050,7 +2073,7 @@ namespace eos
 
         double J5_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
 
             J5_muons = integrated_j_5(s_min, s_max);
@@ -2064,7 +2087,7 @@ namespace eos
     {
         double J6s_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
 
             J6s_electrons = integrated_j_6s(s_min, s_max);
@@ -2072,7 +2095,7 @@ namespace eos
 
         double J6s_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
 
             J6s_muons = integrated_j_6s(s_min, s_max);
@@ -2089,14 +2112,14 @@ namespace eos
 
         double br_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
             br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
 
         double br_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
             br_muons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
@@ -2227,6 +2250,10 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
 
         std::shared_ptr<FormFactors<PToP>> form_factors;
 
+        MassiveCharmLoops charm_loops;
+
+        DileptonQCDFIntegrals qcdf_integrals;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             parameters(p),
             model(Model::make(o.get("model", "SM"), p, o)),
@@ -2250,7 +2277,9 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
             sl_phase_psd(p["B->Pll::sl_phase_pseudo@LargeRecoil"], u),
             e_q(-1.0/3.0),
             lepton_flavour(o.get("l", "mu")),
-            cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false")))
+            cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false"))),
+            charm_loops(o),
+            qcdf_integrals(o)
         {
             form_factors = FormFactorFactory<PToP>::create("B->K::" + o.get("form-factors", "KMPW2010"), p, o);
 
@@ -2260,6 +2289,10 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
             u.uses(*form_factors);
             u.uses(*model);
 
+            // the lepton-flavour ratios rebind m_l to these masses
+            u.uses(p["mass::e"].id());
+            u.uses(p["mass::mu"].id());
+
             std::string spectator_quark = o.get("q", "d");
             if (spectator_quark.size() != 1)
                 throw InternalError("Option q should only be one character!");
@@ -2309,9 +2342,9 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
 
             // Compute the QCDF Integrals
             double invm1_psd = 3.0 * (1.0 + a_1 + a_2); // <ubar^-1>
-            QCDFIntegrals::Results qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
-            QCDFIntegrals::Results qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
-            QCDFIntegrals::Results qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
+            QCDFIntegrals::Results qcdf_0 = qcdf_integrals.massless_case(s, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
+            QCDFIntegrals::Results qcdf_c = qcdf_integrals.charm_case(s, m_c_pole, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
+            QCDFIntegrals::Results qcdf_b = qcdf_integrals.bottom_case(s, m_b_PS, m_B, m_K, mu, 0.0, 0.0, a_1, a_2);
 
             // inverse of the "negative" moment of the B meson LCDA
             // cf. [BFS2001], Eq. (54), p. 15
@@ -2349,11 +2382,11 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
             complex<double> C1f_top_psd = 1.0 * (c7eff + wc.c7prime()) * (8.0 * std::log(m_b_PS / mu) + 2.0 * L - 4.0 * (1.0 - mu_f() / m_b_PS));
             // cf. [BHP2007], Eq. (B.2) and [BFS2001], Eqs. (38), p. 9
             complex<double> C1nf_top_psd = -(+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
+                    (wc.c2() - wc.c1() / 6.0) * charm_loops.F27(mu(), s, m_b_PS, m_c_pole)
                     + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
+                        wc.c1() * charm_loops.F19(mu(), s, m_b_PS, m_c_pole)
+                        + wc.c2() * charm_loops.F29(mu(), s, m_b_PS, m_c_pole)
                         + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
 
             /* parallel, up sector */
@@ -2365,10 +2398,10 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
             // Use here FF_massive - FF_massless because FF_massless is defined with an extra '-'
             // compared to [S2004]
             complex<double> C1nf_up_psd = -(+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (charm_loops.F27(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (charm_loops.F19(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
+                        + wc.c2() * (charm_loops.F29(mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
 
             // compute the factorizing contributions
             complex<double> C_psd = C0_top_psd + lambda_hat_u * C0_up_psd
@@ -2681,14 +2714,14 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
     {
         double br_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
             br_electrons = BToKDilepton<LargeRecoil>::differential_branching_ratio(s);
         }
 
         double br_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
             br_muons = BToKDilepton<LargeRecoil>::differential_branching_ratio(s);
         }
@@ -2820,7 +2853,7 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
 
         double br_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
             // br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
             br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
@@ -2828,7 +2861,7 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
 
         double br_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
             br_muons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
@@ -23,6 +23,7 @@
 #include <eos/observable.hh>
 #include <eos/rare-b-decays/exclusive-b-to-s-dilepton-large-recoil.hh>
 #include <eos/utils/complex.hh>
+#include <eos/utils/observable_cache.hh>
 #include <eos/utils/wilson-polynomial.hh>
 
 #include <array>
@@ -177,6 +178,72 @@ class BToKstarDileptonLargeRecoilBobethCompatibilityTest :
             TEST_CHECK_RELATIVE_ERROR_C(d.a_t_par(s),     complex<double>(-3.24769e-11, -4.87154e-11), eps);
             TEST_CHECK_RELATIVE_ERROR_C(d.a_long_par(s),  complex<double>( 2.92292e-11, 4.54677e-11), eps);
        }
+
+       // integrated observables of one bin share the integrated angular coefficients
+       {
+            Parameters p = Parameters::Defaults();
+
+            Options oo;
+            oo.set("model", "WilsonScan");
+            oo.set("form-factors", "KMPW2010");
+            oo.set("l", "mu");
+            oo.set("q", "d");
+
+            Options oo_bar;
+            oo_bar.set("model", "WilsonScan");
+            oo_bar.set("form-factors", "KMPW2010");
+            oo_bar.set("l", "mu");
+            oo_bar.set("q", "d");
+            oo_bar.set("cp-conjugate", "true");
+
+            BToKstarDilepton<LargeRecoil> d(p, oo);
+            BToKstarDilepton<LargeRecoil> d_bar(p, oo_bar);
+
+            const double br = d.integrated_branching_ratio(1.0, 6.0);
+            TEST_CHECK_EQUAL(br, d.integrated_branching_ratio(1.0, 6.0));
+
+            // the CP conjugated coefficients are kept apart
+            TEST_CHECK_RELATIVE_ERROR(0.5 * (br + d_bar.integrated_branching_ratio(1.0, 6.0)), d.integrated_branching_ratio_cp_averaged(1.0, 6.0), 1e-12);
+
+            // changing a parameter invalidates the cached coefficients
+            p["Re{c9}"] = p["Re{c9}"]() + 1.0;
+
+            BToKstarDilepton<LargeRecoil> d_new(p, oo);
+            TEST_CHECK(br != d.integrated_branching_ratio(1.0, 6.0));
+            TEST_CHECK_RELATIVE_ERROR(d_new.integrated_branching_ratio(1.0, 6.0), d.integrated_branching_ratio(1.0, 6.0), 1e-12);
+            TEST_CHECK_RELATIVE_ERROR(d_new.integrated_longitudinal_polarisation(1.0, 6.0), d.integrated_longitudinal_polarisation(1.0, 6.0), 1e-12);
+       }
+
+       // the lepton-flavour ratios follow changes of the electron mass, with muons as the default lepton
+       {
+            Parameters p = Parameters::Defaults();
+            Kinematics k{ { "q2_min", 1.0 }, { "q2_max", 6.0 } };
+
+            Options oo;
+            oo.set("model", "WilsonScan");
+            oo.set("form-factors", "KMPW2010");
+            oo.set("l", "mu");
+            oo.set("q", "d");
+
+            BToKstarDilepton<LargeRecoil> d(p, oo);
+            const double d_4 = d.integrated_d_4(1.0, 6.0);
+
+            ObservableCache cache(p);
+            cache.set_incremental(true);
+            ObservableCache::Id id = cache.add(Observable::make("B->K^*ll::R_K^*@LargeRecoil", p, k, oo));
+
+            cache.update();
+            const double r_kstar = cache[id];
+
+            p["mass::e"] = 0.1;
+            cache.update();
+
+            BToKstarDilepton<LargeRecoil> d_new(p, oo);
+            TEST_CHECK(std::abs(d.integrated_d_4(1.0, 6.0) - d_4) > 1e-6 * std::abs(d_4));
+            TEST_CHECK_RELATIVE_ERROR(d_new.integrated_d_4(1.0, 6.0), d.integrated_d_4(1.0, 6.0), 1e-12);
+            TEST_CHECK(std::abs(cache[id] - r_kstar) > 1e-6);
+            TEST_CHECK_RELATIVE_ERROR(Observable::make("B->K^*ll::R_K^*@LargeRecoil", p, k, oo)->evaluate(), cache[id], 1e-12);
+       }
     }
 } b_to_kstar_dilepton_large_recoil_bobeth_compatibility_test;
 
@@ -33,6 +33,7 @@
 #include <eos/utils/memoise.hh>
 #include <eos/utils/model.hh>
 #include <eos/utils/options.hh>
+#include <eos/utils/parameter_cache.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qcd.hh>
@@ -40,6 +41,7 @@
 
 #include <cmath>
 #include <functional>
+#include <tuple>
 
 namespace eos
 {
@@ -98,6 +100,9 @@ namespace eos
 
         bool use_nlo;
 
+        // integrated angular coefficients, keyed on the bin and the CP state
+        ParameterCache<std::tuple<double, double, bool>, std::array<double, 12>> integrated_angular_coefficients_cache;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "SM"), p, o)),
             hbar(p["hbar"], u),
@@ -120,7 +125,8 @@ namespace eos
             lepton_flavour(o.get("l", "mu")),
             cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false"))),
             ccbar_resonance(destringify<bool>(o.get("ccbar-resonance", "false"))),
-            use_nlo(destringify<bool>(o.get("nlo", "true")))
+            use_nlo(destringify<bool>(o.get("nlo", "true"))),
+            integrated_angular_coefficients_cache(p, u)
         {
             form_factors = FormFactorFactory<PToV>::create(QualifiedName("B->K^*::" + o.get("form-factors", "KMPW2010")), p, o);
 
@@ -231,7 +237,8 @@ namespace eos
             const double m_Kstarhat = m_Kstar / m_B;
             const double m_Kstarhat2 = std::pow(m_Kstarhat, 2);
             const double s_hat = s / m_B / m_B;
-            const double a_1 = form_factors->a_1(s), a_2 = form_factors->a_2(s);
+            const FormFactors<PToV>::Values ff = form_factors->compute_all(s);
+            const double a_1 = ff.a_1, a_2 = ff.a_2;
             const double alpha_s = model->alpha_s(mu());
             const double norm_s = this->norm(s);
             const double lam = lambda(m_B2, m_Kstar2, s);
@@ -270,7 +277,7 @@ namespace eos
             complex<double> wilson_perp_right = c910_plus_right + c7_plus * (m_b_MSbar() + m_s() + lambda_perp()) - subleading_perp;
             complex<double> wilson_perp_left  = c910_plus_left  + c7_plus * (m_b_MSbar() + m_s() + lambda_perp()) - subleading_perp;
 
-            double formfactor_perp = std::sqrt(2.0 * lambda(1.0, m_Kstarhat2, s_hat)) / (1.0 + m_Kstarhat) * form_factors->v(s);
+            double formfactor_perp = std::sqrt(2.0 * lambda(1.0, m_Kstarhat2, s_hat)) / (1.0 + m_Kstarhat) * ff.v;
             // cf. [BHvD2010], Eq. (3.13), p. 10
             result.a_perp_right = norm_s * prefactor_perp * wilson_perp_right * formfactor_perp;
             result.a_perp_left  = norm_s * prefactor_perp * wilson_perp_left  * formfactor_perp;
@@ -287,16 +294,16 @@ namespace eos
             // timelike
             result.a_timelike = norm_s * sqrt_lam / sqrt_s
                 * (2.0 * (wc.c10() - wc.c10prime()) + s / m_l / (m_b_MSbar + m_s()) * (wc.cP() - wc.cPprime()))
-                * form_factors->a_0(s);
+                * ff.a_0;
 
             // scalar amplitude
-            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s()) * form_factors->a_0(s);
+            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s()) * ff.a_0;
 
             // tensor amplitudes [BHvD2012]  eqs. (B18 - B20)
             // no form factor relations used
-            const double ff_T1  = form_factors->t_1(s);
-            const double ff_T2  = form_factors->t_2(s);
-            const double ff_T3  = form_factors->t_3(s);
+            const double ff_T1  = ff.t_1;
+            const double ff_T2  = ff.t_2;
+            const double ff_T3  = ff.t_3;
 
             const double kin_tensor_1 = norm_s / m_Kstar * ((m_B2 + 3.0 * m_Kstar2 - s) * ff_T2 - lam / m2_diff * ff_T3);
             const double kin_tensor_2 = 2.0 * norm_s * sqrt_lam / sqrt_s * ff_T1;
@@ -330,9 +337,14 @@ namespace eos
 
         AngularCoefficients integrated_angular_coefficients(const double & s_min, const double & s_max) const
         {
-            std::function<std::array<double, 12> (const double &)> integrand =
-                    std::bind(&Implementation<BToKstarDilepton<LowRecoil>>::differential_angular_coefficients_array, this, std::placeholders::_1);
-            std::array<double, 12> integrated_angular_coefficients_array = integrate1D(integrand, 64, s_min, s_max);
+            // all observables of one bin share the same integration
+            std::array<double, 12> integrated_angular_coefficients_array = integrated_angular_coefficients_cache(std::make_tuple(s_min, s_max, cp_conjugate), [&] ()
+            {
+                std::function<std::array<double, 12> (const double &)> integrand =
+                        std::bind(&Implementation<BToKstarDilepton<LowRecoil>>::differential_angular_coefficients_array, this, std::placeholders::_1);
+
+                return integrate1D(integrand, 64, s_min, s_max);
+            });
 
             return array_to_angular_coefficients(integrated_angular_coefficients_array);
         }
@@ -1583,6 +1595,10 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
 
             u.uses(*form_factors);
             u.uses(*model);
+
+            // the lepton-flavour ratios rebind m_l to these masses
+            u.uses(p["mass::e"].id());
+            u.uses(p["mass::mu"].id());
         }
 
         WilsonCoefficients<BToS> wilson_coefficients() const
@@ -1909,13 +1925,13 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
     {
         double br_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             br_electrons = BToKDilepton<LowRecoil>::differential_branching_ratio(s);
         }
 
         double br_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             br_muons = BToKDilepton<LowRecoil>::differential_branching_ratio(s);
         }
 
@@ -2031,13 +2047,13 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
 
         double br_electrons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::e"]);
             br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
 
         double br_muons;
         {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
+            Save<Parameter> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]);
             br_muons = integrate<GSL::QNG>(integrand, s_min, s_max);
         }
 
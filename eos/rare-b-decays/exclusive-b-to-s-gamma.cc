@@ -24,7 +24,6 @@
 #include <eos/rare-b-decays/qcdf_integrals.hh>
 #include <eos/utils/destringify.hh>
 #include <eos/utils/integrate.hh>
-#include <eos/utils/memoise.hh>
 #include <eos/utils/model.hh>
 #include <eos/utils/options.hh>
 #include <eos/utils/power_of.hh>
@@ -85,6 +84,8 @@ namespace eos
 
         std::shared_ptr<FormFactors<PToV>> form_factors;
 
+        MassiveCharmLoops charm_loops;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "SM"), p, o)),
             hbar(p["hbar"], u),
@@ -105,7 +106,8 @@ namespace eos
             g_fermi(p["G_Fermi"], u),
             tau(p["life_time::B_" + o.get("q", "d")], u),
             cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false"))),
-            form_factors(FormFactorFactory<PToV>::create(QualifiedName("B->K^*::" + o.get("form-factors", "KMPW2010")), p, o))
+            form_factors(FormFactorFactory<PToV>::create(QualifiedName("B->K^*::" + o.get("form-factors", "KMPW2010")), p, o)),
+            charm_loops(o)
         {
             u.uses(*model);
             u.uses(*form_factors);
@@ -205,7 +207,7 @@ namespace eos
             complex<double> C1f_top_perp_right = wc.c7prime() * (8.0 * std::log(m_b_PS / mu()) - L - 4.0 * (1.0 - mu_f() / m_b_PS));
             // cf. [BFS2001], Eqs. (34), (37), p. 9, s -> 0
             complex<double> C1nf_top_perp_left = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), 0.0, m_b_PS, m_c_pole) + c8eff * CharmLoops::F87_massless(mu, 0.0, m_b_PS));
+                    (wc.c2() - wc.c1() / 6.0) * charm_loops.F27(mu(), 0.0, m_b_PS, m_c_pole) + c8eff * CharmLoops::F87_massless(mu, 0.0, m_b_PS));
             const complex<double> C1nf_top_perp_right = 0.0;
 
             /* perpendicular, up sector */
@@ -216,7 +218,7 @@ namespace eos
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
             complex<double> C1nf_up_perp_left = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), 0.0, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, 0.0, m_b_PS)));
+                    (wc.c2() - wc.c1() / 6.0) * (charm_loops.F27(mu(), 0.0, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, 0.0, m_b_PS)));
             const complex<double> C1nf_up_perp_right = 0.0;
 
             // compute the factorizing contributions
@@ -76,6 +76,8 @@ namespace eos
 
         UsedParameter alpha_e;
 
+        MassiveCharmLoops charm_loops;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "SM"), p, o)),
             gfermi(p["G_Fermi"], u),
@@ -89,7 +91,8 @@ namespace eos
             mu2_g(p["B->B::mu_G^2@1GeV"], u),
             mu2_pi(p["B->B::mu_pi^2@1GeV"], u),
             mu(p["mu"], u),
-            alpha_e(p["QED::alpha_e(m_b)"], u)
+            alpha_e(p["QED::alpha_e(m_b)"], u),
+            charm_loops(o)
         {
             u.uses(*model);
         }
@@ -357,7 +360,7 @@ namespace eos
             /* Corrections, cf. [HLMW2005], Table 6, p. 18 */
             std::vector<complex<double>> m7 = {
                 -pow(alpha_s_tilde, 2) * kappa * memoise(CharmLoops::F17_massive, mu(), s, m_b_msbar, m_c),
-                -pow(alpha_s_tilde, 2) * kappa * memoise(CharmLoops::F27_massive, mu(), s, m_b_msbar, m_c),
+                -pow(alpha_s_tilde, 2) * kappa * charm_loops.F27(mu(), s, m_b_msbar, m_c),
                 0.0,
                 0.0,
                 0.0,
@@ -373,8 +376,8 @@ namespace eos
             };
 
             std::vector<complex<double>> m9 = {
-                alpha_s_tilde * kappa * f(1, s_hat) - pow(alpha_s_tilde, 2) * kappa * memoise(CharmLoops::F19_massive, mu(), s, m_b_msbar, m_c),
-                alpha_s_tilde * kappa * f(2, s_hat) - pow(alpha_s_tilde, 2) * kappa * memoise(CharmLoops::F29_massive, mu(), s, m_b_msbar, m_c),
+                alpha_s_tilde * kappa * f(1, s_hat) - pow(alpha_s_tilde, 2) * kappa * charm_loops.F19(mu(), s, m_b_msbar, m_c),
+                alpha_s_tilde * kappa * f(2, s_hat) - pow(alpha_s_tilde, 2) * kappa * charm_loops.F29(mu(), s, m_b_msbar, m_c),
                 alpha_s_tilde * kappa * f(3, s_hat),
                 alpha_s_tilde * kappa * f(4, s_hat),
                 alpha_s_tilde * kappa * f(5, s_hat),
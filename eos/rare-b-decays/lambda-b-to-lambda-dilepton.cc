@@ -29,6 +29,7 @@
 #include <eos/utils/memoise.hh>
 #include <eos/utils/model.hh>
 #include <eos/utils/options.hh>
+#include <eos/utils/parameter_cache.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 
@@ -322,6 +323,10 @@ namespace eos
 
         std::shared_ptr<FormFactors<OneHalfPlusToOneHalfPlus>> form_factors;
 
+        MassiveCharmLoops charm_loops;
+
+        ParameterCache<std::pair<double, double>, std::array<double, 34>> integrated_angular_observables_cache;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "SM"), p, o)),
             hbar(p["hbar"], u),
@@ -332,7 +337,9 @@ namespace eos
             alpha(p["Lambda::alpha"], u),
             polarisation(p["Lambda_b::polarisation@" + o.get("production-polarisation","unpolarised") ], u),
             alpha_e(p["QED::alpha_e(m_b)"], u),
-            mu(p["mu"], u)
+            mu(p["mu"], u),
+            charm_loops(o),
+            integrated_angular_observables_cache(p, u)
         {
             form_factors = FormFactorFactory<OneHalfPlusToOneHalfPlus>::create("Lambda_b->Lambda::" + o.get("form-factors", "BFvD2014"), p, o);
 
@@ -393,10 +400,10 @@ namespace eos
 
             // two loop virtual corrections, cf. [AAGW2001]
             // charm quarks
-            complex<double> F27c = CharmLoops::F27_massive(mu(), s, m_b_PS, m_c_pole);
+            complex<double> F27c = charm_loops.F27(mu(), s, m_b_PS, m_c_pole);
             complex<double> F17c = -F27c / 6.0;
-            complex<double> F19c = CharmLoops::F19_massive(mu(), s, m_b_PS, m_c_pole);
-            complex<double> F29c = CharmLoops::F29_massive(mu(), s, m_b_PS, m_c_pole);
+            complex<double> F19c = charm_loops.F19(mu(), s, m_b_PS, m_c_pole);
+            complex<double> F29c = charm_loops.F29(mu(), s, m_b_PS, m_c_pole);
             // up quarks
             complex<double> F27u = CharmLoops::F27_massless(mu(), s, m_b_PS);
             complex<double> F17u = -F27u / 6.0;
@@ -486,9 +493,13 @@ namespace eos
 
         std::array<double, 34> _integrated_angular_observables(const double & s_min, const double & s_max)
         {
-            std::function<std::array<double, 34> (const double &)> integrand(std::bind(&Implementation::_differential_angular_observables, this, std::placeholders::_1));
+            // all observables of one bin share the same integration
+            return integrated_angular_observables_cache(std::make_pair(s_min, s_max), [&] ()
+            {
+                std::function<std::array<double, 34> (const double &)> integrand(std::bind(&Implementation::_differential_angular_observables, this, std::placeholders::_1));
 
-            return integrate1D(integrand, 64, s_min, s_max);
+                return integrate1D(integrand, 64, s_min, s_max);
+            });
         }
 
         inline lambdab_to_lambda_dilepton::AngularObservables differential_angular_observables(const double & s)
@@ -836,6 +847,8 @@ namespace eos
 
         std::shared_ptr<FormFactors<OneHalfPlusToOneHalfPlus>> form_factors;
 
+        ParameterCache<std::pair<double, double>, std::array<double, 34>> integrated_angular_observables_cache;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "SM"), p, o)),
             hbar(p["hbar"], u),
@@ -850,7 +863,8 @@ namespace eos
             r_perp_0(p["Lambda_b->Lambdall::r_perp_0@MvD2016"], u),
             r_perp_1(p["Lambda_b->Lambdall::r_perp_1@MvD2016"], u),
             r_para_0(p["Lambda_b->Lambdall::r_para_0@MvD2016"], u),
-            r_para_1(p["Lambda_b->Lambdall::r_para_1@MvD2016"], u)
+            r_para_1(p["Lambda_b->Lambdall::r_para_1@MvD2016"], u),
+            integrated_angular_observables_cache(p, u)
         {
             form_factors = FormFactorFactory<OneHalfPlusToOneHalfPlus>::create("Lambda_b->Lambda::" + o.get("form-factors", "DM2016"), p, o);
 
@@ -929,9 +943,13 @@ namespace eos
 
         std::array<double, 34> _integrated_angular_observables(const double & s_min, const double & s_max)
         {
-            std::function<std::array<double, 34> (const double &)> integrand(std::bind(&Implementation::_differential_angular_observables, this, std::placeholders::_1));
+            // all observables of one bin share the same integration
+            return integrated_angular_observables_cache(std::make_pair(s_min, s_max), [&] ()
+            {
+                std::function<std::array<double, 34> (const double &)> integrand(std::bind(&Implementation::_differential_angular_observables, this, std::placeholders::_1));
 
-            return integrate1D(integrand, 64, s_min, s_max);
+                return integrate1D(integrand, 64, s_min, s_max);
+            });
         }
 
         inline lambdab_to_lambda_dilepton::AngularObservables differential_angular_observables(const double & s)
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011, 2012 Danny van Dyk
+ * Copyright (c) 2011, 2012, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -19,12 +19,22 @@
 
 #include <eos/rare-b-decays/qcdf_integrals.hh>
 #include <eos/utils/exception.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/polylog.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/stringify.hh>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 #include <iostream>
 
@@ -2118,4 +2128,434 @@ namespace eos
 
         return results;
     }
+
+    namespace impl
+    {
+        /*
+         * Piecewise Chebyshev interpolation in s of the QCDF integrals J1 through J6 for one
+         * set of quark mass, B mass and scale.
+         *
+         * Each integral is decomposed into basis functions that multiply 1, a_1 and a_2 of the
+         * relevant Gegenbauer moments. These are interpolated in the variable
+         *
+         *   t = ln(1 - sqrt(1 - s / (4 m_q^2))),
+         *
+         * which is regular both for s -> 0 and at the quark-antiquark threshold, or in t = ln(s)
+         * for massless quarks. Starting from a uniform partition in t, each interval is bisected
+         * until the Chebyshev coefficients of highest order fall below the relative tolerance.
+         * Intervals that still miss the tolerance at the largest depth are marked as unfitted;
+         * within these, the exact integrals are used instead.
+         */
+        class DileptonQCDFIntegralsTable
+        {
+            public:
+                enum Case { massless, charm, bottom };
+
+                // order of the Chebyshev interpolation within each interval
+                static const unsigned order = 10;
+
+                // J1_perp, J2_perp, J4_perp, J5_perp, J6_perp, J1_par, J3_par, J4_par, times the basis 1, a_1, a_2
+                static const unsigned functions = 8 * 3;
+
+                typedef std::array<complex<double>, functions> Values;
+
+            private:
+                Case _case;
+
+                double _m_q, _m_B, _mu;
+
+                double _s_min, _s_max;
+
+                // boundaries of the intervals in t
+                std::vector<double> _boundaries;
+
+                // Chebyshev coefficients, ordered by interval, function and order
+                std::vector<complex<double>> _coefficients;
+
+                // whether the interpolation within each interval meets the tolerance
+                std::vector<bool> _fitted;
+
+                double variable(const double & s) const
+                {
+                    if (massless == _case)
+                        return std::log(s);
+
+                    return std::log(1.0 - std::sqrt(1.0 - s / (4.0 * _m_q * _m_q)));
+                }
+
+                double inverse(const double & t) const
+                {
+                    if (massless == _case)
+                        return std::exp(t);
+
+                    const double u = 1.0 - std::exp(t);
+
+                    return 4.0 * _m_q * _m_q * (1.0 - u * u);
+                }
+
+                Values exact(const double & s) const
+                {
+                    Values result;
+
+                    std::array<QCDFIntegrals::Results, 3> r;
+                    for (unsigned i = 0 ; i < 3 ; ++i)
+                    {
+                        // the basis points (a_1, a_2) = (0, 0), (1, 0) and (0, 1), for both polarisations
+                        const double a_1 = (1 == i ? 1.0 : 0.0), a_2 = (2 == i ? 1.0 : 0.0);
+
+                        switch (_case)
+                        {
+                            case massless:
+                                r[i] = QCDFIntegrals::dilepton_massless_case(s, _m_B, 0.0, _mu, a_1, a_2, a_1, a_2);
+                                break;
+
+                            case charm:
+                                r[i] = QCDFIntegrals::dilepton_charm_case(s, _m_q, _m_B, 0.0, _mu, a_1, a_2, a_1, a_2);
+                                break;
+
+                            case bottom:
+                                r[i] = QCDFIntegrals::dilepton_bottom_case(s, _m_q, _m_B, 0.0, _mu, a_1, a_2, a_1, a_2);
+                                break;
+                        }
+                    }
+
+                    for (unsigned i = 0 ; i < 3 ; ++i)
+                    {
+                        const std::array<complex<double>, 8> integrals
+                        {{
+                            r[i].j1_perp, r[i].j2_perp, r[i].j4_perp, r[i].j5_perp, r[i].j6_perp,
+                            r[i].j1_parallel, r[i].j3_parallel, r[i].j4_parallel
+                        }};
+
+                        for (unsigned j = 0 ; j < 8 ; ++j)
+                        {
+                            result[3 * j + i] = (0 == i) ? integrals[j] : integrals[j] - result[3 * j];
+                        }
+                    }
+
+                    return result;
+                }
+
+                // determine the Chebyshev coefficients on [t_a, t_b], and return whether they meet the tolerance
+                bool fit(const double & t_a, const double & t_b, std::vector<complex<double>> & coefficients) const
+                {
+                    static const double tolerance = 1.0e-10;
+
+                    std::array<Values, order> values;
+                    for (unsigned k = 0 ; k < order ; ++k)
+                    {
+                        const double x = std::cos(M_PI * (k + 0.5) / order);
+                        values[k] = exact(inverse(0.5 * (t_a + t_b) + 0.5 * (t_b - t_a) * x));
+                    }
+
+                    coefficients.assign(functions * order, complex<double>(0.0, 0.0));
+                    bool result = true;
+                    for (unsigned f = 0 ; f < functions ; ++f)
+                    {
+                        // compare the truncation against the largest basis function of the same integral
+                        double scale = 0.0;
+                        for (unsigned k = 0 ; k < order ; ++k)
+                        {
+                            for (unsigned b = 3 * (f / 3) ; b < 3 * (f / 3) + 3 ; ++b)
+                            {
+                                scale = std::max(scale, std::abs(values[k][b]));
+                            }
+                        }
+
+                        for (unsigned j = 0 ; j < order ; ++j)
+                        {
+                            complex<double> sum(0.0, 0.0);
+                            for (unsigned k = 0 ; k < order ; ++k)
+                            {
+                                sum += values[k][f] * std::cos(M_PI * j * (k + 0.5) / order);
+                            }
+
+                            coefficients[f * order + j] = sum * ((0 == j ? 1.0 : 2.0) / order);
+                        }
+
+                        if (std::abs(coefficients[f * order + order - 1]) + std::abs(coefficients[f * order + order - 2]) > tolerance * scale)
+                            result = false;
+                    }
+
+                    return result;
+                }
+
+            public:
+                DileptonQCDFIntegralsTable(const Case & c, const double & m_q, const double & m_B, const double & mu) :
+                    _case(c),
+                    _m_q(m_q),
+                    _m_B(m_B),
+                    _mu(mu),
+                    _s_min(0.01),
+                    _s_max(10.0)
+                {
+                    static const unsigned initial_intervals = 8;
+                    static const unsigned maximal_depth = 6;
+
+                    if ((massless != _case) && (_s_max > 4.0 * m_q * m_q))
+                        _s_max = 4.0 * m_q * m_q;
+
+                    const double t_min = variable(_s_min), t_max = variable(_s_max);
+                    const double width = (t_max - t_min) / initial_intervals;
+
+                    // work from left to right through the intervals that remain to be fitted
+                    std::vector<std::pair<double, unsigned>> pending;
+                    for (unsigned i = initial_intervals ; i > 0 ; --i)
+                    {
+                        pending.push_back(std::make_pair(t_min + (i - 1) * width, 0u));
+                    }
+
+                    _boundaries.push_back(t_min);
+                    std::vector<complex<double>> coefficients;
+                    while (! pending.empty())
+                    {
+                        const double t_a = pending.back().first;
+                        const unsigned depth = pending.back().second;
+                        const double t_b = t_a + width / (1u << depth);
+                        pending.pop_back();
+
+                        const bool fitted = fit(t_a, t_b, coefficients);
+                        if (fitted || (depth == maximal_depth))
+                        {
+                            _boundaries.push_back(t_b);
+                            _coefficients.insert(_coefficients.end(), coefficients.cbegin(), coefficients.cend());
+                            _fitted.push_back(fitted);
+                            continue;
+                        }
+
+                        pending.push_back(std::make_pair(0.5 * (t_a + t_b), depth + 1));
+                        pending.push_back(std::make_pair(t_a, depth + 1));
+                    }
+                }
+
+                // the number of intervals in which the exact integrals are used
+                unsigned unfitted_intervals() const
+                {
+                    return std::count(_fitted.cbegin(), _fitted.cend(), false);
+                }
+
+                // return false if s lies outside the tabulated range, or within an unfitted interval
+                bool evaluate(const double & s, Values & result) const
+                {
+                    if ((s < _s_min) || (s > _s_max) || (_boundaries.size() < 2))
+                        return false;
+
+                    const double t = variable(s);
+                    const unsigned i = std::upper_bound(_boundaries.cbegin() + 1, _boundaries.cend() - 1, t) - (_boundaries.cbegin() + 1);
+                    if (! _fitted[i])
+                        return false;
+
+                    const double t_a = _boundaries[i], t_b = _boundaries[i + 1];
+                    const double x = std::min(1.0, std::max(-1.0, (2.0 * t - t_a - t_b) / (t_b - t_a)));
+
+                    std::array<double, order> chebyshev;
+                    chebyshev[0] = 1.0;
+                    chebyshev[1] = x;
+                    for (unsigned j = 2 ; j < order ; ++j)
+                    {
+                        chebyshev[j] = 2.0 * x * chebyshev[j - 1] - chebyshev[j - 2];
+                    }
+
+                    const complex<double> * c = _coefficients.data() + i * functions * order;
+                    for (unsigned f = 0 ; f < functions ; ++f, c += order)
+                    {
+                        complex<double> sum(0.0, 0.0);
+                        for (unsigned j = 0 ; j < order ; ++j)
+                        {
+                            sum += c[j] * chebyshev[j];
+                        }
+
+                        result[f] = sum;
+                    }
+
+                    return true;
+                }
+        };
+    }
+
+    template <>
+    struct Implementation<DileptonQCDFIntegrals>
+    {
+        typedef impl::DileptonQCDFIntegralsTable Table;
+
+        typedef std::tuple<Table::Case, double, double, double> Key;
+
+        bool tabulated;
+
+        struct Entry
+        {
+            std::shared_ptr<const Table> table;
+
+            // value of the use counter at the last lookup of this table
+            unsigned long last_use;
+        };
+
+        Mutex mutex;
+
+        // the tables for the recently used sets of quark mass, B mass and scale
+        std::map<Key, Entry> tables;
+
+        unsigned long uses = 0;
+
+        Implementation(const Options & o) :
+            tabulated(false)
+        {
+            const std::string qcdf_integrals = o.get("qcdf-integrals", "exact");
+            if ("tabulated" == qcdf_integrals)
+            {
+                tabulated = true;
+            }
+            else if ("exact" != qcdf_integrals)
+            {
+                throw InvalidOptionValueError("qcdf-integrals", qcdf_integrals, "exact, tabulated");
+            }
+        }
+
+        std::shared_ptr<const Table> table(const Table::Case & c, const double & m_q, const double & m_B, const double & mu)
+        {
+            static const unsigned max_tables = 16;
+
+            const Key key{ c, m_q, m_B, mu };
+            {
+                Lock l(mutex);
+
+                auto t = tables.find(key);
+                if (tables.end() != t)
+                {
+                    t->second.last_use = ++uses;
+
+                    return t->second.table;
+                }
+            }
+
+            // build the table without holding the lock, so that other threads can use the existing tables
+            auto result = std::make_shared<const Table>(c, m_q, m_B, mu);
+            if (result->unfitted_intervals() > 0)
+            {
+                Log::instance()->message("[DileptonQCDFIntegrals.table]", ll_warning)
+                    << "The interpolation misses its tolerance in " << result->unfitted_intervals()
+                    << " interval(s) for m_q = " << m_q << ", m_B = " << m_B << ", mu = " << mu
+                    << "; using the exact integrals there";
+            }
+
+            Lock l(mutex);
+
+            // keep the table of a concurrent build, if any
+            auto t = tables.find(key);
+            if (tables.end() != t)
+            {
+                t->second.last_use = ++uses;
+
+                return t->second.table;
+            }
+
+            // evict the least recently used table
+            if (tables.size() >= max_tables)
+            {
+                tables.erase(std::min_element(tables.begin(), tables.end(),
+                        [] (const std::pair<const Key, Entry> & a, const std::pair<const Key, Entry> & b) { return a.second.last_use < b.second.last_use; }));
+            }
+
+            tables.emplace(key, Entry{ result, ++uses });
+
+            return result;
+        }
+
+        // return false if s lies outside the tabulated range
+        bool evaluate(const Table::Case & c, const double & s, const double & m_q, const double & m_B, const double & m_V, const double & mu,
+                const double & a_1_perp, const double & a_2_perp,
+                const double & a_1_parallel, const double & a_2_parallel,
+                QCDFIntegrals::Results & results)
+        {
+            Table::Values v;
+            if (! table(c, m_q, m_B, mu)->evaluate(s, v))
+                return false;
+
+            const double sh = s / m_B / m_B;
+            const double eh = (1.0 + power_of<2>(m_V / m_B) - sh) / 2.0;
+
+            auto perp     = [&] (const unsigned & i) { return v[3 * i] + a_1_perp * v[3 * i + 1] + a_2_perp * v[3 * i + 2]; };
+            auto parallel = [&] (const unsigned & i) { return v[3 * i] + a_1_parallel * v[3 * i + 1] + a_2_parallel * v[3 * i + 2]; };
+
+            // perpendicular amplitude
+            results.j0_perp = impl::j0(sh, a_1_perp, a_2_perp);
+            results.j0bar_perp = impl::j0(sh, -a_1_perp, a_2_perp);
+            results.j1_perp = perp(0);
+            results.j2_perp = perp(1);
+            results.j4_perp = perp(2);
+            results.j5_perp = perp(3);
+            // This integral arises in perpendicular amplitudes, but depends on parallel Gegenbauer moments!
+            results.j6_perp = parallel(4);
+            results.j7_perp = impl::j7_massless(sh, 0.5 / m_B, a_1_perp, a_2_perp);
+
+            // parallel amplitude
+            results.j0_parallel = impl::j0(sh, a_1_parallel, a_2_parallel);
+            results.j1_parallel = parallel(5);
+            results.j3_parallel = parallel(6);
+            results.j4_parallel = parallel(7);
+
+            // composite results
+            results.jtilde1_perp = 2.0 / eh * results.j1_perp + sh * results.j2_perp / (eh * eh);
+            results.jtilde2_parallel = 2.0 / eh * results.j1_parallel + results.j3_parallel / (eh * eh);
+
+            return true;
+        }
+    };
+
+    DileptonQCDFIntegrals::DileptonQCDFIntegrals(const Options & options) :
+        PrivateImplementationPattern<DileptonQCDFIntegrals>(new Implementation<DileptonQCDFIntegrals>(options))
+    {
+    }
+
+    DileptonQCDFIntegrals::~DileptonQCDFIntegrals()
+    {
+    }
+
+    QCDFIntegrals::Results
+    DileptonQCDFIntegrals::bottom_case(const double & s, const double & m_b, const double & m_B, const double & m_V, const double & mu,
+                    const double & a_1_perp, const double & a_2_perp,
+                    const double & a_1_parallel, const double & a_2_parallel) const
+    {
+        QCDFIntegrals::Results results;
+
+        if ((! _imp->tabulated) || (! _imp->evaluate(impl::DileptonQCDFIntegralsTable::bottom, s, m_b, m_B, m_V, mu,
+                        a_1_perp, a_2_perp, a_1_parallel, a_2_parallel, results)))
+        {
+            results = QCDFIntegrals::dilepton_bottom_case(s, m_b, m_B, m_V, mu, a_1_perp, a_2_perp, a_1_parallel, a_2_parallel);
+        }
+
+        return results;
+    }
+
+    QCDFIntegrals::Results
+    DileptonQCDFIntegrals::charm_case(const double & s, const double & m_c, const double & m_B, const double & m_V, const double & mu,
+                    const double & a_1_perp, const double & a_2_perp,
+                    const double & a_1_parallel, const double & a_2_parallel) const
+    {
+        QCDFIntegrals::Results results;
+
+        if ((! _imp->tabulated) || (! _imp->evaluate(impl::DileptonQCDFIntegralsTable::charm, s, m_c, m_B, m_V, mu,
+                        a_1_perp, a_2_perp, a_1_parallel, a_2_parallel, results)))
+        {
+            results = QCDFIntegrals::dilepton_charm_case(s, m_c, m_B, m_V, mu, a_1_perp, a_2_perp, a_1_parallel, a_2_parallel);
+        }
+
+        return results;
+    }
+
+    QCDFIntegrals::Results
+    DileptonQCDFIntegrals::massless_case(const double & s, const double & m_B, const double & m_V, const double & mu,
+                    const double & a_1_perp, const double & a_2_perp,
+                    const double & a_1_parallel, const double & a_2_parallel) const
+    {
+        QCDFIntegrals::Results results;
+
+        if ((! _imp->tabulated) || (! _imp->evaluate(impl::DileptonQCDFIntegralsTable::massless, s, 0.0, m_B, m_V, mu,
+                        a_1_perp, a_2_perp, a_1_parallel, a_2_parallel, results)))
+        {
+            results = QCDFIntegrals::dilepton_massless_case(s, m_B, m_V, mu, a_1_perp, a_2_perp, a_1_parallel, a_2_parallel);
+        }
+
+        return results;
+    }
 }
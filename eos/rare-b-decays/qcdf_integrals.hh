@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011 Danny van Dyk
+ * Copyright (c) 2011, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -21,6 +21,8 @@
 #define EOS_GUARD_EOS_RARE_B_DECAYS_QCDF_INTEGRALS_HH 1
 
 #include <eos/utils/complex.hh>
+#include <eos/utils/options.hh>
+#include <eos/utils/private_implementation_pattern.hh>
 
 namespace eos
 {
@@ -146,6 +148,47 @@ namespace eos
         complex<double> jtilde1_perp;
         complex<double> jtilde2_parallel;
     };
+
+    /*!
+     * The QCDF integrals for s > 0, as used by the decays.
+     *
+     * The option 'qcdf-integrals' selects either the exact integrals (value 'exact', the default),
+     * or tabulated ones (value 'tabulated'). The integrals are linear in the Gegenbauer moments.
+     * The latter mode decomposes them into basis functions that multiply 1, a_1 and a_2, and
+     * interpolates these in s once for each set of quark mass, B mass and scale. Each call then
+     * amounts to a small dot product.
+     *
+     * Building a table costs about as much as two thousand exact evaluations. The tabulated mode
+     * therefore pays off when many evaluations share the same quark masses, B mass and scale, e.g.
+     * when scanning in s or sampling the Gegenbauer moments and other hadronic parameters. It does
+     * not pay off when these masses or the scale vary from one evaluation to the next, e.g. when
+     * sampling m_c, m_b or mu. The tables for the 16 most recently used sets of masses and scale
+     * are kept; beyond that, the least recently used table is dropped. Where the interpolation misses its tolerance, a warning is logged and the exact
+     * integrals are used.
+     */
+    class DileptonQCDFIntegrals :
+        public PrivateImplementationPattern<DileptonQCDFIntegrals>
+    {
+        public:
+            DileptonQCDFIntegrals(const Options & options);
+
+            ~DileptonQCDFIntegrals();
+
+            /// Return all QCDF integrals for a b quark-antiquark loop, cf. QCDFIntegrals::dilepton_bottom_case.
+            QCDFIntegrals::Results bottom_case(const double & s, const double & m_b, const double & m_B, const double & m_V, const double & mu,
+                    const double & a_1_perp, const double & a_2_perp,
+                    const double & a_1_parallel, const double & a_2_parallel) const;
+
+            /// Return all QCDF integrals for a c quark-antiquark loop, cf. QCDFIntegrals::dilepton_charm_case.
+            QCDFIntegrals::Results charm_case(const double & s, const double & m_c, const double & m_B, const double & m_V, const double & mu,
+                    const double & a_1_perp, const double & a_2_perp,
+                    const double & a_1_parallel, const double & a_2_parallel) const;
+
+            /// Return all QCDF integrals for u,d,s (i.e. massless) quark-antiquark loops, cf. QCDFIntegrals::dilepton_massless_case.
+            QCDFIntegrals::Results massless_case(const double & s, const double & m_B, const double & m_V, const double & mu,
+                    const double & a_1_perp, const double & a_2_perp,
+                    const double & a_1_parallel, const double & a_2_parallel) const;
+    };
 }
 
 #endif
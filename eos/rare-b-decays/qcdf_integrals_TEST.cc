@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011 Danny van Dyk
+ * Copyright (c) 2011, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -846,3 +846,84 @@ class QCDFIntegralsDileptonMasslessTest :
             }
         }
 } qcdf_integrals_dilepton_massless_test;
+
+class QCDFIntegralsDileptonTabulatedTest :
+    public TestCase
+{
+    public:
+        QCDFIntegralsDileptonTabulatedTest() :
+            TestCase("qcdf_dilepton_tabulated_test")
+        {
+        }
+
+        // compare relative to the magnitude, since some of the integrals are purely real
+        static void check(const complex<double> & tabulated, const complex<double> & exact, const double & eps)
+        {
+            TEST_CHECK_NEARLY_EQUAL(0.0, std::abs(tabulated - exact) / std::abs(exact), eps);
+        }
+
+        static void check(const QCDFIntegrals::Results & tabulated, const QCDFIntegrals::Results & exact, const double & eps)
+        {
+            check(tabulated.j0_perp,          exact.j0_perp,          eps);
+            check(tabulated.j0bar_perp,       exact.j0bar_perp,       eps);
+            check(tabulated.j1_perp,          exact.j1_perp,          eps);
+            check(tabulated.j2_perp,          exact.j2_perp,          eps);
+            check(tabulated.j4_perp,          exact.j4_perp,          eps);
+            check(tabulated.j5_perp,          exact.j5_perp,          eps);
+            check(tabulated.j6_perp,          exact.j6_perp,          eps);
+            check(tabulated.j7_perp,          exact.j7_perp,          eps);
+            check(tabulated.j0_parallel,      exact.j0_parallel,      eps);
+            check(tabulated.j1_parallel,      exact.j1_parallel,      eps);
+            check(tabulated.j3_parallel,      exact.j3_parallel,      eps);
+            check(tabulated.j4_parallel,      exact.j4_parallel,      eps);
+            check(tabulated.jtilde1_perp,     exact.jtilde1_perp,     eps);
+            check(tabulated.jtilde2_parallel, exact.jtilde2_parallel, eps);
+        }
+
+        virtual void run() const
+        {
+            static const double m_B = 5.279, m_Kstar = 0.892, mu = 4.2;
+            static const double m_b = 4.8, m_c = 1.6;
+            static const double eps = 1e-9;
+
+            Options oo;
+            oo.set("qcdf-integrals", "tabulated");
+            DileptonQCDFIntegrals tabulated(oo);
+
+            // the tabulated integrals agree with the exact ones, for arbitrary Gegenbauer moments
+            for (double s : { 0.05, 0.5, 1.0, 2.0, 4.0, 6.0, 8.0, 9.5 })
+            {
+                check(tabulated.bottom_case(s, m_b, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4),
+                        QCDFIntegrals::dilepton_bottom_case(s, m_b, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4), eps);
+                check(tabulated.charm_case(s, m_c, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4),
+                        QCDFIntegrals::dilepton_charm_case(s, m_c, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4), eps);
+                check(tabulated.massless_case(s, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4),
+                        QCDFIntegrals::dilepton_massless_case(s, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4), eps);
+
+                check(tabulated.charm_case(s, m_c, m_B, m_Kstar, mu, 1.0, 2.0, 1.0, -2.0),
+                        QCDFIntegrals::dilepton_charm_case(s, m_c, m_B, m_Kstar, mu, 1.0, 2.0, 1.0, -2.0), eps);
+            }
+
+            // a change of the masses or the scale leads to a new table, while the previous ones are kept
+            for (double s : { 3.0, 7.5, 7.8, 7.83 })
+            {
+                check(tabulated.charm_case(s, 1.4, m_B, m_Kstar, 2.1, 0.1, -0.2, 0.3, 0.4),
+                        QCDFIntegrals::dilepton_charm_case(s, 1.4, m_B, m_Kstar, 2.1, 0.1, -0.2, 0.3, 0.4), eps);
+                check(tabulated.charm_case(s, m_c, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4),
+                        QCDFIntegrals::dilepton_charm_case(s, m_c, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4), eps);
+            }
+
+            // outside of the tabulated range, the exact integrals are used
+            check(tabulated.massless_case(0.001, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4),
+                    QCDFIntegrals::dilepton_massless_case(0.001, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4), eps);
+            check(tabulated.bottom_case(15.0, m_b, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4),
+                    QCDFIntegrals::dilepton_bottom_case(15.0, m_b, m_B, m_Kstar, mu, 0.1, -0.2, 0.3, 0.4), eps);
+
+            // unknown values of the option are rejected
+            {
+                Options o;
+                o.set("qcdf-integrals", "foo");
+                TEST_CHECK_THROWS(InvalidOptionValueError, DileptonQCDFIntegrals d(o));
+            }
+        }
+} qcdf_integrals_dilepton_tabulated_test;
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011, 2013-2019 Danny van Dyk
+ * Copyright (c) 2011, 2013-2020 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
  *
  * This file is part of the EOS project. EOS is free software;
@@ -25,13 +25,17 @@
 #include <eos/utils/observable_cache.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/thread_pool.hh>
 #include <eos/utils/verify.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <map>
+#include <memory>
+#include <numeric>
 
 #include <gsl/gsl_blas.h>
 #include <gsl/gsl_cdf.h>
@@ -47,6 +51,10 @@ namespace eos
 {
     namespace implementation
     {
+        /*
+         * FusedGaussianEvaluator::add() copies the id, mode, uncertainties and normalisation of
+         * this block. A block must therefore not be modified after its construction.
+         */
         struct GaussianBlock :
             public LogLikelihoodBlock
         {
@@ -873,6 +881,10 @@ namespace eos
             }
         };
 
+        /*
+         * FusedGaussianEvaluator::add() copies the ids, mean, normalisation and Cholesky factor of
+         * this block. A block must therefore not be modified after its construction.
+         */
         struct MultivariateGaussianBlock :
             public LogLikelihoodBlock
         {
@@ -1084,26 +1096,17 @@ namespace eos
             {
                 const auto k = _mean->size;
 
-                // generate standard normals in observables
+                // To be consistent with the univariate Gaussian, we would center observables around theory,
+                // then compare to theory. Hence we can forget about theory, and stay centered on zero.
+                // With pseudo data x = L z, where z are standard normals and L is the Cholesky factor,
+                // the chi^2 x^T inv(covariance) x = z^T L^T inv(L L^T) L z reduces to z^T z.
+                double chi_squared = 0.0;
                 for (auto i = 0u ; i < k ; ++i)
                 {
-                    gsl_vector_set(_observables, i, gsl_ran_ugaussian(rng));
+                    chi_squared += power_of<2>(gsl_ran_ugaussian(rng));
                 }
 
-                // transform: observables2 <- _chol * observables
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _chol, _observables, 0.0, _observables_2);
-
-                // To be consistent with the univariate Gaussian, we would center observables around theory,
-                // then compare to theory. Hence we can forget about theory, and stay centered on zero.
-                // transform: observables <- inv(covariance) * observables2
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _covariance_inv, _observables_2, 0.0, _observables);
-
-                double result;
-                gsl_blas_ddot(_observables, _observables_2, &result);
-                result *= -0.5;
-                result += _norm;
-
-                return result;
+                return _norm - 0.5 * chi_squared;
             }
 
             virtual double significance() const
@@ -1181,6 +1184,187 @@ namespace eos
                 return LogLikelihoodBlockPtr(new UniformBoundBlock(cache, cache.add(observable)));
             }
         };
+
+        /*
+         * Fused evaluation of all (multivariate) Gaussian blocks of a likelihood.
+         *
+         * The predictions of the multivariate blocks are gathered into one contiguous vector, and the
+         * chi^2 is obtained by a single forward substitution with the block-diagonal Cholesky factor
+         * of all covariance matrices. The univariate blocks are evaluated in one loop over contiguous
+         * arrays. All other blocks are evaluated individually.
+         *
+         * If fusion is disabled, all blocks are evaluated individually.
+         */
+        struct FusedGaussianEvaluator
+        {
+            // whether the Gaussian blocks are fused
+            bool fused;
+
+            // sum of the normalisation constants of all fused blocks
+            double norm;
+
+            // univariate blocks
+            std::vector<ObservableCache::Id> ids;
+            std::vector<double> modes, sigmas_lower, sigmas_upper;
+
+            // multivariate blocks, with the lower Cholesky factors stored packed and row by row
+            std::vector<ObservableCache::Id> mv_ids;
+            std::vector<double> means;
+            std::vector<unsigned> dimensions;
+            std::vector<double> cholesky;
+
+            // temporary storage for evaluation
+            mutable std::vector<double> residuals;
+
+            // all other blocks
+            std::vector<LogLikelihoodBlockPtr> others;
+
+            FusedGaussianEvaluator(const bool & fused) :
+                fused(fused),
+                norm(0.0)
+            {
+            }
+
+            void add(const LogLikelihoodBlockPtr & block)
+            {
+                if (! fused)
+                {
+                    others.push_back(block);
+                }
+                else if (auto g = dynamic_cast<const GaussianBlock *>(block.get()))
+                {
+                    norm += g->norm;
+                    ids.push_back(g->id);
+                    modes.push_back(g->mode);
+                    sigmas_lower.push_back(g->sigma_lower);
+                    sigmas_upper.push_back(g->sigma_upper);
+                }
+                else if (auto m = dynamic_cast<const MultivariateGaussianBlock *>(block.get()))
+                {
+                    const unsigned k = m->_ids.size();
+
+                    norm += m->_norm;
+                    mv_ids.insert(mv_ids.end(), m->_ids.cbegin(), m->_ids.cend());
+                    for (unsigned i = 0 ; i < k ; ++i)
+                    {
+                        means.push_back(gsl_vector_get(m->_mean, i));
+
+                        for (unsigned j = 0 ; j <= i ; ++j)
+                        {
+                            cholesky.push_back(gsl_matrix_get(m->_chol, i, j));
+                        }
+                    }
+                    dimensions.push_back(k);
+                    residuals.resize(mv_ids.size());
+                }
+                else
+                {
+                    others.push_back(block);
+                }
+            }
+
+            double evaluate(const ObservableCache & cache) const
+            {
+                double chi_squared = 0.0;
+
+                for (unsigned i = 0, i_end = ids.size() ; i < i_end ; ++i)
+                {
+                    const double value = cache[ids[i]];
+
+                    // allow for asymmetric Gaussian uncertainty
+                    const double sigma = (value > modes[i]) ? sigmas_upper[i] : sigmas_lower[i];
+
+                    chi_squared += power_of<2>((value - modes[i]) / sigma);
+                }
+
+                for (unsigned i = 0, i_end = mv_ids.size() ; i < i_end ; ++i)
+                {
+                    residuals[i] = cache[mv_ids[i]] - means[i];
+                }
+
+                // solve L r' = r, with chi^2 = r'^T r'
+                const double * l = cholesky.data();
+                double * r = residuals.data();
+                for (const auto & k : dimensions)
+                {
+                    for (unsigned i = 0 ; i < k ; ++i)
+                    {
+                        double sum = r[i];
+                        for (unsigned j = 0 ; j < i ; ++j)
+                        {
+                            sum -= l[j] * r[j];
+                        }
+
+                        r[i] = sum / l[i];
+                        chi_squared += r[i] * r[i];
+
+                        // advance to the next row
+                        l += i + 1;
+                    }
+
+                    r += k;
+                }
+
+                double result = norm - 0.5 * chi_squared;
+                if (! std::isfinite(result))
+                    return result;
+
+                for (const auto & b : others)
+                {
+                    const double llh = b->evaluate();
+                    if (! std::isfinite(llh))
+                        return llh;
+
+                    result += llh;
+                }
+
+                return result;
+            }
+
+            // draw the likelihood of one simulated data set, cf. the sample() methods of the individual blocks
+            double sample(gsl_rng * rng) const
+            {
+                double chi_squared = 0.0;
+
+                for (unsigned i = 0, i_end = ids.size() ; i < i_end ; ++i)
+                {
+                    // mirror and shift the distribution, cf. GaussianBlock::sample()
+                    const double & a = sigmas_lower[i], & b = sigmas_upper[i];
+                    const double c_b = 2.0 * b / (a + b);
+
+                    // find out if sample in upper or lower part
+                    const double u = gsl_rng_uniform(rng);
+
+                    const double chi = (u < b / (a + b)) ? gsl_cdf_ugaussian_Pinv(u / c_b) : gsl_cdf_ugaussian_Pinv(u - 0.5 * c_b);
+                    chi_squared += chi * chi;
+                }
+
+                // cf. MultivariateGaussianBlock::sample()
+                for (unsigned i = 0, i_end = mv_ids.size() ; i < i_end ; ++i)
+                {
+                    chi_squared += power_of<2>(gsl_ran_ugaussian(rng));
+                }
+
+                double result = norm - 0.5 * chi_squared;
+
+                for (const auto & b : others)
+                {
+                    result += b->sample(rng);
+                }
+
+                return result;
+            }
+        };
+
+        // derive the seed of one chunk of simulated data sets from a common seed, cf. the SplitMix64 generator
+        inline unsigned long chunk_seed(const unsigned long & seed, const unsigned long & chunk)
+        {
+            std::uint64_t z = seed + (chunk + 1) * 0x9e3779b97f4a7c15ull;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+            return z ^ (z >> 31);
+        }
     }
 
     LogLikelihoodBlock::~LogLikelihoodBlock()
@@ -1351,9 +1535,13 @@ namespace eos
         // Container for all named constraints
         std::vector<Constraint> constraints;
 
-        Implementation(const Parameters & parameters) :
+        // Evaluation plan for all blocks of all constraints
+        implementation::FusedGaussianEvaluator evaluator;
+
+        Implementation(const Parameters & parameters, const bool & fused) :
             parameters(parameters),
-            cache(parameters)
+            cache(parameters),
+            evaluator(fused)
         {
         }
 
@@ -1384,36 +1572,41 @@ namespace eos
                                      << "The value of the test statistic (total likelihood) "
                                      << "for the current parameters is = " << t_obs;
 
-            // count data sets with smaller likelihood
-            unsigned n_low = 0;
-
-            // test value
-            double t;
-
-            gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
-            gsl_rng_set(rng, datasets);
-
             Log::instance()->message("log_likelihood.bootstrap_pvalue", ll_informational)
                                      << "Begin sampling " << datasets << " simulated "
                                      << "values of the likelihood";
 
-            // collect samples
-            for (unsigned i = 0 ; i < datasets ; ++i)
+            // The data sets are simulated in chunks of fixed size, each with its own random number
+            // generator. Since the seeds depend only on the number of data sets and the index of
+            // the chunk, the result is reproducible and does not depend on the number of threads.
+            static const unsigned chunk_size = 4096;
+            const unsigned chunks = (datasets + chunk_size - 1) / chunk_size;
+
+            // count data sets with smaller likelihood, per chunk
+            std::vector<unsigned> n_low_per_chunk(chunks, 0u);
+
+            ThreadPool::instance()->parallel_for(0, chunks, 1, [&] (const unsigned long & c_begin, const unsigned long & c_end)
             {
-                t = 0.0;
-                for (auto c = constraints.cbegin(), c_end = constraints.cend() ; c != c_end ; ++c)
+                std::unique_ptr<gsl_rng, void (*)(gsl_rng *)> rng(gsl_rng_alloc(gsl_rng_mt19937), &gsl_rng_free);
+
+                for (auto c = c_begin ; c != c_end ; ++c)
                 {
-                    for (auto b = c->begin_blocks(), b_end = c->end_blocks() ; b != b_end ; ++b)
+                    gsl_rng_set(rng.get(), implementation::chunk_seed(datasets, c));
+
+                    unsigned n_low = 0;
+                    for (unsigned i = c * chunk_size, i_end = std::min<unsigned>(datasets, (c + 1) * chunk_size) ; i != i_end ; ++i)
                     {
-                        t += (*b)->sample(rng);
+                        if (evaluator.sample(rng.get()) < t_obs)
+                        {
+                            ++n_low;
+                        }
                     }
-                }
 
-                if (t < t_obs)
-                {
-                    ++n_low;
+                    n_low_per_chunk[c] = n_low;
                 }
-            }
+            });
+
+            const unsigned n_low = std::accumulate(n_low_per_chunk.cbegin(), n_low_per_chunk.cend(), 0u);
 
             // mode of binomial posterior
             double p = n_low / double(datasets);
@@ -1427,34 +1620,27 @@ namespace eos
                                      << "The simulated p-value is " << p
                                      << " with uncertainty " << uncertainty;
 
-            gsl_rng_free(rng);
-
             return std::make_pair(p, uncertainty);
         }
 
-        double log_likelihood() const
+        void add(const Constraint & constraint)
         {
-            double result = 0.0;
+            constraints.push_back(constraint);
 
-            // loop over all likelihood blocks
-            for (auto c = constraints.cbegin(), c_end = constraints.cend() ; c != c_end ; ++c)
+            for (auto b = constraint.begin_blocks(), b_end = constraint.end_blocks() ; b != b_end ; ++b)
             {
-                for (auto b = c->begin_blocks(), b_end = c->end_blocks() ; b != b_end ; ++b)
-                {
-                    double llh = (*b)->evaluate();
-                    if (! std::isfinite(llh))
-                        return llh;
-
-                    result += llh;
-                }
+                evaluator.add(*b);
             }
+        }
 
-            return result;
+        double log_likelihood() const
+        {
+            return evaluator.evaluate(cache);
         }
     };
 
-    LogLikelihood::LogLikelihood(const Parameters & parameters) :
-        PrivateImplementationPattern<LogLikelihood>(new Implementation<LogLikelihood>(parameters))
+    LogLikelihood::LogLikelihood(const Parameters & parameters, const bool & fused) :
+        PrivateImplementationPattern<LogLikelihood>(new Implementation<LogLikelihood>(parameters, fused))
     {
     }
 
@@ -1467,8 +1653,7 @@ namespace eos
             const unsigned & number_of_observations)
     {
         LogLikelihoodBlockPtr b = LogLikelihoodBlock::Gaussian(_imp->cache, observable, min, central, max, number_of_observations);
-        _imp->constraints.push_back(
-            Constraint(observable->name(), std::vector<ObservablePtr>{ observable }, std::vector<LogLikelihoodBlockPtr>{ b }));
+        _imp->add(Constraint(observable->name(), std::vector<ObservablePtr>{ observable }, std::vector<LogLikelihoodBlockPtr>{ b }));
     }
 
     void
@@ -1486,7 +1671,7 @@ namespace eos
         std::copy(constraint.begin_observables(), constraint.end_observables(), std::back_inserter(observables));
 
         // retain a proper copy of the constraint to iterate over
-        _imp->constraints.push_back(Constraint(constraint.name(), observables, blocks));
+        _imp->add(Constraint(constraint.name(), observables, blocks));
     }
 
     LogLikelihood::ConstraintIterator
@@ -1510,7 +1695,7 @@ namespace eos
     LogLikelihood
     LogLikelihood::clone() const
     {
-        LogLikelihood result(_imp->parameters.clone());
+        LogLikelihood result(_imp->parameters.clone(), _imp->evaluator.fused);
         result._imp->cache = _imp->cache.clone(result._imp->parameters);
 
         for (auto c = _imp->constraints.cbegin(), c_end = _imp->constraints.cend() ; c != c_end ; ++c)
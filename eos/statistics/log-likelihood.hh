@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011, 2013, 2014, 2017 Danny van Dyk
+ * Copyright (c) 2011, 2013, 2014, 2017, 2020 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
  *
  * This file is part of the EOS project. EOS is free software;
@@ -320,8 +320,10 @@ namespace eos
              * Constructor.
              *
              * @param parameters  The Parameters object to which all further ObservablePtr objects must be bound.
+             * @param fused       If true, all Gaussian and multivariate Gaussian blocks are evaluated together.
+             *                    Otherwise, every block is evaluated on its own, e.g. for comparisons.
              */
-            LogLikelihood(const Parameters & parameters);
+            LogLikelihood(const Parameters & parameters, const bool & fused = true);
 
             /*!
              * Destructor.
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011, 2013, 2015, 2016 Danny van Dyk
+ * Copyright (c) 2011, 2013, 2015, 2016, 2020 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
  *
  * This file is part of the EOS project. EOS is free software;
@@ -607,6 +607,77 @@ namespace eos
                     TEST_CHECK_RELATIVE_ERROR(mvg_covariance->evaluate(), mvg_correlation->evaluate(), eps);
                 }
 
+                // the fused evaluation agrees with the sum over the individual blocks
+                {
+                    LogLikelihood llh(p);
+                    ObservableCache cache = llh.observable_cache();
+
+                    // univariate, asymmetric Gaussians
+                    llh.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)", k)), +4.24, +4.25, +4.30);
+                    llh.add(ObservablePtr(new ObservableStub(p, "mass::tau",      k)), +1.85, +2.00, +2.18);
+
+                    // correlated multivariate Gaussians
+                    std::array<ObservablePtr, 2> obs2
+                    {{
+                        ObservablePtr(new ObservableStub(p, "mass::c",  k)),
+                        ObservablePtr(new ObservableStub(p, "mass::mu", k))
+                    }};
+                    std::array<double, 2> mean2{{ 1.1, 0.1 }};
+                    std::array<std::array<double, 2>, 2> covariance2{{ {{ 0.01, 0.003 }}, {{ 0.003, 0.0025 }} }};
+                    llh.add(Constraint("test::mvg-2", std::vector<ObservablePtr>(obs2.begin(), obs2.end()),
+                        std::vector<LogLikelihoodBlockPtr>{ LogLikelihoodBlock::MultivariateGaussian<2>(cache, obs2, mean2, covariance2) }));
+
+                    std::array<ObservablePtr, 3> obs3
+                    {{
+                        ObservablePtr(new ObservableStub(p, "mass::s(2GeV)", k)),
+                        ObservablePtr(new ObservableStub(p, "mass::d(2GeV)", k)),
+                        ObservablePtr(new ObservableStub(p, "mass::c",       k))
+                    }};
+                    std::array<double, 3> mean3{{ 0.09, 0.005, 1.3 }};
+                    std::array<double, 3> variances3{{ 1e-4, 1e-6, 0.04 }};
+                    std::array<std::array<double, 3>, 3> correlation3{{ {{ 1.0, 0.3, -0.2 }}, {{ 0.3, 1.0, 0.1 }}, {{ -0.2, 0.1, 1.0 }} }};
+                    llh.add(Constraint("test::mvg-3", std::vector<ObservablePtr>(obs3.begin(), obs3.end()),
+                        std::vector<LogLikelihoodBlockPtr>{ LogLikelihoodBlock::MultivariateGaussian<3>(cache, obs3, mean3, variances3, correlation3) }));
+
+                    // a block that is evaluated individually
+                    auto obs_e = ObservablePtr(new ObservableStub(p, "mass::e", k));
+                    llh.add(Constraint("test::electron-mass", std::vector<ObservablePtr>{ obs_e },
+                        std::vector<LogLikelihoodBlockPtr>{ LogLikelihoodBlock::LogGamma(cache, obs_e, 0.1, 0.11, 0.13) }));
+
+                    // the same constraints, evaluated block by block
+                    LogLikelihood llh_per_block(p, false);
+                    for (auto c = llh.begin(), c_end = llh.end() ; c != c_end ; ++c)
+                    {
+                        llh_per_block.add(*c);
+                    }
+
+                    for (double x : { 0.0, 0.5, 1.0 })
+                    {
+                        p["mass::b(MSbar)"] = 4.2 + 0.1 * x;
+                        p["mass::tau"]      = 1.9 + 0.2 * x;
+                        p["mass::c"]        = 1.2 + 0.1 * x;
+                        p["mass::mu"]       = 0.105 + 0.01 * x;
+                        p["mass::s(2GeV)"]  = 0.095 - 0.01 * x;
+                        p["mass::d(2GeV)"]  = 0.0047 + 0.001 * x;
+                        p["mass::e"]        = 0.115 + 0.005 * x;
+
+                        const double value = llh();
+
+                        double sum = 0.0;
+                        for (auto c = llh.begin(), c_end = llh.end() ; c != c_end ; ++c)
+                        {
+                            for (auto b = c->begin_blocks(), b_end = c->end_blocks() ; b != b_end ; ++b)
+                            {
+                                sum += (**b).evaluate();
+                            }
+                        }
+
+                        TEST_CHECK_RELATIVE_ERROR(sum, value, 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(llh_per_block(), value, 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(llh_per_block.clone()(), value, 1e-12);
+                    }
+                }
+
                 // bootstrap p-value calculation
                 {
                     Parameters parameters  = Parameters::Defaults();
@@ -622,6 +693,9 @@ namespace eos
                     // since data restricted to three sigma around central value,
                     // p-value should be slightly biased upwards
                     TEST_CHECK_NEARLY_EQUAL(p_value, 0.852143788, 5e-3);
+
+                    // the simulated data sets are reproducible
+                    TEST_CHECK_EQUAL(p_value, llh.bootstrap_p_value(5e4).first);
                 }
 
                 // mixture density
@@ -19,13 +19,18 @@
 
 #include <config.h>
 
+#include <eos/optimize/numerical-derivatives.hh>
 #include <eos/statistics/log-posterior.hh>
 #include <eos/utils/density-impl.hh>
 #include <eos/utils/hdf5.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/power_of.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
 
-#include <Minuit2/FCNBase.h>
+#include <Minuit2/FCNGradientBase.h>
 #include <Minuit2/FunctionMinimum.h>
 #include <Minuit2/MnMigrad.h>
 #include <Minuit2/MnMinimize.h>
@@ -48,7 +53,7 @@ namespace eos
     };
 
    struct MinuitAdapter :
-       public ROOT::Minuit2::FCNBase
+       public ROOT::Minuit2::FCNGradientBase
    {
        LogPosterior log_posterior;
 
@@ -57,6 +62,9 @@ namespace eos
        // stores results of minimization
        std::shared_ptr<FunctionMinimum> data_at_minimum;
 
+       // evaluates the gradient on independent copies of the posterior
+       std::shared_ptr<NumericalDerivatives> derivatives;
+
        MinuitAdapter(LogPosterior & log_posterior) :
            log_posterior(log_posterior)
        {
@@ -87,13 +95,41 @@ namespace eos
            }
            return -log_posterior.log_posterior();
        }
+
+       virtual std::vector<double> Gradient(const std::vector<double> & parameter_values) const
+       {
+           std::vector<double> result = derivatives->gradient(parameter_values);
+           for (auto & r : result)
+           {
+               r = -r;
+           }
+
+           return result;
+       }
+
+       virtual bool CheckGradient() const
+       {
+           return false;
+       }
+   };
+
+   struct LogPosterior::BatchEvaluation
+   {
+       Mutex mutex;
+
+       /// One clone per thread, created on demand
+       std::vector<LogPosteriorPtr> clones;
+
+       /// Generation of the parameters at the last synchronization of the clones
+       unsigned long generation = 0;
    };
 
    LogPosterior::LogPosterior(const LogLikelihood & log_likelihood) :
         _log_likelihood(log_likelihood),
         _parameters(log_likelihood.parameters()),
         _informative_priors(0),
-        _minuit(nullptr)
+        _minuit(nullptr),
+        _batch(new BatchEvaluation)
    {
    }
 
@@ -124,6 +160,9 @@ namespace eos
        // then add to prior container
        _priors.push_back(prior_clone);
 
+       // existing clones lack the new prior
+       _batch = std::make_shared<BatchEvaluation>();
+
        return true;
    }
 
@@ -170,6 +209,57 @@ namespace eos
        return log_posterior();
    }
 
+   void
+   LogPosterior::evaluate_batch(const double * points, const std::size_t & n, const std::size_t & dim, double * out) const
+   {
+       if (dim != _parameter_descriptions.size())
+           throw InternalError("LogPosterior::evaluate_batch: points have dimension " + stringify(dim)
+                   + ", expected " + stringify(_parameter_descriptions.size()));
+
+       if (0 == n)
+           return;
+
+       Lock l(_batch->mutex);
+
+       auto & clones = _batch->clones;
+       const std::size_t number_of_clones = std::min<std::size_t>(n, ThreadPool::instance()->number_of_threads());
+       while (clones.size() < number_of_clones)
+       {
+           clones.push_back(old_clone());
+       }
+
+       // propagate changes of the parameters that are not varied
+       const unsigned long generation = _parameters.generation();
+       if (generation != _batch->generation)
+       {
+           for (auto & c : clones)
+           {
+               for (auto p = _parameters.begin(), p_end = _parameters.end() ; p != p_end ; ++p)
+               {
+                   c->_parameters[p->id()] = p->evaluate();
+               }
+           }
+
+           _batch->generation = generation;
+       }
+
+       // contiguous ranges of points, one per clone
+       ThreadPool::instance()->parallel_for_parts(n, number_of_clones, [&] (const unsigned long & c, const unsigned long & i_begin, const unsigned long & i_end)
+       {
+           const LogPosterior & clone = *clones[c];
+
+           for (auto i = i_begin ; i != i_end ; ++i)
+           {
+               for (std::size_t j = 0 ; j != dim ; ++j)
+               {
+                   clone._parameter_descriptions[j].parameter->set(points[i * dim + j]);
+               }
+
+               out[i] = clone.log_posterior();
+           }
+       });
+   }
+
    Density::Iterator
    LogPosterior::begin() const
    {
@@ -713,22 +803,37 @@ namespace eos
        // create MIGRAD minimizer
        std::shared_ptr<ROOT::Minuit2::MnApplication> minimizer;
 
+       // copies of the posterior for the gradient are taken at the current values of all other parameters
+       if (options.parallel_gradient)
+       {
+           _minuit->derivatives = std::make_shared<NumericalDerivatives>(this->clone());
+       }
+
+       const FCNGradientBase & fcn_with_gradient(*_minuit);
+       const FCNBase & fcn(*_minuit);
+
        if (options.algorithm == "migrad")
        {
-           minimizer.reset(new MnMigrad(*_minuit, mn_par, options.strategy_level));
+           if (options.parallel_gradient)
+               minimizer.reset(new MnMigrad(fcn_with_gradient, mn_par, options.strategy_level));
+           else
+               minimizer.reset(new MnMigrad(fcn, mn_par, options.strategy_level));
        }
        // uses minuit, reverts to simplex if it failed, then call minuit again
        if (options.algorithm == "minimize")
        {
-           minimizer.reset(new MnMinimize(*_minuit, mn_par, options.strategy_level));
+           if (options.parallel_gradient)
+               minimizer.reset(new MnMinimize(fcn_with_gradient, mn_par, options.strategy_level));
+           else
+               minimizer.reset(new MnMinimize(fcn, mn_par, options.strategy_level));
        }
        if (options.algorithm == "scan")
        {
-           minimizer.reset(new MnScan(*_minuit, mn_par, options.strategy_level));
+           minimizer.reset(new MnScan(fcn, mn_par, options.strategy_level));
        }
        if (options.algorithm == "simplex")
        {
-           minimizer.reset(new MnSimplex(*_minuit, mn_par, options.strategy_level));
+           minimizer.reset(new MnSimplex(fcn, mn_par, options.strategy_level));
        }
 
        if (! minimizer)
@@ -762,6 +867,7 @@ namespace eos
         initial_step_size(0, 1, 0.1),
         maximum_iterations(8000),
         mcmc_pre_run(true),
+        parallel_gradient(false),
         tolerance(0, 1, 1e-1),
         splitting_tolerance(0, 1, 1e-2),
         strategy_level(0,2, 1)
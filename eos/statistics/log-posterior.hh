@@ -80,6 +80,21 @@ namespace eos
 
             virtual double evaluate() const;
 
+            /*!
+             * Evaluate the log(posterior) at many parameter points.
+             *
+             * The points are distributed over clones of this posterior, which are evaluated
+             * concurrently by the ThreadPool. The clones and their observable caches are kept
+             * for subsequent calls, and pick up the current values of all parameters that are
+             * not varied. The parameters of this posterior are left unchanged.
+             *
+             * @param points The points, as n consecutive rows of dim values in the order of the parameter descriptions.
+             * @param n      The number of points.
+             * @param dim    The number of values per point, which must match the number of parameter descriptions.
+             * @param out    The n values of the log(posterior).
+             */
+            void evaluate_batch(const double * points, const std::size_t & n, const std::size_t & dim, double * out) const;
+
             virtual Iterator begin() const;
             virtual Iterator end() const;
             ///@}
@@ -208,6 +223,8 @@ namespace eos
             optimize_minuit(const std::vector<double> & initial_guess, const OptimizationOptions & options);
 
         private:
+            struct BatchEvaluation;
+
             /*!
              * Find index of definition of parameter
              * @param name
@@ -246,6 +263,9 @@ namespace eos
 
             /// Adapter to let minuit operate on posterior
             MinuitAdapter * _minuit;
+
+            /// Clones for the batch evaluation
+            std::shared_ptr<BatchEvaluation> _batch;
     };
 
         // todo move optimization into separate class
@@ -275,6 +295,16 @@ namespace eos
                  */
                 bool mcmc_pre_run;
 
+                /*!
+                 * If true, Migrad and Minimize obtain the gradient from a NumericalDerivatives object,
+                 * which evaluates the displaced points concurrently on copies of the posterior.
+                 * Otherwise Minuit2 computes the gradient itself, one parameter at a time.
+                 *
+                 * Off by default. Callers opt in where the cost of a single evaluation of the
+                 * posterior outweighs the cost of cloning it once per ThreadPool worker.
+                 */
+                bool parallel_gradient;
+
                 /*!
                  *  Once the algorithm has shrunk the probe
                  *  simplex below this size, convergence is declared.
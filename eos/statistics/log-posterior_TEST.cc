@@ -222,6 +222,17 @@ class LogPosteriorTest :
                 // no correlation present
                 TEST_CHECK_NEARLY_EQUAL(u_cov(0,1) / sqrt(fabs(u_cov(0,0) * u_cov(1,1))), 0   , 5e-3);
                 TEST_CHECK_NEARLY_EQUAL(u_cov(1,3) / sqrt(fabs(u_cov(1,1) * u_cov(3,3))), 0   , 2e-2);
+
+                /* try again with Minuit, using the parallel gradient */
+                config.parallel_gradient = true;
+                const ROOT::Minuit2::FunctionMinimum & data_at_min_parallel = log_posterior.optimize_minuit(initial_guess, config);
+
+                auto u_par_parallel = data_at_min_parallel.UserParameters();
+                TEST_CHECK_NEARLY_EQUAL(u_par_parallel.Value(0), 4.2   , 1e-4);
+                TEST_CHECK_NEARLY_EQUAL(u_par_parallel.Value(1), 1.2   , 1e-4);
+                TEST_CHECK_NEARLY_EQUAL(u_par_parallel.Value(2), 1e-2  , 1e-4);
+                TEST_CHECK_NEARLY_EQUAL(u_par_parallel.Value(3), 172   , 1e-4);
+                TEST_CHECK_NEARLY_EQUAL(u_par_parallel.Value(4), 511e-6, 1e-4);
             }
 
             // goodness_of_fit
@@ -250,5 +261,43 @@ class LogPosteriorTest :
                 TEST_CHECK_NEARLY_EQUAL(ret.first, 0.852143788, 5e-3);
                 TEST_CHECK_NEARLY_EQUAL(ret.second, 0.57160, 5e-3);
             }
+
+            // batch evaluation
+            {
+                Parameters parameters = Parameters::Defaults();
+
+                LogLikelihood llh(parameters);
+                llh.add(ObservablePtr(new ObservableStub(parameters, "mass::b(MSbar)")), 4.1, 4.2, 4.3);
+                llh.add(ObservablePtr(new ObservableStub(parameters, "mass::c")),        1.15, 1.2, 1.25);
+
+                LogPosterior log_posterior(llh);
+                log_posterior.add(LogPrior::Flat(parameters, "mass::b(MSbar)", ParameterRange{ 3.7, 4.9 }));
+
+                const std::vector<double> points{ 3.9, 4.0, 4.1, 4.15, 4.2, 4.25, 4.3, 4.4, 4.5, 4.6, 4.7 };
+                std::vector<double> values(points.size());
+
+                auto reference = log_posterior.old_clone();
+                auto check = [&] ()
+                {
+                    for (unsigned i = 0 ; i < points.size() ; ++i)
+                    {
+                        (*reference)[0]->set(points[i]);
+                        TEST_CHECK_EQUAL(values[i], reference->evaluate());
+                    }
+                };
+
+                const double m_b = parameters["mass::b(MSbar)"]();
+                log_posterior.evaluate_batch(points.data(), points.size(), 1, values.data());
+                check();
+                TEST_CHECK_EQUAL(parameters["mass::b(MSbar)"](), m_b);
+
+                // changes of the parameters that are not varied are picked up
+                parameters["mass::c"] = 1.25;
+                reference->parameters()["mass::c"] = 1.25;
+                log_posterior.evaluate_batch(points.data(), points.size(), 1, values.data());
+                check();
+
+                TEST_CHECK_THROWS(InternalError, log_posterior.evaluate_batch(points.data(), 5, 2, values.data()));
+            }
         }
 } log_posterior_test;
@@ -2,7 +2,7 @@
 
 /*
  * Copyright (c) 2011 Frederik Beaujean
- * Copyright (c) 2011, 2013 Danny van Dyk
+ * Copyright (c) 2011, 2013, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -23,22 +23,376 @@
 #include <eos/statistics/log-posterior.hh>
 #include <eos/statistics/markov-chain-sampler.hh>
 #include <eos/statistics/rvalue.hh>
+#include <eos/utils/condition_variable.hh>
 #include <eos/utils/hdf5.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/thread.hh>
 #include <eos/utils/thread_pool.hh>
 
 #include <Minuit2/FunctionMinimum.h>
 #include <Minuit2/MnPrint.h>
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
 #include <map>
+#include <memory>
 #include <limits>
 #include <sys/stat.h>
 
 namespace eos
 {
+    namespace implementation
+    {
+        /*
+         * Statistics of a single chain, as published at the end of one of its chunks.
+         */
+        struct ChunkStatistics
+        {
+            // the number of chunks that the chain has completed
+            unsigned chunks;
+
+            // the number of iterations that the statistics are based on
+            unsigned iterations;
+
+            // whether the efficiency of the last chunk is within the configured range
+            bool efficiency_ok;
+
+            // Welford estimates of the parameters' means and variances; empty if not available
+            std::vector<double> means, variances;
+        };
+
+        /*
+         * Running means and variances of the states of one chain, summarised chunk by chunk.
+         *
+         * Each chunk is summarised once, when it is added. The statistics from any state up to the end
+         * of the history are combined from these summaries, and only the chunk that contains the first
+         * state is visited again. Hence, the cost of an update does not grow with the length of the history.
+         */
+        class ChainMoments
+        {
+            private:
+                struct Summary
+                {
+                    // index of the first state, and the number of states
+                    unsigned begin, size;
+
+                    // the means, and the sums of the squared deviations from the means
+                    std::vector<double> means, m2;
+                };
+
+                std::vector<Summary> _summaries;
+
+                // the number of states that have been summarised
+                unsigned _size = 0;
+
+                // Welford's algorithm for the states in [begin, end)
+                static Summary summarise(const MarkovChain::History & history, const unsigned & begin, const unsigned & end)
+                {
+                    Summary result{ begin, 0, {}, {} };
+
+                    MarkovChain::State::Iterator s = history.states.cbegin();
+                    s += begin;
+                    for (unsigned i = begin ; i != end ; ++i, ++s)
+                    {
+                        ++result.size;
+                        if (1 == result.size)
+                        {
+                            result.means = s->point;
+                            result.m2.assign(result.means.size(), 0.0);
+                            continue;
+                        }
+
+                        for (unsigned j = 0 ; j < result.means.size() ; ++j)
+                        {
+                            const double delta = s->point[j] - result.means[j];
+                            result.means[j] += delta / result.size;
+                            result.m2[j] += delta * (s->point[j] - result.means[j]);
+                        }
+                    }
+
+                    return result;
+                }
+
+                // combine the summaries of two disjoint sets of states, cf. Chan, Golub and LeVeque
+                static void merge(Summary & a, const Summary & b)
+                {
+                    const double size = a.size + b.size;
+                    for (unsigned j = 0 ; j < a.means.size() ; ++j)
+                    {
+                        const double delta = b.means[j] - a.means[j];
+                        a.means[j] += delta * b.size / size;
+                        a.m2[j] += b.m2[j] + delta * delta * a.size * b.size / size;
+                    }
+
+                    a.size += b.size;
+                }
+
+            public:
+                // summarise the states that have been added to the history since the last update
+                void update(const MarkovChain::History & history)
+                {
+                    const unsigned size = history.states.size();
+                    if (size <= _size)
+                        return;
+
+                    _summaries.push_back(summarise(history, _size, size));
+                    _size = size;
+                }
+
+                // the means and variances of the states from index begin up to the last update
+                void mean_and_variance(const MarkovChain::History & history, const unsigned & begin,
+                        std::vector<double> & means, std::vector<double> & variances) const
+                {
+                    if (begin >= _size)
+                        throw InternalError("ChainMoments::mean_and_variance: Cannot compute statistics for empty sequence");
+
+                    // the chunk that contains the first state
+                    auto i = std::upper_bound(_summaries.cbegin(), _summaries.cend(), begin,
+                            [] (const unsigned & b, const Summary & s) { return b < s.begin + s.size; });
+
+                    Summary result = summarise(history, begin, i->begin + i->size);
+                    for (++i ; i != _summaries.cend() ; ++i)
+                    {
+                        merge(result, *i);
+                    }
+
+                    means = result.means;
+                    variances.assign(means.size(), 0.0);
+                    if (result.size < 2)
+                        return;
+
+                    for (unsigned j = 0 ; j < means.size() ; ++j)
+                    {
+                        variances[j] = result.m2[j] / (result.size - 1);
+                    }
+                }
+        };
+
+        /*
+         * Collects the ChunkStatistics of all chains, round by round.
+         *
+         * A round is complete once every chain has published its statistics after the same number
+         * of chunks. The statistics of chains that are ahead are queued until the slower chains have
+         * caught up, so that the convergence check always compares the chains after the same number
+         * of iterations. Publishing takes a short lock, but never waits for the other chains.
+         *
+         * This is deliberately neither lock-free nor free of a barrier: the R-values are only meaningful
+         * for chains of equal length, so each check has to wait for the slowest chain. The chains
+         * themselves do not wait; only the check of a round is delayed until the round is complete.
+         */
+        class ChunkStatisticsAggregator
+        {
+            private:
+                Mutex _mutex;
+
+                // per chain, the statistics that are not yet part of a complete round
+                std::vector<std::deque<std::shared_ptr<const ChunkStatistics>>> _pending;
+
+            public:
+                ChunkStatisticsAggregator(const unsigned & number_of_chains) :
+                    _pending(number_of_chains)
+                {
+                }
+
+                /*
+                 * Add the statistics of one chain. Return true if this completes the next round,
+                 * and then provide the statistics of all chains for that round.
+                 */
+                bool publish(const unsigned & chain, const std::shared_ptr<const ChunkStatistics> & statistics,
+                        std::vector<std::shared_ptr<const ChunkStatistics>> & round)
+                {
+                    Lock l(_mutex);
+
+                    _pending[chain].push_back(statistics);
+
+                    for (const auto & p : _pending)
+                    {
+                        if (p.empty())
+                            return false;
+                    }
+
+                    round.clear();
+                    for (auto & p : _pending)
+                    {
+                        round.push_back(p.front());
+                        p.pop_front();
+                    }
+
+                    return true;
+                }
+        };
+
+        /*
+         * Executes jobs in the order of their submission on a dedicated thread.
+         *
+         * Used to serialize all accesses to the HDF5 output file while the chains keep running.
+         * Jobs must not throw.
+         */
+        class SerialWriter
+        {
+            private:
+                Mutex _mutex;
+
+                ConditionVariable _work_available;
+
+                std::deque<std::function<void ()>> _jobs;
+
+                bool _finished;
+
+                // construct last, since the thread uses all of the above
+                std::unique_ptr<Thread> _thread;
+
+                void loop()
+                {
+                    while (true)
+                    {
+                        std::function<void ()> job;
+
+                        {
+                            Lock l(_mutex);
+
+                            while (_jobs.empty() && (! _finished))
+                            {
+                                _work_available.wait(_mutex);
+                            }
+
+                            if (_jobs.empty())
+                                return;
+
+                            job = _jobs.front();
+                            _jobs.pop_front();
+                        }
+
+                        job();
+                    }
+                }
+
+            public:
+                SerialWriter() :
+                    _finished(false),
+                    _thread(new Thread(std::bind(&SerialWriter::loop, this)))
+                {
+                }
+
+                // complete all outstanding jobs
+                ~SerialWriter()
+                {
+                    {
+                        Lock l(_mutex);
+                        _finished = true;
+                        _work_available.signal();
+                    }
+
+                    _thread.reset();
+                }
+
+                void enqueue(const std::function<void ()> & job)
+                {
+                    Lock l(_mutex);
+                    _jobs.push_back(job);
+                    _work_available.signal();
+                }
+        };
+
+        /*
+         * Common state of all chains during an asynchronous pre-run or main-run.
+         *
+         * Each chain is advanced by a sequence of jobs, each of which submits its
+         * successor. Hence, at any time at most one job accesses a given chain.
+         */
+        struct AsynchronousRun
+        {
+            ChunkStatisticsAggregator aggregator;
+
+            // per chain; only accessed by the chain's own jobs
+            std::vector<unsigned> chunks;
+
+            // per chain; only accessed by the chain's own jobs
+            std::vector<ChainMoments> moments;
+
+            // set once the run shall stop, either due to convergence or due to an error
+            std::atomic<bool> stop;
+
+            // serializes the convergence checks
+            Mutex convergence_mutex;
+
+            // the round of chunks that was checked last
+            unsigned chunks_checked;
+
+            Mutex mutex;
+
+            ConditionVariable completion;
+
+            unsigned active_chains;
+
+            std::exception_ptr error;
+
+            SerialWriter writer;
+
+            AsynchronousRun(const unsigned & number_of_chains) :
+                aggregator(number_of_chains),
+                chunks(number_of_chains, 0),
+                moments(number_of_chains),
+                stop(false),
+                chunks_checked(0),
+                active_chains(number_of_chains)
+            {
+            }
+
+            // signal that one of the chains will not submit further jobs
+            void finish()
+            {
+                Lock l(mutex);
+
+                --active_chains;
+                if (0 == active_chains)
+                    completion.broadcast();
+            }
+
+            // run one job of a chain; on failure, record the error and stop the chain
+            void guarded(const std::function<void ()> & job)
+            {
+                try
+                {
+                    job();
+                }
+                catch (...)
+                {
+                    {
+                        Lock l(mutex);
+                        if (! error)
+                            error = std::current_exception();
+                    }
+
+                    stop = true;
+                    finish();
+                }
+            }
+
+            // wait until all chains have finished, and rethrow the first error
+            void wait()
+            {
+                {
+                    Lock l(mutex);
+
+                    while (0 != active_chains)
+                    {
+                        completion.wait(mutex);
+                    }
+                }
+
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        };
+    }
+
     template<>
     struct Implementation<MarkovChainSampler>
     {
@@ -48,9 +402,6 @@ namespace eos
         // our configuration options
         MarkovChainSampler::Config config;
 
-        // tickets for parallel computations
-        std::vector<Ticket> tickets;
-
         // number of scan parameters
         unsigned number_of_parameters;
 
@@ -84,28 +435,7 @@ namespace eos
             // loop over chains and proposal functions
             for (unsigned c = 0 ; c < chains.size() ; ++c)
             {
-                const MarkovChain::Stats & statistics = chains[c].statistics();
-                if (chains[c].history().states.empty())
-                {
-                    throw InternalError("MarkovChainSampler::adjust_scales: cannot adapt from empty history");
-                }
-
-                // rely on the fact that counters are reset in each chunk
-                double efficiency = 1.0 * statistics.iterations_accepted / (statistics.iterations_accepted + statistics.iterations_rejected);
-                if ((efficiency < config.min_efficiency) || (efficiency > config.max_efficiency))
-                    efficiencies_ok = false;
-
-                // consider only the last chunk
-                MarkovChain::State::Iterator states_begin = chains[c].history().states.end() - iterations;
-                MarkovChain::State::Iterator states_end = chains[c].history().states.end();
-
-                chains[c].proposal_function()->adapt(states_begin, states_end, efficiency, config.min_efficiency, config.max_efficiency);
-
-                Log::instance()->message("markov_chain_sampler.efficiencies", ll_debug)
-                        << "Current efficiency for chain " << c << ": " << stringify(efficiency, 4);
-
-                Log::instance()->message("markov_chain_sampler.efficiencies", ll_debug)
-                        << "invalid/rejected proposals = " << stringify(1.0 * statistics.iterations_invalid / statistics.iterations_rejected, 4);
+                efficiencies_ok = adjust_scale(c, iterations) && efficiencies_ok;
             }
             if (efficiencies_ok)
                 Log::instance()->message("markov_chain_sampler.efficiencies", ll_informational)
@@ -114,6 +444,43 @@ namespace eos
             return efficiencies_ok;
         }
 
+        /*
+         * Checks the efficiency of a single chain, and adjusts its proposal function.
+         * return true if the efficiency is in the range defined by MarkovChainConfig::min_efficiency, MarkovChainConfig::max_efficiency
+         *
+         * @param c          Index of the chain.
+         * @param iterations Consider this many iterations (counting from the end of the history) for efficiency and adaption
+         */
+        bool adjust_scale(const unsigned & c, const unsigned & iterations)
+        {
+            bool efficiency_ok = true;
+
+            const MarkovChain::Stats & statistics = chains[c].statistics();
+            if (chains[c].history().states.empty())
+            {
+                throw InternalError("MarkovChainSampler::adjust_scales: cannot adapt from empty history");
+            }
+
+            // rely on the fact that counters are reset in each chunk
+            double efficiency = 1.0 * statistics.iterations_accepted / (statistics.iterations_accepted + statistics.iterations_rejected);
+            if ((efficiency < config.min_efficiency) || (efficiency > config.max_efficiency))
+                efficiency_ok = false;
+
+            // consider only the last chunk
+            MarkovChain::State::Iterator states_begin = chains[c].history().states.end() - iterations;
+            MarkovChain::State::Iterator states_end = chains[c].history().states.end();
+
+            chains[c].proposal_function()->adapt(states_begin, states_end, efficiency, config.min_efficiency, config.max_efficiency);
+
+            Log::instance()->message("markov_chain_sampler.efficiencies", ll_debug)
+                    << "Current efficiency for chain " << c << ": " << stringify(efficiency, 4);
+
+            Log::instance()->message("markov_chain_sampler.efficiencies", ll_debug)
+                    << "invalid/rejected proposals = " << stringify(1.0 * statistics.iterations_invalid / statistics.iterations_rejected, 4);
+
+            return efficiency_ok;
+        }
+
         bool check_convergence(const unsigned & iterations)
         {
             bool efficiencies_ok = adjust_scales(iterations);
@@ -143,8 +510,6 @@ namespace eos
          */
         bool check_rvalues()
         {
-            bool all_rvalues_small = true;
-
             // calculate statistics
             std::vector<std::vector<double>> all_chains_means;
             std::vector<std::vector<double>> all_chains_variances;
@@ -159,32 +524,7 @@ namespace eos
                 all_chains_variances.push_back(variances);
             }
 
-            // loop over all parameters to check and get R-values
-            for (unsigned pmtr = 0 ; pmtr < number_of_parameters ; ++pmtr)
-            {
-                // keep subset of chain statistics in here
-                std::vector<double> chain_means, chain_variances;
-
-                // read out statistics
-                for (unsigned c = 0 ; c < config.number_of_chains ;  ++c)
-                {
-                    chain_means.push_back(all_chains_means[c][pmtr]);
-                    chain_variances.push_back(all_chains_variances[c][pmtr]);
-                }
-
-                double rvalue = compute_rvalue(chain_means, chain_variances, pre_run_info.iterations);
-                pre_run_info.rvalue_parameters[pmtr] = rvalue;
-
-                if (rvalue > config.rvalue_criterion_param || std::isnan(rvalue))
-                {
-                    all_rvalues_small = false;
-
-                    Log::instance()->message("markov_chain_sampler.parameter_rvalue_too_large", ll_informational)
-                        << "R-value of parameter '" << chains.front().parameter_descriptions()[pmtr].parameter->name()
-                        << "' is too large: "
-                        << rvalue << " > " << config.rvalue_criterion_param;
-                }
-            }
+            bool all_rvalues_small = check_rvalues(all_chains_means, all_chains_variances, pre_run_info.iterations);
 
             // posterior converged?
 #if 0
@@ -218,6 +558,51 @@ namespace eos
             return all_rvalues_small;
         }
 
+        /*!
+         * Compute the R-value of each parameter from the chains' statistics, and
+         * store them in the pre-run info.
+         *
+         * @param all_chains_means      The chains' sample means of the parameters.
+         * @param all_chains_variances  The chains' sample variances of the parameters.
+         * @param iterations            The number of iterations underlying the statistics.
+         * @return true if all R-values are small enough
+         */
+        bool check_rvalues(const std::vector<std::vector<double>> & all_chains_means,
+                const std::vector<std::vector<double>> & all_chains_variances,
+                const unsigned & iterations)
+        {
+            bool all_rvalues_small = true;
+
+            // loop over all parameters to check and get R-values
+            for (unsigned pmtr = 0 ; pmtr < number_of_parameters ; ++pmtr)
+            {
+                // keep subset of chain statistics in here
+                std::vector<double> chain_means, chain_variances;
+
+                // read out statistics
+                for (unsigned c = 0 ; c < config.number_of_chains ;  ++c)
+                {
+                    chain_means.push_back(all_chains_means[c][pmtr]);
+                    chain_variances.push_back(all_chains_variances[c][pmtr]);
+                }
+
+                double rvalue = compute_rvalue(chain_means, chain_variances, iterations);
+                pre_run_info.rvalue_parameters[pmtr] = rvalue;
+
+                if (rvalue > config.rvalue_criterion_param || std::isnan(rvalue))
+                {
+                    all_rvalues_small = false;
+
+                    Log::instance()->message("markov_chain_sampler.parameter_rvalue_too_large", ll_informational)
+                        << "R-value of parameter '" << chains.front().parameter_descriptions()[pmtr].parameter->name()
+                        << "' is too large: "
+                        << rvalue << " > " << config.rvalue_criterion_param;
+                }
+            }
+
+            return all_rvalues_small;
+        }
+
         void check_rvalues_main()
          {
             if (chains.size() < 2)
@@ -226,8 +611,6 @@ namespace eos
             Log::instance()->message("markov_chain_sampler.convergence", ll_informational)
                 << "Checking R-values for the last chunk of size " << config.chunk_size;
 
-             bool all_rvalues_small = true;
-
              // calculate statistics
             std::vector<std::vector<double>> all_chains_means;
             std::vector<std::vector<double>> all_chains_variances;
@@ -240,6 +623,17 @@ namespace eos
                 all_chains_variances.push_back(variances);
             }
 
+            check_rvalues_main(all_chains_means, all_chains_variances);
+        }
+
+        /*
+         * Check the R-values of the main run from the chains' statistics of their last chunk.
+         */
+        void check_rvalues_main(const std::vector<std::vector<double>> & all_chains_means,
+                const std::vector<std::vector<double>> & all_chains_variances)
+        {
+             bool all_rvalues_small = true;
+
              // loop over all parameters to check and get R-values
              for (unsigned par = 0 ; par < number_of_parameters ; ++par)
              {
@@ -293,6 +687,23 @@ namespace eos
             }
         }
 
+        /*
+         * Dump MCMC samples and proposal density state of a single chain to HDF5 file.
+         *
+         * @param c           Index of the chain.
+         * @param output_base The root directory name within the HDF5 file under which all samples are stored.
+         */
+        void dump_hdf5(const unsigned & c, const std::string & output_base, const unsigned & last_iterations)
+        {
+            hdf5::File file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
+
+            Log::instance()->message("markov_chain_sampler.dump_hdf5", ll_debug)
+                << "Dumping chain " << c << " to HDF5 file " << config.output_file;
+
+            chains[c].dump_history(file, output_base + "/chain #" + stringify(c), last_iterations);
+            chains[c].dump_proposal(file, output_base + "/chain #" + stringify(c));
+        }
+
         // common method to call from multiple constructors
         void initialize()
         {
@@ -406,14 +817,46 @@ namespace eos
                 c->keep_history(true);
             }
 
+            if (config.asynchronous && config.parallelize)
+            {
+                pre_run_asynchronous();
+            }
+            else
+            {
+                pre_run_synchronous();
+            }
+
+            if (pre_run_info.converged)
+            {
+                Log::instance()->message("markov_chain_sampler.prerun_converged", ll_informational)
+                    << "Pre-run has converged after " << pre_run_info.iterations_at_convergence << " iterations";
+
+                if (config.number_of_chains < 2)
+                {
+                    Log::instance()->message("markov_chain_sampler.single_chain", ll_warning)
+                        << "R-values are undefined for a single chain, so only efficiencies were adjusted";
+                }
+            }
+            else
+            {
+                Log::instance()->message("markov_chain_sampler.no_convergence", ll_warning)
+                    << "Pre-run did NOT converge!";
+            }
+        }
+
+        /*
+         * Run all chains chunk by chunk, and check for convergence after each chunk.
+         */
+        void pre_run_synchronous()
+        {
             // keep going till maxIter or  break when convergence estimated
 
             unsigned number_of_updates = 0;
             while (pre_run_info.iterations < config.prerun_iterations_min || (!pre_run_info.converged && pre_run_info.iterations
                             < config.prerun_iterations_max))
             {
-                // start with empty ticket queue
-                tickets.clear();
+                // group of parallel computations
+                TaskGroup chain_runs;
 
                 // loop over chains
                 // run each chain for N iterations
@@ -421,7 +864,7 @@ namespace eos
                 {
                     if (config.parallelize)
                     {
-                        tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&MarkovChain::run, *c, config.prerun_iterations_update)));
+                        chain_runs.run(std::bind(&MarkovChain::run, *c, config.prerun_iterations_update));
                     }
                     else
                     {
@@ -430,13 +873,7 @@ namespace eos
                 }
 
                 // wait for job completion
-                for (auto t = tickets.begin(), t_end = tickets.end(); t != t_end; ++t)
-                {
-                    t->wait();
-                }
-
-                // all tickets finished
-                tickets.clear();
+                chain_runs.wait();
 
                 pre_run_info.iterations += config.prerun_iterations_update;
                 number_of_updates++;
@@ -454,21 +891,135 @@ namespace eos
 
             if (pre_run_info.converged)
             {
-                Log::instance()->message("markov_chain_sampler.prerun_converged", ll_informational)
-                    << "Pre-run has converged after " << pre_run_info.iterations << " iterations";
+                pre_run_info.iterations_at_convergence = pre_run_info.iterations;
+            }
+        }
 
-                if (config.number_of_chains < 2)
+        /*
+         * Run all chains continuously, without waiting for each other after each chunk.
+         *
+         * Each chain publishes its statistics after each of its chunks. Convergence is
+         * checked from the most recent statistics of all chains, after which the chains
+         * stop at the end of their current chunk.
+         */
+        void pre_run_asynchronous()
+        {
+            implementation::AsynchronousRun run(chains.size());
+
+            for (unsigned c = 0 ; c < chains.size() ; ++c)
+            {
+                ThreadPool::instance()->submit([this, &run, c] () { pre_run_chunk(run, c); });
+            }
+
+            run.wait();
+
+            // the number of iterations that all chains have completed
+            pre_run_info.iterations = config.prerun_iterations_update * *std::min_element(run.chunks.cbegin(), run.chunks.cend());
+        }
+
+        void pre_run_chunk(implementation::AsynchronousRun & run, const unsigned & c)
+        {
+            run.guarded([&] ()
+            {
+                chains[c].run(config.prerun_iterations_update);
+                ++run.chunks[c];
+
+                // store state before adjusting proposal!
+                if (config.store_prerun)
                 {
-                    Log::instance()->message("markov_chain_sampler.single_chain", ll_warning)
-                        << "R-values are undefined for a single chain, so only efficiencies were adjusted";
+                    run.writer.enqueue([this, &run, c] ()
+                    {
+                        run.guarded([&] ()
+                        {
+                            dump_hdf5(c, "/prerun", config.prerun_iterations_update);
+
+                            ThreadPool::instance()->submit([this, &run, c] () { pre_run_adapt(run, c); });
+                        });
+                    });
+                }
+                else
+                {
+                    pre_run_adapt(run, c);
                 }
+            });
+        }
 
-                pre_run_info.iterations_at_convergence = pre_run_info.iterations;
+        void pre_run_adapt(implementation::AsynchronousRun & run, const unsigned & c)
+        {
+            run.guarded([&] ()
+            {
+                std::shared_ptr<implementation::ChunkStatistics> statistics(new implementation::ChunkStatistics);
+                statistics->chunks = run.chunks[c];
+                statistics->iterations = run.chunks[c] * config.prerun_iterations_update;
+                statistics->efficiency_ok = adjust_scale(c, config.prerun_iterations_update);
+
+                // only the new chunk is summarised; the earlier chunks are combined from their summaries
+                const MarkovChain::History & history = chains[c].history();
+                run.moments[c].update(history);
+                run.moments[c].mean_and_variance(history, unsigned(config.skip_initial * history.states.size()),
+                        statistics->means, statistics->variances);
+
+                Log::instance()->message("markov_chain_sampler.prerun_progress", ll_debug)
+                    << "Pre-run has completed " << statistics->iterations << " iterations of chain " << c;
+
+                // only the chain that completes a round checks for convergence
+                std::vector<std::shared_ptr<const implementation::ChunkStatistics>> round;
+                if (run.aggregator.publish(c, statistics, round))
+                {
+                    check_convergence(run, round);
+                }
+
+                if (run.stop || (statistics->iterations >= config.prerun_iterations_max))
+                {
+                    run.finish();
+                    return;
+                }
+
+                ThreadPool::instance()->submit([this, &run, c] () { pre_run_chunk(run, c); });
+            });
+        }
+
+        /*
+         * Check for convergence using the statistics of all chains after the same number of chunks.
+         */
+        void check_convergence(implementation::AsynchronousRun & run,
+                const std::vector<std::shared_ptr<const implementation::ChunkStatistics>> & round)
+        {
+            Lock l(run.convergence_mutex);
+
+            // rounds can reach this point out of order; skip those that are outdated
+            if (run.stop || (round.front()->chunks <= run.chunks_checked))
+                return;
+
+            run.chunks_checked = round.front()->chunks;
+
+            // all chains have completed the same number of iterations
+            const unsigned iterations = round.front()->iterations;
+            bool efficiencies_ok = true;
+            std::vector<std::vector<double>> all_chains_means, all_chains_variances;
+            for (const auto & s : round)
+            {
+                efficiencies_ok = efficiencies_ok && s->efficiency_ok;
+                all_chains_means.push_back(s->means);
+                all_chains_variances.push_back(s->variances);
             }
-            else
+
+            bool rvalues_ok = true;
+
+            // no R-value for single chain
+            if (chains.size() > 1)
             {
-                Log::instance()->message("markov_chain_sampler.no_convergence", ll_warning)
-                    << "Pre-run did NOT converge!";
+                rvalues_ok = check_rvalues(all_chains_means, all_chains_variances, iterations);
+            }
+
+            if (efficiencies_ok && rvalues_ok && (iterations >= config.prerun_iterations_min))
+            {
+                Log::instance()->message("markov_chain_sampler.convergence", ll_informational)
+                    << "Convergence achieved";
+
+                pre_run_info.converged = true;
+                pre_run_info.iterations_at_convergence = iterations;
+                run.stop = true;
             }
         }
 
@@ -483,11 +1034,26 @@ namespace eos
             Log::instance()->message("markov_chain_sampler.mainrun_start", ll_informational)
                 << "Commencing the main-run";
 
+            if (config.asynchronous && config.parallelize)
+            {
+                main_run_asynchronous();
+            }
+            else
+            {
+                main_run_synchronous();
+            }
+
+            Log::instance()->message("markov_chain_sampler.mainrun_end", ll_informational)
+                << "Finished the main-run";
+        }
+
+        void main_run_synchronous()
+        {
             for (unsigned chunk = 0 ; chunk < config.chunks ; ++chunk)
             {
 
-                // start with empty ticket queue
-                tickets.clear();
+                // group of parallel computations
+                TaskGroup chain_runs;
 
                 // loop over chains
                 // run each chain for N iterations
@@ -495,7 +1061,7 @@ namespace eos
                 {
                     if (config.parallelize)
                     {
-                        tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&MarkovChain::run, *c, config.chunk_size)));
+                        chain_runs.run(std::bind(&MarkovChain::run, *c, config.chunk_size));
                     }
                     else
                     {
@@ -504,13 +1070,7 @@ namespace eos
                 }
 
                 // wait for job completion
-                for (auto t = tickets.begin(), t_end = tickets.end(); t != t_end; ++t)
-                {
-                    t->wait();
-                }
-
-                // all tickets finished
-                tickets.clear();
+                chain_runs.wait();
 
                 Log::instance()->message("markov_chain_sampler.mainrun_progress", ll_informational)
                     << "Main-run has completed " << (chunk + 1) * config.chunk_size << " iterations";
@@ -539,8 +1099,132 @@ namespace eos
                 }
 
             }
-            Log::instance()->message("markov_chain_sampler.mainrun_end", ll_informational)
-                << "Finished the main-run";
+        }
+
+        /*
+         * Run all chains continuously, without waiting for each other after each chunk.
+         *
+         * The R-values are checked once all chains have completed the same chunk.
+         */
+        void main_run_asynchronous()
+        {
+            if (0 == config.chunks)
+                return;
+
+            implementation::AsynchronousRun run(chains.size());
+
+            for (unsigned c = 0 ; c < chains.size() ; ++c)
+            {
+                ThreadPool::instance()->submit([this, &run, c] () { main_run_chunk(run, c); });
+            }
+
+            run.wait();
+        }
+
+        void main_run_chunk(implementation::AsynchronousRun & run, const unsigned & c)
+        {
+            run.guarded([&] ()
+            {
+                chains[c].run(config.chunk_size);
+                ++run.chunks[c];
+
+                std::shared_ptr<implementation::ChunkStatistics> statistics(new implementation::ChunkStatistics);
+                statistics->chunks = run.chunks[c];
+                statistics->iterations = config.chunk_size;
+                statistics->efficiency_ok = true;
+
+                // statistics of the last chunk only
+                const MarkovChain::History & history = chains[c].history();
+                if ((chains.size() > 1) && (history.states.size() >= config.chunk_size) && (config.chunk_size > 0))
+                {
+                    history.mean_and_variance(history.states.cend() - config.chunk_size, history.states.cend(), statistics->means, statistics->variances);
+                }
+
+                // only the chain that completes a round reports the progress
+                std::vector<std::shared_ptr<const implementation::ChunkStatistics>> round;
+                if (run.aggregator.publish(c, statistics, round))
+                {
+                    check_progress(run, round);
+                }
+
+                if (config.store)
+                {
+                    run.writer.enqueue([this, &run, c] ()
+                    {
+                        run.guarded([&] ()
+                        {
+                            dump_hdf5(c, "/main run", config.chunk_size);
+
+                            ThreadPool::instance()->submit([this, &run, c] () { main_run_advance(run, c); });
+                        });
+                    });
+                }
+                else
+                {
+                    main_run_advance(run, c);
+                }
+            });
+        }
+
+        void main_run_advance(implementation::AsynchronousRun & run, const unsigned & c)
+        {
+            run.guarded([&] ()
+            {
+                const MarkovChain::Stats & statistics = chains[c].statistics();
+                double efficiency = 1.0 * statistics.iterations_accepted / (statistics.iterations_accepted +  statistics.iterations_rejected);
+
+                Log::instance()->message("markov_chain_sampler.mainrun_efficiencies", ll_debug)
+                        << "Current efficiency for chain " << c << ": " << efficiency;
+
+                Log::instance()->message("markov_chain_sampler.mainrun_invalid", ll_debug)
+                        << "invalid/rejected proposals = " << 1.0 * statistics.iterations_invalid / statistics.iterations_rejected;
+
+                chains[c].clear();
+
+                if (run.stop || (run.chunks[c] >= config.chunks))
+                {
+                    run.finish();
+                    return;
+                }
+
+                ThreadPool::instance()->submit([this, &run, c] () { main_run_chunk(run, c); });
+            });
+        }
+
+        /*
+         * Report the progress of the main run, and check the R-values of the same chunk of all chains.
+         */
+        void check_progress(implementation::AsynchronousRun & run,
+                const std::vector<std::shared_ptr<const implementation::ChunkStatistics>> & round)
+        {
+            Lock l(run.convergence_mutex);
+
+            // rounds can reach this point out of order; skip those that are outdated
+            const unsigned chunks = round.front()->chunks;
+            if (chunks <= run.chunks_checked)
+                return;
+
+            run.chunks_checked = chunks;
+
+            bool complete = true;
+            std::vector<std::vector<double>> all_chains_means, all_chains_variances;
+            for (const auto & s : round)
+            {
+                complete = complete && (! s->means.empty());
+                all_chains_means.push_back(s->means);
+                all_chains_variances.push_back(s->variances);
+            }
+
+            Log::instance()->message("markov_chain_sampler.mainrun_progress", ll_informational)
+                << "Main-run has completed " << chunks * config.chunk_size << " iterations";
+
+            if (! complete)
+                return;
+
+            Log::instance()->message("markov_chain_sampler.convergence", ll_informational)
+                << "Checking R-values for the last chunk of size " << config.chunk_size;
+
+            check_rvalues_main(all_chains_means, all_chains_variances);
         }
 
         void run()
@@ -674,6 +1358,7 @@ namespace eos
         number_of_chains(1, std::numeric_limits<unsigned>::max(), 4),
         seed(0),
         parallelize(true),
+        asynchronous(false),
         min_efficiency(0, 1, 0.15), // incompatible with BAT defaults [0.15, 0.5]
         max_efficiency(0, 1, 0.35),
         rvalue_criterion_param(1, 100, 1.1),
@@ -728,6 +1413,7 @@ namespace eos
                << "nchains = " << c.number_of_chains
                << ", seed = " << c.seed
                << ", parallelize = " << c.parallelize
+               << ", asynchronous = " << c.asynchronous
                << ", prerun min iterations = " << c.prerun_iterations_min << std::endl
                << ", prerun max iterations = " << c.prerun_iterations_max
                << ", prerun update iterations = " << c.prerun_iterations_update
@@ -2,7 +2,7 @@
 
 /*
  * Copyright (c) 2011, 2012, 2013 Frederik Beaujean
- * Copyright (c) 2011, 2013 Danny van Dyk
+ * Copyright (c) 2011, 2013, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -117,6 +117,22 @@ namespace eos
              * If false, use only one thread.
              */
             bool parallelize;
+
+            /*!
+             * If true, and if parallelize is true, do not synchronise the chains after each chunk.
+             * Each chain then proceeds to its next chunk right away, and publishes its chunk statistics
+             * for the convergence check. The output is written on a dedicated thread.
+             * The R-values are evaluated once all chains have completed the same number of chunks,
+             * and always compare the chains after the same number of iterations. This check therefore
+             * waits for the slowest chain, and the publication takes a short lock; a lock-free design
+             * without such a barrier was deliberately dropped, since it would compare chains of
+             * different lengths. The chains themselves never wait for each other. The means and
+             * variances of each chain are updated incrementally, chunk by chunk.
+             *
+             * @note The number of prerun iterations depends on the timing of the chains, hence
+             * independent runs with identical seeds can produce different results.
+             */
+            bool asynchronous;
             ///@}
 
             ///@name Convergence options
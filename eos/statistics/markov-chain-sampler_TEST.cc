@@ -250,5 +250,72 @@ class MarkovChainSamplerTest :
                     }
                 }
             }
+
+            // check asynchronous pre run, main run and HDF5 storage
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_asynchronous.hdf5");
+                std::remove(file_name.c_str());
+
+                unsigned prerun_iterations = 0;
+
+                TEST_SECTION("asynchronous-run-and-store",
+                {
+                    LogPosterior log_posterior(make_log_posterior(true));
+
+                    MarkovChainSampler::Config config = MarkovChainSampler::Config::Quick();
+                    config.asynchronous = true;
+                    config.chunk_size = 100;
+                    config.chunks = 6;
+                    config.max_efficiency = 0.75;
+                    config.min_efficiency = 0.20;
+                    config.need_prerun = true;
+                    config.number_of_chains = 3;
+                    config.output_file = file_name;
+                    config.parallelize = true;
+                    config.prerun_iterations_update = 500;
+                    config.prerun_iterations_min = 1000;
+                    config.proposal_initial_covariance = proposal_covariance(log_posterior, 2);
+                    config.rvalue_criterion_param = 1.1;
+                    config.scale_automatic = true;
+                    config.seed = 1346;
+                    config.store = true;
+                    config.store_prerun = true;
+                    config.use_strict_rvalue_definition = true;
+
+                    MarkovChainSampler sampler(log_posterior.clone(), config);
+                    sampler.run();
+
+                    MarkovChainSampler::PreRunInfo pre_info(sampler.pre_run_info());
+
+                    // the chains' progress depends on their timing; only check the invariants
+                    TEST_CHECK(pre_info.converged);
+                    TEST_CHECK(pre_info.iterations_at_convergence >= 1000);
+                    TEST_CHECK(pre_info.iterations >= pre_info.iterations_at_convergence);
+                    TEST_CHECK_EQUAL(pre_info.iterations % 500, 0);
+                    TEST_CHECK(pre_info.rvalue_parameters[0] < 1.1);
+
+                    prerun_iterations = pre_info.iterations;
+                });
+
+                // check sizes of data sets
+                {
+                    auto f = hdf5::File::Open(file_name);
+                    hdf5::Array<1, double> sample_type
+                    {
+                        "samples",
+                        { 1 + 1 },
+                    };
+
+                    for (unsigned c = 0 ; c < 3 ; ++c)
+                    {
+                        auto data_set_pre = f.open_data_set("/prerun/chain #" + stringify(c) + "/samples", sample_type);
+                        TEST_CHECK(data_set_pre.records() >= prerun_iterations);
+                        TEST_CHECK_EQUAL(data_set_pre.records() % 500, 0);
+
+                        auto data_set_main = f.open_data_set("/main run/chain #" + stringify(c) + "/samples", sample_type);
+                        TEST_CHECK_EQUAL(data_set_main.records(), 600);
+                    }
+                }
+            }
         }
 } markov_chain_sampler_test;
@@ -86,6 +86,7 @@ namespace eos
 
         Implementation(const DensityPtr & density, unsigned long seed, const std::shared_ptr<MarkovChain::ProposalFunction> & proposal_function) :
             density(density->clone()),
+            history{ true, MarkovChain::StateStorage(std::distance(density->begin(), density->end())) },
             sample_type
             {
                 "samples",
@@ -130,17 +131,15 @@ namespace eos
             // we could get into trouble if we attempt to create a data set a 2nd time
             auto data_set = file.create_or_open_data_set(data_set_base_name + "/samples", sample_type);
 
-            // parameter values + density
-            std::vector<double> record(sample_record_length);
-            for (auto s = history.states.cend() - last_iterations, s_end = history.states.cend() ; s != s_end ; ++s)
+            // the rows of the history already match the records of parameter values + density
+            if (last_iterations > 0)
             {
-                std::copy(s->point.cbegin(), s->point.cend(), record.begin());
-                record.back() = s->log_density;
-                data_set << record;
+                data_set.write_raw((history.states.cend() - last_iterations).row(), last_iterations);
             }
 
             /* store (mode, max log(density) */
 
+            std::vector<double> record(sample_record_length);
             auto data_set_mode = file.create_or_open_data_set(data_set_base_name + "/stats/mode", sample_type);
             std::copy(stats.parameters_at_mode.cbegin(), stats.parameters_at_mode.cend(), record.begin());
             record.back() = stats.mode;
@@ -295,6 +294,9 @@ namespace eos
             std::vector<double> record(dimension + 1);
             MarkovChain::State state;
             state.point.resize(dimension);
+            if (history.states.empty())
+                history.states = MarkovChain::StateStorage(dimension);
+            history.states.reserve(history.states.size() + data_set.records());
             for (unsigned i = 0 ; i < data_set.records() ; ++i)
             {
                 data_set >> record;
@@ -394,6 +396,12 @@ namespace eos
             // make sure everything is fine __before__ we start
             self_check();
 
+            // preallocate the history, but keep growing it geometrically across repeated runs
+            if (history.keep && (history.states.size() + iterations > history.states.capacity()))
+            {
+                history.states.reserve(std::max(history.states.size() + iterations, 2 * history.states.capacity()));
+            }
+
             // loop over iterations
             for (current_iteration = 0 ; current_iteration < iterations ; ++current_iteration)
             {
@@ -698,10 +706,33 @@ namespace eos
     {
     }
 
-    const MarkovChain::State &
+    void
+    MarkovChain::StateStorage::push_back(const MarkovChain::State & state)
+    {
+        if (_data.empty())
+        {
+            _dimension = state.point.size();
+        }
+        else if (state.point.size() != _dimension)
+        {
+            throw InternalError("MarkovChain::StateStorage::push_back: Cannot store a state of dimension " + stringify(state.point.size())
+                    + " alongside states of dimension " + stringify(_dimension));
+        }
+
+        _data.insert(_data.end(), state.point.cbegin(), state.point.cend());
+        _data.push_back(state.log_density);
+    }
+
+    void
+    MarkovChain::StateStorage::reserve(const std::size_t & states)
+    {
+        _data.reserve(states * (_dimension + 1));
+    }
+
+    MarkovChain::StateStorage::StateView
     MarkovChain::History::local_mode(const MarkovChain::State::Iterator & begin, const MarkovChain::State::Iterator & end) const
     {
-        return *std::max_element(begin, end, [](const MarkovChain::State & a, const MarkovChain::State & b) { return a.log_density < b.log_density; });
+        return *std::max_element(begin, end, [](const MarkovChain::StateStorage::StateView & a, const MarkovChain::StateStorage::StateView & b) { return a.log_density < b.log_density; });
     }
 
     void
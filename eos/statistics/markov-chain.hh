@@ -25,6 +25,7 @@
 #include <eos/utils/parameters.hh>
 #include <eos/utils/stringify.hh>
 
+#include <iterator>
 #include <vector>
 
 #include <gsl/gsl_rng.h>
@@ -41,6 +42,7 @@ namespace eos
             struct History;
             struct ProposalFunction;
             struct State;
+            class StateStorage;
             struct Stats;
 
             ///@name Basic Functions
@@ -157,13 +159,198 @@ namespace eos
             const Stats & statistics() const;
     };
 
+    /*!
+     * Contiguous storage for the states visited by a MarkovChain.
+     *
+     * All states are kept row by row in a single buffer. Each row holds the point
+     * in parameter space, followed by the log density at that point. This matches
+     * the layout of the HDF5 sample records, and allows to pass ranges of states
+     * around as lightweight views rather than copies.
+     */
+    class MarkovChain::StateStorage
+    {
+        public:
+            /// Read-only view of the point of one stored state.
+            class PointView
+            {
+                private:
+                    const double * _begin;
+
+                    const double * _end;
+
+                public:
+                    typedef const double * Iterator;
+
+                    PointView(const double * begin, const double * end) :
+                        _begin(begin),
+                        _end(end)
+                    {
+                    }
+
+                    Iterator begin() const { return _begin; }
+                    Iterator end() const { return _end; }
+                    Iterator cbegin() const { return _begin; }
+                    Iterator cend() const { return _end; }
+
+                    unsigned size() const { return _end - _begin; }
+
+                    const double & operator[] (const unsigned & i) const { return _begin[i]; }
+
+                    /// Copy the point into a vector.
+                    operator std::vector<double> () const { return std::vector<double>(_begin, _end); }
+            };
+
+            /// Read-only view of one stored state.
+            struct StateView
+            {
+                /// position in parameter space
+                PointView point;
+
+                /// log density at the point
+                double log_density;
+
+                StateView(const double * row, const unsigned & dimension) :
+                    point(row, row + dimension),
+                    log_density(row[dimension])
+                {
+                }
+            };
+
+            /// Random access iterator over the stored states.
+            class ConstIterator
+            {
+                private:
+                    const double * _row;
+
+                    unsigned _dimension;
+
+                    struct Arrow
+                    {
+                        StateView view;
+
+                        const StateView * operator-> () const { return &view; }
+                    };
+
+                public:
+                    typedef std::random_access_iterator_tag iterator_category;
+                    typedef StateView value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef Arrow pointer;
+                    typedef StateView reference;
+
+                    ConstIterator() :
+                        _row(nullptr),
+                        _dimension(0)
+                    {
+                    }
+
+                    ConstIterator(const double * row, const unsigned & dimension) :
+                        _row(row),
+                        _dimension(dimension)
+                    {
+                    }
+
+                    /// Pointer to the first element of the current row.
+                    const double * row() const { return _row; }
+
+                    StateView operator* () const { return StateView(_row, _dimension); }
+                    Arrow operator-> () const { return Arrow{ StateView(_row, _dimension) }; }
+                    StateView operator[] (const difference_type & n) const { return *(*this + n); }
+
+                    ConstIterator & operator++ () { _row += _dimension + 1; return *this; }
+                    ConstIterator & operator-- () { _row -= _dimension + 1; return *this; }
+                    ConstIterator operator++ (int) { ConstIterator result(*this); ++(*this); return result; }
+                    ConstIterator operator-- (int) { ConstIterator result(*this); --(*this); return result; }
+
+                    ConstIterator & operator+= (const difference_type & n) { _row += n * difference_type(_dimension + 1); return *this; }
+                    ConstIterator & operator-= (const difference_type & n) { _row -= n * difference_type(_dimension + 1); return *this; }
+                    ConstIterator operator+ (const difference_type & n) const { ConstIterator result(*this); return result += n; }
+                    ConstIterator operator- (const difference_type & n) const { ConstIterator result(*this); return result -= n; }
+
+                    difference_type operator- (const ConstIterator & other) const { return (_row - other._row) / difference_type(_dimension + 1); }
+
+                    bool operator== (const ConstIterator & other) const { return _row == other._row; }
+                    bool operator!= (const ConstIterator & other) const { return _row != other._row; }
+                    bool operator<  (const ConstIterator & other) const { return _row <  other._row; }
+                    bool operator>  (const ConstIterator & other) const { return _row >  other._row; }
+                    bool operator<= (const ConstIterator & other) const { return _row <= other._row; }
+                    bool operator>= (const ConstIterator & other) const { return _row >= other._row; }
+            };
+
+        private:
+            unsigned _dimension;
+
+            std::vector<double> _data;
+
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param dimension The dimension of the parameter space. If zero, it is
+             *                  taken from the first state that is stored.
+             */
+            StateStorage(const unsigned & dimension = 0) :
+                _dimension(dimension)
+            {
+            }
+            ///@}
+
+            ///@name Metadata
+            ///@{
+            /// The dimension of the parameter space.
+            unsigned dimension() const { return _dimension; }
+
+            /// The number of stored states.
+            std::size_t size() const { return _data.size() / (_dimension + 1); }
+
+            bool empty() const { return _data.empty(); }
+
+            /// The number of states that can be stored without reallocation.
+            std::size_t capacity() const { return _data.capacity() / (_dimension + 1); }
+            ///@}
+
+            ///@name Modification
+            ///@{
+            /*!
+             * Append a state.
+             *
+             * @note Fails with an exception if the state's dimension differs from
+             * the dimension of the states already stored.
+             */
+            void push_back(const MarkovChain::State & state);
+
+            /// Preallocate memory for a total of the given number of states.
+            void reserve(const std::size_t & states);
+
+            /// Remove all states, but keep the allocated memory.
+            void clear() { _data.clear(); }
+            ///@}
+
+            ///@name Access
+            ///@{
+            ConstIterator begin() const { return ConstIterator(_data.data(), _dimension); }
+            ConstIterator end() const { return ConstIterator(_data.data() + _data.size(), _dimension); }
+            ConstIterator cbegin() const { return begin(); }
+            ConstIterator cend() const { return end(); }
+
+            StateView operator[] (const std::size_t & i) const { return StateView(_data.data() + i * (_dimension + 1), _dimension); }
+            StateView front() const { return (*this)[0]; }
+            StateView back() const { return (*this)[size() - 1]; }
+
+            /// The row-major buffer of all stored states.
+            const double * data() const { return _data.data(); }
+            ///@}
+    };
+
     /*!
      * Summarize info at current position
      * in parameter space
      */
     struct MarkovChain::State
     {
-        typedef std::vector<State>::const_iterator Iterator;
+        typedef MarkovChain::StateStorage::ConstIterator Iterator;
 
         /// position in parameter space
         std::vector<double> point;
@@ -183,6 +370,13 @@ namespace eos
             point.resize(other.point.size());
             std::copy(other.point.cbegin(), other.point.cend(), point.begin());
         }
+
+        /// Copy a stored state.
+        State(const MarkovChain::StateStorage::StateView & other) :
+            point(other.point.cbegin(), other.point.cend()),
+            log_density(other.log_density)
+        {
+        }
     };
 
     /*!
@@ -244,12 +438,12 @@ namespace eos
             bool keep;
 
             /// All states.
-            std::vector<MarkovChain::State> states;
+            MarkovChain::StateStorage states;
 
             /*!
              * Return state with highest density in selected range
              */
-            const MarkovChain::State & local_mode(const MarkovChain::State::Iterator & begin, const MarkovChain::State::Iterator & end) const;
+            MarkovChain::StateStorage::StateView local_mode(const MarkovChain::State::Iterator & begin, const MarkovChain::State::Iterator & end) const;
 
             /*!
              * Compute mean and variance of the states' parameters between begin and end
@@ -71,6 +71,9 @@ class MarkovChainTest :
                 MarkovChain chain1(log_posterior.clone(), 13, ppf1);
                 MarkovChain chain2(log_posterior.clone(), 13134, ppf2);
 
+                // the history is laid out for the chain's dimension before the first run
+                TEST_CHECK_EQUAL(chain1.history().states.dimension(), 1);
+
                 double mB1_before(chain1.parameter_descriptions().front().parameter->evaluate());
                 double mB2_before(chain2.parameter_descriptions().front().parameter->evaluate());
 
@@ -80,6 +83,9 @@ class MarkovChainTest :
                 if (chain1.parameter_descriptions().front().parameter->evaluate() == mB1_before)
                     TEST_CHECK_FAILED("chain1 did not move");
 
+                TEST_CHECK_EQUAL(chain1.history().states.size(), 300);
+                TEST_CHECK(chain1.history().states.capacity() >= 300);
+
                 // running chain1 shouldn't affect chain2
                 TEST_CHECK_EQUAL(mB2_before, chain2.parameter_descriptions().front().parameter->evaluate());
             });
@@ -545,6 +551,50 @@ class MarkovChainTest :
 
                 TEST_CHECK_THROWS(InternalError, history.mean_and_variance(it, it, means, variances));
             }
+
+            // test contiguous storage of the History
+            {
+                MarkovChain::History history{ true, MarkovChain::StateStorage(2) };
+                history.states.reserve(3);
+                TEST_CHECK(history.states.empty());
+                TEST_CHECK(history.states.capacity() >= 3);
+
+                MarkovChain::State s;
+                s.point = std::vector<double> { 1.2, 3.3 };
+                s.log_density = -1.0;
+                history.states.push_back(s);
+                s.point = std::vector<double> { 2.3, 4.5 };
+                s.log_density = -0.5;
+                history.states.push_back(s);
+                s.point = std::vector<double> { 2.8, 4.1 };
+                s.log_density = -2.0;
+                history.states.push_back(s);
+
+                TEST_CHECK_EQUAL(history.states.size(), 3);
+                TEST_CHECK_EQUAL(history.states.dimension(), 2);
+                TEST_CHECK_EQUAL(std::distance(history.states.cbegin(), history.states.cend()), 3);
+
+                // rows are laid out as point followed by log density
+                const std::vector<double> reference { 1.2, 3.3, -1.0, 2.3, 4.5, -0.5, 2.8, 4.1, -2.0 };
+                TEST_CHECK(std::equal(reference.cbegin(), reference.cend(), history.states.data()));
+
+                // views refer to the stored rows
+                TEST_CHECK_EQUAL(history.states[1].point.cbegin(), history.states.data() + 3);
+                TEST_CHECK_EQUAL((history.states.cend() - 1)->log_density, -2.0);
+
+                MarkovChain::State mode = history.local_mode(history.states.cbegin(), history.states.cend());
+                TEST_CHECK_EQUAL(mode.point[0], 2.3);
+                TEST_CHECK_EQUAL(mode.point[1], 4.5);
+                TEST_CHECK_EQUAL(mode.log_density, -0.5);
+
+                s.point = std::vector<double> { 1.0 };
+                TEST_CHECK_THROWS(InternalError, history.states.push_back(s));
+
+                history.states.clear();
+                TEST_CHECK(history.states.empty());
+                history.states.push_back(s);
+                TEST_CHECK_EQUAL(history.states.dimension(), 1);
+            }
             // random index
           {
                 gsl_rng * rng;
@@ -380,8 +380,8 @@ namespace eos
 
             const unsigned n_dim = std::distance(density->begin(), density->end());
 
-            // tickets for parallel computations
-            std::vector<Ticket> tickets;
+            // group of parallel computations
+            TaskGroup computations;
 
             Log::instance()->message("PMC_sampler.status", ll_debug)
                 << "Workers started";
@@ -400,7 +400,7 @@ namespace eos
                 if (config.parallelize)
                     // make sure to pass the pointer, instead of a reference from *w, to bind.
                     // Else temporary copies are created.
-                    tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&pmc::Worker::work, workers[i].get())));
+                    computations.run(std::bind(&pmc::Worker::work, workers[i].get()));
                 else
                     workers[i]->work();
             }
@@ -409,8 +409,7 @@ namespace eos
             posterior_values.clear();
 
             // wait for job completion
-            for (auto t = tickets.begin(), t_end = tickets.end() ; t != t_end ; ++t)
-                t->wait();
+            computations.wait();
 
             // copy results and free memory
             for (auto w = workers.begin(), w_end = workers.end() ; w != w_end ; ++w)
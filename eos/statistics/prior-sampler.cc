@@ -96,20 +96,14 @@ namespace eos
             {
                 // write observables
                 auto observable_data_set = file->create_or_open_data_set("/data/observables", observable_type);
-                for (auto o = observable_samples.cbegin(), o_end = observable_samples.cend() ; o != o_end ; ++o)
-                {
-                    observable_data_set << *o;
-                }
+                observable_data_set.write_block(observable_samples.cbegin(), observable_samples.cend());
 
                 // write parameters
                 if ( ! store_parameters)
                     return;
 
                 auto parameter_data_set = file->create_or_open_data_set("/data/parameters", parameter_type);
-                for (auto p = parameter_samples.cbegin(), p_end = parameter_samples.cend() ; p != p_end ; ++p)
-                {
-                    parameter_data_set << *p;
-                }
+                parameter_data_set.write_block(parameter_samples.cbegin(), parameter_samples.cend());
             }
 
             /*!
@@ -212,9 +206,6 @@ namespace eos
         // min, max, nuisance
         hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>> parameter_descriptions_type;
 
-        // tickets for parallel computations
-        std::vector<Ticket> tickets;
-
         Implementation(const ObservableSet & observables, const PriorSampler::Config & config) :
             config(config),
             observables(observables),
@@ -282,8 +273,8 @@ namespace eos
             // setup the scan file
             setup_output();
 
-            // start with empty ticket queue
-            tickets.clear();
+            // group of parallel computations
+            TaskGroup computations;
 
             const bool draw = samples.empty();
 
@@ -324,7 +315,7 @@ namespace eos
                 {
                     // make sure to pass the pointer, instead of a reference from *w, to bind.
                     // Else copies are created, which lead to a double freeing upon calling the destructor the 2nd time.
-                    tickets.push_back(ThreadPool::instance()->enqueue(f));
+                    computations.run(f);
                 }
                 else
                 {
@@ -333,10 +324,7 @@ namespace eos
             }
 
             // wait for job completion
-            for (auto t = tickets.begin(), t_end = tickets.end() ; t != t_end ; ++t)
-            {
-                t->wait();
-            }
+            computations.wait();
 
             // retrieve data and delete workers
             for (auto w = workers.begin(), w_end = workers.end() ; w != w_end ; ++w)
@@ -344,9 +332,6 @@ namespace eos
                 (**w).dump_history(config.output_file, config.store_parameters);
             }
 
-            // all tickets finished
-            tickets.clear();
-
             Log::instance()->message("prior_sampler.run", ll_informational)
                         << "Observable computations completed.";
         }
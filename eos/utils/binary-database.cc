@@ -0,0 +1,458 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/utils/binary-database.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fs = boost::filesystem;
+
+namespace eos
+{
+    namespace
+    {
+        const char magic[8] = { 'E', 'O', 'S', 'D', 'B', '0', '0', '2' };
+
+        // magic, digest, number of records
+        const std::size_t header_size = sizeof(magic) + 2 * sizeof(std::uint64_t);
+
+        // key offset, key size, value offset, value size
+        const std::size_t entry_size = 4 * sizeof(std::uint64_t);
+
+        std::uint64_t read_unsigned(const char * data)
+        {
+            std::uint64_t result;
+            std::memcpy(&result, data, sizeof(std::uint64_t));
+
+            return result;
+        }
+
+        /*
+         * 64 bit FNV-1a hash, applied to eight bytes at a time, with the length appended
+         * such that the boundaries between consecutive strings are part of the digest.
+         */
+        void hash(std::uint64_t & digest, const std::string & data)
+        {
+            static const std::uint64_t prime = 0x100000001b3ull;
+
+            std::size_t i = 0;
+            for ( ; i + sizeof(std::uint64_t) <= data.size() ; i += sizeof(std::uint64_t))
+            {
+                digest = (digest ^ read_unsigned(data.data() + i)) * prime;
+            }
+
+            for ( ; i < data.size() ; ++i)
+            {
+                digest = (digest ^ static_cast<unsigned char>(data[i])) * prime;
+            }
+
+            digest = (digest ^ std::uint64_t(data.size())) * prime;
+        }
+    }
+
+    BinaryDatabaseError::BinaryDatabaseError(const std::string & file, const std::string & msg) :
+        Exception("Binary database '" + file + "': " + msg)
+    {
+    }
+
+    template <>
+    struct Implementation<BinaryDatabase>
+    {
+        std::string file;
+
+        const char * data;
+
+        std::size_t data_size;
+
+        std::size_t size;
+
+        Implementation(const std::string & file) :
+            file(file),
+            data(nullptr),
+            data_size(0),
+            size(0)
+        {
+            int fd = ::open(file.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw BinaryDatabaseError(file, "cannot open file");
+
+            struct stat st;
+            if (0 != ::fstat(fd, &st))
+            {
+                ::close(fd);
+                throw BinaryDatabaseError(file, "cannot determine file size");
+            }
+            data_size = st.st_size;
+
+            if (data_size < header_size)
+            {
+                ::close(fd);
+                throw BinaryDatabaseError(file, "file is too short");
+            }
+
+            void * mapping = ::mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (MAP_FAILED == mapping)
+                throw BinaryDatabaseError(file, "cannot map file");
+
+            data = static_cast<const char *>(mapping);
+
+            try
+            {
+                validate();
+            }
+            catch (...)
+            {
+                ::munmap(const_cast<char *>(data), data_size);
+                throw;
+            }
+        }
+
+        ~Implementation()
+        {
+            ::munmap(const_cast<char *>(data), data_size);
+        }
+
+        void validate()
+        {
+            if (0 != std::memcmp(data, magic, sizeof(magic)))
+                throw BinaryDatabaseError(file, "unknown file format");
+
+            size = read_unsigned(data + sizeof(magic) + sizeof(std::uint64_t));
+
+            if ((data_size - header_size) / (entry_size + sizeof(std::uint64_t)) < size)
+                throw BinaryDatabaseError(file, "file is too short for " + stringify(size) + " records");
+
+            for (std::size_t i = 0 ; i < size ; ++i)
+            {
+                const char * entry = data + header_size + i * entry_size;
+                for (unsigned j = 0 ; j < 4 ; j += 2)
+                {
+                    const std::uint64_t offset = read_unsigned(entry + j * sizeof(std::uint64_t));
+                    const std::uint64_t length = read_unsigned(entry + (j + 1) * sizeof(std::uint64_t));
+
+                    if ((offset > data_size) || (length > data_size - offset))
+                        throw BinaryDatabaseError(file, "record " + stringify(i) + " exceeds the file");
+                }
+
+                if (read_unsigned(index() + i * sizeof(std::uint64_t)) >= size)
+                    throw BinaryDatabaseError(file, "invalid index entry " + stringify(i));
+            }
+        }
+
+        const char * entry(const std::size_t & i) const
+        {
+            return data + header_size + i * entry_size;
+        }
+
+        const char * index() const
+        {
+            return entry(size);
+        }
+
+        BinaryDatabase::Record key(const std::size_t & i) const
+        {
+            const char * e = entry(i);
+
+            return BinaryDatabase::Record{ data + read_unsigned(e), std::size_t(read_unsigned(e + sizeof(std::uint64_t))) };
+        }
+
+        BinaryDatabase::Record value(const std::size_t & i) const
+        {
+            const char * e = entry(i);
+
+            return BinaryDatabase::Record{ data + read_unsigned(e + 2 * sizeof(std::uint64_t)), std::size_t(read_unsigned(e + 3 * sizeof(std::uint64_t))) };
+        }
+
+        static int compare(const BinaryDatabase::Record & lhs, const std::string & rhs)
+        {
+            int result = std::memcmp(lhs.data, rhs.data(), std::min(lhs.size, rhs.size()));
+            if (0 != result)
+                return result;
+
+            if (lhs.size == rhs.size())
+                return 0;
+
+            return lhs.size < rhs.size() ? -1 : +1;
+        }
+    };
+
+    BinaryDatabase::BinaryDatabase(const std::string & file) :
+        PrivateImplementationPattern<BinaryDatabase>(new Implementation<BinaryDatabase>(file))
+    {
+    }
+
+    BinaryDatabase::~BinaryDatabase()
+    {
+    }
+
+    std::size_t
+    BinaryDatabase::size() const
+    {
+        return _imp->size;
+    }
+
+    std::uint64_t
+    BinaryDatabase::digest() const
+    {
+        return read_unsigned(_imp->data + sizeof(magic));
+    }
+
+    std::string
+    BinaryDatabase::key(const std::size_t & index) const
+    {
+        if (index >= _imp->size)
+            throw InternalError("BinaryDatabase::key: invalid index '" + stringify(index) + "'");
+
+        return _imp->key(index).str();
+    }
+
+    BinaryDatabase::Record
+    BinaryDatabase::value(const std::size_t & index) const
+    {
+        if (index >= _imp->size)
+            throw InternalError("BinaryDatabase::value: invalid index '" + stringify(index) + "'");
+
+        return _imp->value(index);
+    }
+
+    bool
+    BinaryDatabase::find(const std::string & key, Record & value) const
+    {
+        // binary search in the sorted index
+        std::size_t lower = 0, upper = _imp->size;
+        while (lower < upper)
+        {
+            const std::size_t middle = lower + (upper - lower) / 2;
+            const std::size_t i = read_unsigned(_imp->index() + middle * sizeof(std::uint64_t));
+
+            int comparison = Implementation<BinaryDatabase>::compare(_imp->key(i), key);
+            if (0 == comparison)
+            {
+                value = _imp->value(i);
+                return true;
+            }
+
+            if (comparison < 0)
+                lower = middle + 1;
+            else
+                upper = middle;
+        }
+
+        return false;
+    }
+
+    void
+    BinaryDatabase::write(const std::string & file, const std::vector<std::pair<std::string, std::string>> & records,
+            const std::uint64_t & digest)
+    {
+        const std::uint64_t size = records.size();
+
+        std::vector<std::uint64_t> index(size);
+        for (std::uint64_t i = 0 ; i < size ; ++i)
+        {
+            index[i] = i;
+        }
+        std::sort(index.begin(), index.end(), [&] (const std::uint64_t & a, const std::uint64_t & b) { return records[a].first < records[b].first; });
+
+        for (std::uint64_t i = 1 ; i < size ; ++i)
+        {
+            if (records[index[i - 1]].first == records[index[i]].first)
+                throw BinaryDatabaseError(file, "duplicate key '" + records[index[i]].first + "'");
+        }
+
+        std::vector<std::uint64_t> header;
+        header.reserve(2 + 4 * size + size);
+        header.push_back(digest);
+        header.push_back(size);
+
+        std::uint64_t offset = sizeof(magic) + (2 + 4 * size + size) * sizeof(std::uint64_t);
+        for (const auto & r : records)
+        {
+            header.push_back(offset);
+            header.push_back(r.first.size());
+            offset += r.first.size();
+
+            header.push_back(offset);
+            header.push_back(r.second.size());
+            offset += r.second.size();
+        }
+        header.insert(header.end(), index.cbegin(), index.cend());
+
+        // write to a temporary file first, so that readers never see a partial database
+        const std::string temporary = file + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (! out)
+                throw BinaryDatabaseError(file, "cannot open '" + temporary + "' for writing");
+
+            out.write(magic, sizeof(magic));
+            out.write(reinterpret_cast<const char *>(header.data()), header.size() * sizeof(std::uint64_t));
+            for (const auto & r : records)
+            {
+                out.write(r.first.data(), r.first.size());
+                out.write(r.second.data(), r.second.size());
+            }
+
+            if (! out)
+                throw BinaryDatabaseError(file, "cannot write to '" + temporary + "'");
+        }
+
+        fs::rename(temporary, file);
+    }
+
+    std::uint64_t
+    BinaryDatabase::input_digest(const std::string & directory, const std::string & extension)
+    {
+        std::vector<fs::path> inputs;
+        for (fs::directory_iterator f(directory), f_end ; f != f_end ; ++f)
+        {
+            auto file_path = f->path();
+
+            if (! fs::is_regular_file(fs::status(file_path)))
+                continue;
+
+            if (extension != file_path.extension().string())
+                continue;
+
+            inputs.push_back(file_path);
+        }
+        std::sort(inputs.begin(), inputs.end());
+
+        std::uint64_t result = 0xcbf29ce484222325ull;
+        for (const auto & input : inputs)
+        {
+            std::ifstream in(input.string(), std::ios::binary);
+            if (! in)
+                throw BinaryDatabaseError(input.string(), "cannot read input file");
+
+            hash(result, input.filename().string());
+            hash(result, std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+        }
+
+        return result;
+    }
+
+    bool
+    BinaryDatabase::up_to_date(const std::string & file, const std::string & directory, const std::string & extension)
+    {
+        boost::system::error_code ec;
+        if (! fs::exists(file, ec))
+            return false;
+
+        try
+        {
+            BinaryDatabase database(file);
+
+            return database.digest() == input_digest(directory, extension);
+        }
+        catch (BinaryDatabaseError &)
+        {
+            return false;
+        }
+        catch (fs::filesystem_error &)
+        {
+            return false;
+        }
+    }
+
+    BinaryRecordWriter &
+    BinaryRecordWriter::operator<< (const double & value)
+    {
+        _buffer.append(reinterpret_cast<const char *>(&value), sizeof(double));
+
+        return *this;
+    }
+
+    BinaryRecordWriter &
+    BinaryRecordWriter::operator<< (const std::uint64_t & value)
+    {
+        _buffer.append(reinterpret_cast<const char *>(&value), sizeof(std::uint64_t));
+
+        return *this;
+    }
+
+    BinaryRecordWriter &
+    BinaryRecordWriter::operator<< (const std::string & value)
+    {
+        *this << std::uint64_t(value.size());
+        _buffer.append(value);
+
+        return *this;
+    }
+
+    BinaryRecordReader::BinaryRecordReader(const BinaryDatabase::Record & record) :
+        _current(record.data),
+        _end(record.data + record.size)
+    {
+    }
+
+    const char *
+    BinaryRecordReader::advance(const std::size_t & size)
+    {
+        if (std::size_t(_end - _current) < size)
+            throw InternalError("BinaryRecordReader: attempted to read beyond the end of the record");
+
+        const char * result = _current;
+        _current += size;
+
+        return result;
+    }
+
+    BinaryRecordReader &
+    BinaryRecordReader::operator>> (double & value)
+    {
+        std::memcpy(&value, advance(sizeof(double)), sizeof(double));
+
+        return *this;
+    }
+
+    BinaryRecordReader &
+    BinaryRecordReader::operator>> (std::uint64_t & value)
+    {
+        std::memcpy(&value, advance(sizeof(std::uint64_t)), sizeof(std::uint64_t));
+
+        return *this;
+    }
+
+    BinaryRecordReader &
+    BinaryRecordReader::operator>> (std::string & value)
+    {
+        std::uint64_t size;
+        *this >> size;
+
+        const char * data = advance(size);
+        value.assign(data, size);
+
+        return *this;
+    }
+}
@@ -0,0 +1,182 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_UTILS_BINARY_DATABASE_HH
+#define EOS_GUARD_EOS_UTILS_BINARY_DATABASE_HH 1
+
+#include <eos/utils/exception.hh>
+#include <eos/utils/instantiation_policy.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * BinaryDatabaseError is thrown when a binary database file cannot be
+     * read or written, or when its contents are malformed.
+     */
+    struct BinaryDatabaseError :
+        public Exception
+    {
+        BinaryDatabaseError(const std::string & file, const std::string & msg);
+    };
+
+    /*!
+     * BinaryDatabase provides read-only access to a memory-mapped file of
+     * named records.
+     *
+     * The records keep the order in which they were written. Lookup by key uses
+     * a sorted index, and does not touch any other record. The file layout is
+     *
+     *   - the magic string "EOSDB002" (8 bytes),
+     *   - the digest of the input files, see input_digest(),
+     *   - the number of records N as a 64 bit unsigned integer,
+     *   - N entries of { key offset, key size, value offset, value size },
+     *   - N record numbers, sorted by their keys,
+     *   - the keys and values,
+     *
+     * where all integers are 64 bit unsigned integers in host byte order, and all
+     * offsets are relative to the beginning of the file.
+     */
+    class BinaryDatabase :
+        public InstantiationPolicy<BinaryDatabase, NonCopyable>,
+        public PrivateImplementationPattern<BinaryDatabase>
+    {
+        public:
+            /*!
+             * A view of one record's value within the mapped file.
+             */
+            struct Record
+            {
+                const char * data;
+                std::size_t size;
+
+                std::string str() const { return std::string(data, size); }
+            };
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param file The name of the database file to be mapped.
+             */
+            BinaryDatabase(const std::string & file);
+
+            /// Destructor.
+            ~BinaryDatabase();
+            ///@}
+
+            /// The number of records.
+            std::size_t size() const;
+
+            /// The digest of the input files from which the database was compiled.
+            std::uint64_t digest() const;
+
+            /// Retrieve the key of the record with a given index.
+            std::string key(const std::size_t & index) const;
+
+            /// Retrieve the value of the record with a given index.
+            Record value(const std::size_t & index) const;
+
+            /*!
+             * Look up a record by its key.
+             *
+             * @param key   The key of the record.
+             * @param value Returns the value of the record, if found.
+             * @return true if the record exists.
+             */
+            bool find(const std::string & key, Record & value) const;
+
+            /*!
+             * Write a database file.
+             *
+             * @param file    The name of the database file.
+             * @param records The records as pairs of key and value. Keys must be unique.
+             * @param digest  The digest of the input files, see input_digest().
+             */
+            static void write(const std::string & file, const std::vector<std::pair<std::string, std::string>> & records,
+                    const std::uint64_t & digest = 0);
+
+            /*!
+             * Compute a digest of the names and contents of all input files in a directory.
+             *
+             * The digest does not depend on the files' time stamps, nor on the order of the
+             * directory entries.
+             *
+             * @param directory The directory of the input files.
+             * @param extension The extension of the input files.
+             */
+            static std::uint64_t input_digest(const std::string & directory, const std::string & extension = ".yaml");
+
+            /*!
+             * Check if a database file exists, is readable, and was compiled from
+             * the current input files in a directory.
+             *
+             * @param file      The name of the database file.
+             * @param directory The directory of the input files.
+             * @param extension The extension of the input files.
+             */
+            static bool up_to_date(const std::string & file, const std::string & directory, const std::string & extension = ".yaml");
+    };
+
+    /*!
+     * BinaryRecordWriter serializes numbers and strings into the value of one record.
+     */
+    class BinaryRecordWriter
+    {
+        private:
+            std::string _buffer;
+
+        public:
+            BinaryRecordWriter & operator<< (const double &);
+            BinaryRecordWriter & operator<< (const std::uint64_t &);
+            BinaryRecordWriter & operator<< (const std::string &);
+
+            const std::string & str() const { return _buffer; }
+    };
+
+    /*!
+     * BinaryRecordReader deserializes the numbers and strings written by a BinaryRecordWriter.
+     */
+    class BinaryRecordReader
+    {
+        private:
+            const char * _current;
+            const char * const _end;
+
+            const char * advance(const std::size_t & size);
+
+        public:
+            BinaryRecordReader(const BinaryDatabase::Record & record);
+
+            BinaryRecordReader & operator>> (double &);
+            BinaryRecordReader & operator>> (std::uint64_t &);
+            BinaryRecordReader & operator>> (std::string &);
+
+            /// Whether all data has been read.
+            bool done() const { return _current == _end; }
+    };
+}
+
+#endif
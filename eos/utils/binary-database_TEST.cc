@@ -0,0 +1,180 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <config.h>
+#include <test/test.hh>
+#include <eos/utils/binary-database.hh>
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+
+#include <boost/filesystem/operations.hpp>
+
+using namespace test;
+using namespace eos;
+
+class BinaryDatabaseTest :
+    public TestCase
+{
+    public:
+        BinaryDatabaseTest() :
+            TestCase("binary_database_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const std::string filename(EOS_BUILDDIR "/eos/utils/binary-database_TEST.db");
+            std::remove(filename.c_str());
+
+            // Write and read back records
+            {
+                BinaryRecordWriter writer;
+                writer << 1.5 << std::uint64_t(17) << std::string("foo") << std::string("");
+
+                std::vector<std::pair<std::string, std::string>> records
+                {
+                    { "zeta",  "last key, first record" },
+                    { "alpha", writer.str()             },
+                    { "mu",    ""                       },
+                };
+                BinaryDatabase::write(filename, records);
+
+                BinaryDatabase database(filename);
+                TEST_CHECK_EQUAL(3, database.size());
+
+                // records keep their order
+                TEST_CHECK_EQUAL("zeta",  database.key(0));
+                TEST_CHECK_EQUAL("alpha", database.key(1));
+                TEST_CHECK_EQUAL("mu",    database.key(2));
+
+                BinaryDatabase::Record value;
+                TEST_CHECK(database.find("zeta", value));
+                TEST_CHECK_EQUAL("last key, first record", value.str());
+                TEST_CHECK(database.find("mu", value));
+                TEST_CHECK_EQUAL(0, value.size);
+                TEST_CHECK(! database.find("beta", value));
+                TEST_CHECK(! database.find("", value));
+                TEST_CHECK(! database.find("zetaa", value));
+
+                TEST_CHECK(database.find("alpha", value));
+                BinaryRecordReader reader(value);
+                double d;
+                std::uint64_t u;
+                std::string s1, s2;
+                reader >> d >> u >> s1 >> s2;
+                TEST_CHECK_EQUAL(1.5, d);
+                TEST_CHECK_EQUAL(17, u);
+                TEST_CHECK_EQUAL("foo", s1);
+                TEST_CHECK_EQUAL("", s2);
+                TEST_CHECK(reader.done());
+                TEST_CHECK_THROWS(InternalError, reader >> d);
+            }
+
+            // Duplicate keys
+            {
+                std::vector<std::pair<std::string, std::string>> records
+                {
+                    { "foo", "1" },
+                    { "foo", "2" },
+                };
+                TEST_CHECK_THROWS(BinaryDatabaseError, BinaryDatabase::write(filename + ".duplicate", records));
+            }
+
+            // Malformed files
+            {
+                TEST_CHECK_THROWS(BinaryDatabaseError, BinaryDatabase(filename + ".does-not-exist"));
+
+                {
+                    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+                    out << "EOSDB002" << std::string(16, '\xff');
+                }
+                TEST_CHECK_THROWS(BinaryDatabaseError, BinaryDatabase database(filename));
+
+                {
+                    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+                    out << "this is not a database";
+                }
+                TEST_CHECK_THROWS(BinaryDatabaseError, BinaryDatabase database(filename));
+            }
+
+            // Up-to-date check
+            {
+                const std::string directory = filename + ".inputs";
+                boost::filesystem::remove_all(directory);
+                boost::filesystem::create_directory(directory);
+
+                const std::string input = directory + "/a.input";
+                {
+                    std::ofstream out(input);
+                    out << "input";
+                }
+
+                BinaryDatabase::write(filename, { { "foo", "bar" } }, BinaryDatabase::input_digest(directory, ".input"));
+                TEST_CHECK(! BinaryDatabase::up_to_date(filename + ".does-not-exist", directory, ".input"));
+                TEST_CHECK(BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                // the digest ignores files with other extensions
+                {
+                    std::ofstream out(directory + "/b.other");
+                    out << "other";
+                }
+                TEST_CHECK(BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                // modification times do not matter, only the contents
+                const std::time_t now = boost::filesystem::last_write_time(filename);
+                boost::filesystem::last_write_time(input, now + 10);
+                TEST_CHECK(BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                {
+                    std::ofstream out(input, std::ios::trunc);
+                    out << "inpuT";
+                }
+                boost::filesystem::last_write_time(input, now - 10);
+                TEST_CHECK(! BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                // renaming or adding input files changes the digest
+                BinaryDatabase::write(filename, { { "foo", "bar" } }, BinaryDatabase::input_digest(directory, ".input"));
+                TEST_CHECK(BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                boost::filesystem::rename(input, directory + "/c.input");
+                TEST_CHECK(! BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                boost::filesystem::rename(directory + "/c.input", input);
+                TEST_CHECK(BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                {
+                    std::ofstream out(directory + "/d.input");
+                }
+                TEST_CHECK(! BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                // a malformed database is never up to date
+                {
+                    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+                    out << "this is not a database";
+                }
+                TEST_CHECK(! BinaryDatabase::up_to_date(filename, directory, ".input"));
+
+                boost::filesystem::remove_all(directory);
+            }
+
+            std::remove(filename.c_str());
+        }
+} binary_database_test;
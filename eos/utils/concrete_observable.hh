@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2015, 2016, 2017 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2015, 2016, 2017, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -23,15 +23,92 @@
 #include <eos/observable-impl.hh>
 #include <eos/utils/apply.hh>
 #include <eos/utils/join.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/tuple-maker.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
 #include <array>
 #include <functional>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 
 namespace eos
 {
+    namespace impl
+    {
+        /*
+         * Retrieve a decay object for the given parameters and options.
+         *
+         * Decay objects are interned by their type, the identity of the Parameters
+         * object and the options. Observables of the same process that only differ in
+         * their kinematics therefore share one decay object, including its form factors
+         * and its model. The table holds weak references to the decay objects only. A decay
+         * object is destroyed along with the last observable that uses it, and its entry,
+         * including the key's reference to the Parameters, is removed at the same time.
+         *
+         * Decay objects may change their members temporarily while evaluating an observable.
+         * Observables that share a decay object therefore report it through
+         * Observable::shared_objects(), and must not be evaluated concurrently.
+         */
+        template <typename Decay_>
+        std::shared_ptr<const Decay_> make_shared_decay(const Parameters & parameters, const Options & options)
+        {
+            using Key = std::pair<Parameters, std::string>;
+
+            struct Entry
+            {
+                std::weak_ptr<const Decay_> decay;
+
+                // identifies the decay object whose deleter may remove this entry
+                const Decay_ * pointer;
+            };
+
+            struct Table
+            {
+                Mutex mutex;
+
+                std::map<Key, Entry> entries;
+            };
+
+            // never destroyed, since decay objects might outlive the static destructors
+            static Table * table = new Table;
+
+            const Key key(parameters, options.as_string());
+
+            Lock l(table->mutex);
+
+            auto e = table->entries.find(key);
+            if (table->entries.end() != e)
+            {
+                std::shared_ptr<const Decay_> decay = e->second.decay.lock();
+
+                if (decay)
+                    return decay;
+            }
+
+            const Decay_ * pointer = new Decay_(parameters, options);
+            std::shared_ptr<const Decay_> result(pointer, [key] (const Decay_ * decay)
+            {
+                {
+                    Lock l(table->mutex);
+
+                    // the entry might have been replaced after the last reference expired
+                    auto e = table->entries.find(key);
+                    if ((table->entries.end() != e) && (decay == e->second.pointer))
+                        table->entries.erase(e);
+                }
+
+                delete decay;
+            });
+            table->entries[key] = Entry{ result, pointer };
+
+            return result;
+        }
+    }
+
     template <typename Decay_, typename ... Args_>
     class ConcreteObservable :
         public Observable
@@ -47,7 +124,7 @@ namespace eos
 
             Options _options;
 
-            Decay_ _decay;
+            std::shared_ptr<const Decay_> _decay;
 
             std::function<double (const Decay_ *, const Args_ & ...)> _function;
 
@@ -66,12 +143,12 @@ namespace eos
                 _parameters(parameters),
                 _kinematics(kinematics),
                 _options(options),
-                _decay(parameters, options),
+                _decay(impl::make_shared_decay<Decay_>(parameters, options)),
                 _function(function),
                 _kinematics_names(kinematics_names),
-                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, &_decay))
+                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, _decay.get()))
             {
-                uses(_decay);
+                uses(*_decay);
             }
 
             virtual const QualifiedName & name() const
@@ -101,6 +178,11 @@ namespace eos
                 return _options;
             }
 
+            virtual std::vector<const void *> shared_objects() const
+            {
+                return std::vector<const void *>{ _decay.get() };
+            }
+
             virtual ObservablePtr clone() const
             {
                 return ObservablePtr(new ConcreteObservable(_name, _parameters.clone(), _kinematics.clone(), _options, _function, _kinematics_names));
@@ -208,7 +290,7 @@ namespace eos
 
             Options _options, _forced_options_numerator, _forced_options_denominator;
 
-            Decay_ _decay_numerator, _decay_denominator;
+            std::shared_ptr<const Decay_> _decay_numerator, _decay_denominator;
 
             std::function<double (const Decay_ *, const Args_ & ...)> _numerator, _denominator;
 
@@ -233,17 +315,17 @@ namespace eos
                 _options(options),
                 _forced_options_numerator(forced_options_numerator),
                 _forced_options_denominator(forced_options_denominator),
-                _decay_numerator(parameters, options + _forced_options_numerator),
-                _decay_denominator(parameters, options + _forced_options_denominator),
+                _decay_numerator(impl::make_shared_decay<Decay_>(parameters, options + _forced_options_numerator)),
+                _decay_denominator(impl::make_shared_decay<Decay_>(parameters, options + _forced_options_denominator)),
                 _numerator(numerator),
                 _denominator(denominator),
                 _kinematics_names_numerator(kinematics_names_numerator),
                 _kinematics_names_denominator(kinematics_names_denominator),
-                _argument_tuple_numerator(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names_numerator, &_decay_numerator)),
-                _argument_tuple_denominator(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names_denominator, &_decay_denominator))
+                _argument_tuple_numerator(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names_numerator, _decay_numerator.get())),
+                _argument_tuple_denominator(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names_denominator, _decay_denominator.get()))
             {
-                uses(_decay_numerator);
-                uses(_decay_denominator);
+                uses(*_decay_numerator);
+                uses(*_decay_denominator);
             }
 
             ~ConcreteObservableRatio() = default;
@@ -276,6 +358,11 @@ namespace eos
                 return _options;
             }
 
+            virtual std::vector<const void *> shared_objects() const
+            {
+                return std::vector<const void *>{ _decay_numerator.get(), _decay_denominator.get() };
+            }
+
             virtual ObservablePtr clone() const
             {
                 return ObservablePtr(new ConcreteObservableRatio(_name, _parameters.clone(), _kinematics.clone(), _options,
@@ -26,6 +26,9 @@
 
 #include <hdf5.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace eos
 {
     HDF5Error::HDF5Error(const std::string & message) :
@@ -80,10 +83,20 @@ namespace eos
 
         hid_t type_id;
 
+        // number of records in the file
         hsize_t size;
 
         hsize_t capacity;
 
+        hsize_t record_size;
+
+        hsize_t chunk_size;
+
+        // records that are not yet written to the file
+        std::vector<char> staging;
+
+        hsize_t staged;
+
         Implementation(const hdf5::FileHandle & file_handle, const hid_t & data_set_id, const hid_t & space_id_file, hsize_t size) :
             file_handle(file_handle),
             data_set_id(data_set_id),
@@ -91,14 +104,36 @@ namespace eos
             space_id_memory_element(H5Screate(H5S_SCALAR)),
             type_id(H5Dget_type(data_set_id)),
             size(size),
-            capacity(H5Sget_simple_extent_npoints(space_id_file))
+            capacity(H5Sget_simple_extent_npoints(space_id_file)),
+            record_size(H5Tget_size(type_id)),
+            chunk_size(1),
+            staged(0)
         {
+            hid_t dcpl_id = H5Dget_create_plist(data_set_id);
+            if (H5D_CHUNKED == H5Pget_layout(dcpl_id))
+            {
+                H5Pget_chunk(dcpl_id, 1, &chunk_size);
+            }
+            H5Pclose(dcpl_id);
         }
 
         ~Implementation()
         {
             herr_t ret;
 
+            if (! file_handle.read_only())
+            {
+                try
+                {
+                    flush();
+                }
+                catch (HDF5Error & e)
+                {
+                    Log::instance()->message("[hdf5::DataSetHandle::dtor]", ll_error)
+                        << "Flushing staged records failed: " << e.what();
+                }
+            }
+
             // truncate the data set to its actual size
             if (! file_handle.read_only())
             {
@@ -139,6 +174,59 @@ namespace eos
                     << "H5Dclose(data_set_id) failed and returned " << stringify(ret);
             }
         }
+
+        // grow the data set geometrically, so that appending n records costs O(log n) resizes
+        void reserve(const hsize_t & required)
+        {
+            if (required <= capacity)
+                return;
+
+            hsize_t new_capacity = std::max(required, 2 * capacity);
+            hsize_t max_capacity = H5S_UNLIMITED;
+
+            herr_t ret = H5Sset_extent_simple(space_id_file, 1, &new_capacity, &max_capacity);
+            if (0 > ret)
+                throw HDF5Error("H5Sset_extent_simple failed and returned " + stringify(ret));
+
+            ret = H5Dset_extent(data_set_id, &new_capacity);
+            if (0 > ret)
+                throw HDF5Error("H5Dset_extent failed and returned " + stringify(ret));
+
+            capacity = new_capacity;
+        }
+
+        void write(const void * buffer, hsize_t count)
+        {
+            if (0 == count)
+                return;
+
+            reserve(size + count);
+
+            hsize_t start = size;
+            herr_t ret = H5Sselect_hyperslab(space_id_file, H5S_SELECT_SET, &start, 0, &count, 0);
+            if (0 > ret)
+                throw HDF5Error("H5Sselect_hyperslab failed and returned " + stringify(ret));
+
+            hid_t space_id_memory = H5Screate_simple(1, &count, 0);
+            if (H5I_INVALID_HID == space_id_memory)
+                throw HDF5Error("H5Screate_simple failed and returned " + stringify(space_id_memory));
+
+            ret = H5Dwrite(data_set_id, type_id, space_id_memory, space_id_file, H5P_DEFAULT, buffer);
+            H5Sclose(space_id_memory);
+            if (0 > ret)
+                throw HDF5Error("H5Dwrite failed and returned " + stringify(ret));
+
+            size += count;
+        }
+
+        void flush()
+        {
+            if (0 == staged)
+                return;
+
+            write(staging.data(), staged);
+            staged = 0;
+        }
     };
 
     template <> struct Implementation<hdf5::AttributeHandle>
@@ -256,38 +344,48 @@ namespace eos
         hsize_t
         DataSetHandle::size() const
         {
-            return _imp->size;
+            return _imp->size + _imp->staged;
+        }
+
+        hsize_t
+        DataSetHandle::chunk_size() const
+        {
+            return _imp->chunk_size;
         }
 
         void
         DataSetHandle::select(hsize_t start, hsize_t count)
         {
+            // make staged records visible to subsequent reads
+            _imp->flush();
+
             H5Sselect_hyperslab(_imp->space_id_file, H5S_SELECT_SET, &start, 0, &count, 0);
         }
 
         void
         DataSetHandle::write_one(const void * buffer)
         {
-            if (_imp->size + 5 >= _imp->capacity)
-            {
-                hsize_t new_capacity = _imp->capacity + 1000;
-                hsize_t max_capacity = H5S_UNLIMITED;
-
-                herr_t ret = H5Sset_extent_simple(_imp->space_id_file, 1, &new_capacity, &max_capacity);
-                if (0 > ret)
-                    throw HDF5Error("H5Sset_extent_simple failed and returned " + stringify(ret));
+            if (_imp->staging.empty())
+                _imp->staging.resize(_imp->chunk_size * _imp->record_size);
 
-                select(_imp->size, 1);
+            ::memcpy(&_imp->staging[_imp->staged * _imp->record_size], buffer, _imp->record_size);
+            ++_imp->staged;
 
-                ret = H5Dset_extent(_imp->data_set_id, &new_capacity);
-                if (0 > ret)
-                    throw HDF5Error("H5Dset_extent failed and returned " + stringify(ret));
+            if (_imp->staged == _imp->chunk_size)
+                _imp->flush();
+        }
 
-                _imp->capacity = new_capacity;
-            }
+        void
+        DataSetHandle::write_block(const void * buffer, hsize_t count)
+        {
+            _imp->flush();
+            _imp->write(buffer, count);
+        }
 
-            H5Dwrite(_imp->data_set_id, _imp->type_id, _imp->space_id_memory_element, _imp->space_id_file, H5P_DEFAULT, buffer);
-            ++_imp->size;
+        void
+        DataSetHandle::flush()
+        {
+            _imp->flush();
         }
 
         void
@@ -406,10 +504,62 @@ namespace eos
             return true;
         }
 
+        DataSetConfig::DataSetConfig() :
+            _chunk_size(256),
+            _deflate(0),
+            _shuffle(false)
+        {
+        }
+
+        hsize_t
+        DataSetConfig::chunk_size() const
+        {
+            return _chunk_size;
+        }
+
+        DataSetConfig &
+        DataSetConfig::chunk_size(const hsize_t & x)
+        {
+            if (0 == x)
+                throw InternalError("DataSetConfig: chunk size must be positive");
+
+            _chunk_size = x;
+            return *this;
+        }
+
+        unsigned
+        DataSetConfig::deflate() const
+        {
+            return _deflate;
+        }
+
+        DataSetConfig &
+        DataSetConfig::deflate(const unsigned & x)
+        {
+            if (9 < x)
+                throw InternalError("DataSetConfig: deflate level must be in the range [0, 9]");
+
+            _deflate = x;
+            return *this;
+        }
+
+        bool
+        DataSetConfig::shuffle() const
+        {
+            return _shuffle;
+        }
+
+        DataSetConfig &
+        DataSetConfig::shuffle(const bool & x)
+        {
+            _shuffle = x;
+            return *this;
+        }
+
         DataSetHandle
-        File::_create_data_set(const std::string & name, const TypePtr & type)
+        File::_create_data_set(const std::string & name, const TypePtr & type, const DataSetConfig & config)
         {
-            static const unsigned capacity = 10;
+            const hsize_t capacity = config.chunk_size();
             hid_t space_id_file, dcpl_id, lcpl_id, set_id;
 
             // create space id for in-file representation
@@ -427,11 +577,25 @@ namespace eos
                 if (H5I_INVALID_HID == dcpl_id)
                     throw HDF5Error("H5Pcreate failed and returned " + stringify(dcpl_id));
 
-                hsize_t chunk_size = capacity;
+                hsize_t chunk_size = config.chunk_size();
                 herr_t ret = H5Pset_chunk(dcpl_id, 1, &chunk_size);
                 if (0 > ret)
                     throw HDF5Error("H5Pset_chunk failed and returned " + stringify(dcpl_id));
 
+                if (config.shuffle())
+                {
+                    ret = H5Pset_shuffle(dcpl_id);
+                    if (0 > ret)
+                        throw HDF5Error("H5Pset_shuffle failed and returned " + stringify(ret));
+                }
+
+                if (0 < config.deflate())
+                {
+                    ret = H5Pset_deflate(dcpl_id, config.deflate());
+                    if (0 > ret)
+                        throw HDF5Error("H5Pset_deflate failed and returned " + stringify(ret));
+                }
+
                 lcpl_id = H5Pcreate(H5P_LINK_CREATE);
                 if (H5I_INVALID_HID == lcpl_id)
                     throw HDF5Error("H5Pcreate failed and returned " + stringify(lcpl_id));
@@ -341,6 +341,35 @@ namespace eos
                 }
         };
 
+        /*!
+         * DataSetConfig holds the storage properties of newly created data sets.
+         */
+        class DataSetConfig
+        {
+            private:
+                hsize_t _chunk_size;
+
+                unsigned _deflate;
+
+                bool _shuffle;
+
+            public:
+                /// Default configuration: chunks of 256 records, no compression.
+                DataSetConfig();
+
+                /// Number of records per chunk. Appended records are written to the file in whole chunks.
+                hsize_t chunk_size() const;
+                DataSetConfig & chunk_size(const hsize_t & x);
+
+                /// Level of the deflate (zlib) compression, 0 disables compression.
+                unsigned deflate() const;
+                DataSetConfig & deflate(const unsigned & x);
+
+                /// Whether to apply the byte shuffle filter prior to compression.
+                bool shuffle() const;
+                DataSetConfig & shuffle(const bool & x);
+        };
+
         /* Handle Classes */
 
         class FileHandle :
@@ -376,12 +405,23 @@ namespace eos
 
                 hid_t type_id() const;
 
+                /// Number of records, including those not yet flushed to the file.
                 hsize_t size() const;
 
+                /// Number of records per chunk.
+                hsize_t chunk_size() const;
+
                 void select(hsize_t start, hsize_t count);
 
+                /// Append one record. Records are staged in memory and written to the file in whole chunks.
                 void write_one(const void * buffer);
 
+                /// Append a contiguous block of records with a single write.
+                void write_block(const void * buffer, hsize_t count);
+
+                /// Write all staged records to the file.
+                void flush();
+
                 void read_one(void * buffer);
 
                 AttributeHandle create_attribute(const std::string & name, const hid_t & type_id);
@@ -421,7 +461,7 @@ namespace eos
 
                 DataSetHandle _open_data_set(const std::string & name, const TypePtr & type) const;
 
-                DataSetHandle _create_data_set(const std::string & name, const TypePtr & type);
+                DataSetHandle _create_data_set(const std::string & name, const TypePtr & type, const DataSetConfig & config);
 
             public:
                 ///@name Basic Functions
@@ -460,11 +500,12 @@ namespace eos
                  *
                  * @param name   Absolute name of the new data set.
                  * @param t Instance of any of Scalar, Array or Composite that represents this data set's underlying data type.
+                 * @param config The storage properties of the new data set.
                  */
-                template <typename T_> DataSet<T_> create_data_set(const std::string & name, const T_ & t)
+                template <typename T_> DataSet<T_> create_data_set(const std::string & name, const T_ & t, const DataSetConfig & config = DataSetConfig())
                 {
                     TypePtr type = TypePtr(new T_(t));
-                    auto result = DataSet<T_>(_create_data_set(name, type), type);
+                    auto result = DataSet<T_>(_create_data_set(name, type, config), type);
 
                     return result;
                 }
@@ -491,8 +532,9 @@ namespace eos
                  *
                  * @param name Absolute name of the data set.
                  * @param t Instance of any of Scalar, Array or Composite that represents this data set's underlying data type.
+                 * @param config The storage properties of the data set, if it is created.
                  */
-                template <typename T_> DataSet<T_> create_or_open_data_set(const std::string & name, const T_ & t)
+                template <typename T_> DataSet<T_> create_or_open_data_set(const std::string & name, const T_ & t, const DataSetConfig & config = DataSetConfig())
                 {
                     TypePtr type = TypePtr(new T_(t));
                     H5E_BEGIN_TRY
@@ -508,7 +550,7 @@ namespace eos
                         }
                     }
                     H5E_END_TRY;
-                    auto result = DataSet<T_>(_create_data_set(name, type), type);
+                    auto result = DataSet<T_>(_create_data_set(name, type, config), type);
                     return result;
                 }
 
@@ -567,7 +609,6 @@ namespace eos
                 {
                     _type->copy_to_hdf5(&record, &_buffer[0]);
 
-                    _handle.select(_handle.size(), 1);
                     _handle.write_one(&_buffer[0]);
                 }
 
@@ -625,6 +666,50 @@ namespace eos
                     _index = index;
                 }
 
+                /*!
+                 * Append a range of records to the end of the data set.
+                 *
+                 * The records are converted and written in blocks of one chunk each.
+                 *
+                 * @param begin Iterator to the first record.
+                 * @param end   Iterator past the last record.
+                 */
+                template <typename Iterator_> void write_block(Iterator_ begin, Iterator_ end)
+                {
+                    const hsize_t record_size = _type->size();
+                    const hsize_t block_size = _handle.chunk_size();
+                    std::vector<char> block(block_size * record_size, '\0');
+
+                    while (begin != end)
+                    {
+                        hsize_t count = 0;
+                        for ( ; (begin != end) && (count < block_size) ; ++begin, ++count)
+                        {
+                            _type->copy_to_hdf5(&(*begin), &block[count * record_size]);
+                        }
+
+                        _handle.write_block(&block[0], count);
+                    }
+                }
+
+                /*!
+                 * Append a contiguous block of records that are already laid out in HDF5's
+                 * memory representation, e.g. the rows of a row-major array of doubles for
+                 * a data set of Array<1, double> records. No conversion takes place.
+                 *
+                 * @param records Pointer to the first record.
+                 * @param count   Number of records.
+                 */
+                void write_raw(const void * records, const hsize_t & count)
+                {
+                    _handle.write_block(records, count);
+                }
+
+                /// Write all staged records to the file.
+                void flush()
+                {
+                    _handle.flush();
+                }
                 ///@}
 
                 ///@name Attribute Access
@@ -171,3 +171,112 @@ class HDF5AttributeTest:
         }
 } hdf5_attribute_test;
 
+
+class HDF5BlockWriteTest:
+    public TestCase
+{
+    public:
+        HDF5BlockWriteTest() :
+            TestCase("hdf5_block_write_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const std::string filename(EOS_BUILDDIR "/eos/utils/hdf5_TEST-block-write.hdf5");
+            std::remove(filename.c_str());
+
+            hdf5::Composite<hdf5::Scalar<double>, hdf5::Array<1, double>> type
+            {
+                "sample",
+                hdf5::Scalar<double>("weight"),
+                hdf5::Array<1, double>("point", { 2 }),
+            };
+
+            // Write records one by one and in blocks, both across chunk boundaries
+            {
+                hdf5::File file = hdf5::File::Create(filename);
+
+                auto single = file.create_data_set("/data/single", type, hdf5::DataSetConfig().chunk_size(16));
+                for (unsigned i = 0 ; i < 1000 ; ++i)
+                {
+                    single << std::make_tuple(double(i), std::vector<double>{ 1.0 * i, -1.0 * i });
+                }
+                TEST_CHECK_EQUAL(1000, single.records());
+
+                std::vector<std::tuple<double, std::vector<double>>> records;
+                for (unsigned i = 0 ; i < 1000 ; ++i)
+                {
+                    records.push_back(std::make_tuple(double(i), std::vector<double>{ 2.0 * i, -2.0 * i }));
+                }
+
+                auto block = file.create_data_set("/data/block", type, hdf5::DataSetConfig().chunk_size(64).shuffle(true).deflate(4));
+                block << records.front();
+                block.write_block(records.begin() + 1, records.end());
+                TEST_CHECK_EQUAL(1000, block.records());
+            }
+
+            // Read back
+            {
+                hdf5::File file = hdf5::File::Open(filename, H5F_ACC_RDONLY);
+
+                auto single = file.open_data_set("/data/single", type);
+                auto block = file.open_data_set("/data/block", type);
+                TEST_CHECK_EQUAL(1000, single.records());
+                TEST_CHECK_EQUAL(1000, block.records());
+
+                std::tuple<double, std::vector<double>> record;
+                for (unsigned i = 0 ; i < 1000 ; ++i)
+                {
+                    single >> record;
+                    TEST_CHECK_EQUAL(double(i),  std::get<0>(record));
+                    TEST_CHECK_EQUAL(-1.0 * i,   std::get<1>(record)[1]);
+
+                    block >> record;
+                    TEST_CHECK_EQUAL(double(i),  std::get<0>(record));
+                    TEST_CHECK_EQUAL(2.0 * i,    std::get<1>(record)[0]);
+                }
+            }
+
+            // Staged records are visible to reads through the same data set
+            {
+                hdf5::File file = hdf5::File::Open(filename, H5F_ACC_RDWR);
+
+                auto single = file.open_data_set("/data/single", type);
+                single << std::make_tuple(-1.0, std::vector<double>{ 0.0, 0.0 });
+                TEST_CHECK_EQUAL(1001, single.records());
+
+                std::tuple<double, std::vector<double>> record;
+                single.end();
+                single >> record;
+                TEST_CHECK_EQUAL(-1.0, std::get<0>(record));
+            }
+
+            // Raw rows of a contiguous buffer map onto Array<1, double> records
+            {
+                hdf5::File file = hdf5::File::Open(filename, H5F_ACC_RDWR);
+
+                hdf5::Array<1, double> row_type("row", { 3 });
+                std::vector<double> rows;
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    rows.insert(rows.end(), { 1.0 * i, 2.0 * i, -1.0 * i });
+                }
+
+                auto raw = file.create_data_set("/data/raw", row_type, hdf5::DataSetConfig().chunk_size(32));
+                raw << std::vector<double>{ -1.0, -2.0, -3.0 };
+                raw.write_raw(rows.data(), 100);
+                TEST_CHECK_EQUAL(101, raw.records());
+
+                std::vector<double> record(3);
+                raw >> record;
+                TEST_CHECK_EQUAL(-3.0, record[2]);
+                for (unsigned i = 0 ; i < 100 ; ++i)
+                {
+                    raw >> record;
+                    TEST_CHECK_EQUAL(2.0 * i,  record[1]);
+                    TEST_CHECK_EQUAL(-1.0 * i, record[2]);
+                }
+            }
+        }
+} hdf5_block_write_test;
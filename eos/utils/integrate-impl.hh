@@ -24,119 +24,580 @@
 
 #include <eos/utils/integrate.hh>
 #include <eos/utils/integrate-cubature.hh>
+#include <eos/utils/log.hh>
 #include <eos/utils/matrix.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <exception>
+#include <type_traits>
 #include <vector>
 
 namespace eos
 {
-    template <std::size_t k> std::array<double, k> integrate1D(const std::function<std::array<double, k> (const double &)> & f, unsigned n, const double & a, const double & b)
+    namespace impl
     {
-        if (n & 0x1)
-            n += 1;
-
-        if (n < 16)
-            n = 16;
+        /*
+         * A panel of eight equidistant subintervals of width h, starting at x,
+         * together with the integrand at its nine sampling points.
+         */
+        template <typename T_> struct Integration1DPanel
+        {
+            double x, h;
 
-        // step width
-        double h = (b - a) / n;
+            std::array<T_, 9> y;
+        };
 
-        // evaluate function for every sampling point
-        std::vector<std::array<double, k>> y;
-        for (unsigned i = 0 ; i < n + 1 ; ++i)
+        /*
+         * Aitken's Delta^2-extrapolation of three successive Simpson estimates.
+         *
+         * Returns false if the extrapolation is unreliable and the estimates
+         * need further refinement.
+         */
+        inline bool aitken(const double & Q0, const double & Q1, const double & Q2, double & result)
         {
-            y.push_back(f(a + i * h));
+            double denom = (Q0 + Q2 - 2.0 * Q1);
+            double num = Q2 - Q1;
+            double correction = num * num / denom;
+
+            if (std::isnan(correction))
+            {
+                result = Q2;
+                return true;
+            }
+
+            if (std::abs(correction / Q2) < 1.0)
+            {
+                result = Q2 - correction;
+                return true;
+            }
+
+            return false;
         }
 
-        std::array<double, k> Q0; Q0.fill(0.0);
-        std::array<double, k> Q1; Q1.fill(0.0);
-        std::array<double, k> Q2; Q2.fill(0.0);
+        inline bool aitken(const complex<double> & Q0, const complex<double> & Q1, const complex<double> & Q2, complex<double> & result)
+        {
+            double denom_r = real(Q0 + Q2 - 2.0 * Q1), denom_i = imag(Q0 + Q2 - 2.0 * Q1);
+            double num_r = real(Q2 - Q1), num_i = imag(Q2 - Q1);
+            double correction_r = num_r * num_r / denom_r, correction_i = num_i * num_i / denom_i;
+
+            if (std::isnan(correction_r) || std::isnan(correction_i))
+            {
+                result = Q2;
+                return true;
+            }
 
-        for (unsigned i = 0 ; i < n / 8 ; ++i)
+            if ((std::abs(correction_r / real(Q2)) < 1.0) && (std::abs(correction_i / imag(Q2)) < 1.0))
+            {
+                result = Q2 - complex<double>(correction_r, correction_i);
+                return true;
+            }
+
+            return false;
+        }
+
+        template <std::size_t k>
+        bool aitken(const std::array<double, k> & Q0, const std::array<double, k> & Q1, const std::array<double, k> & Q2, std::array<double, k> & result)
         {
-            Q0 = Q0 + y[8 * i] + 4.0 * y[8 * i + 4] + y[8 * i + 4];
+            std::array<double, k> denom = Q0 + Q2 - 2.0 * Q1;
+            std::array<double, k> num = Q2 - Q1;
+            std::array<double, k> correction = divide(mult(num, num), denom);
+
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                if (std::isnan(correction[i]))
+                {
+                    result = Q2;
+                    return true;
+                }
+            }
+
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                if ((std::abs(correction[i] / Q2[i])) > 1.0)
+                    return false;
+            }
+
+            result = Q2 - correction;
+            return true;
         }
-        for (unsigned i = 0 ; i < n / 4 ; ++i)
+
+        /*
+         * Size of a panel's error estimate delta, relative to the total integral.
+         */
+        inline double deviation(const double & delta, const double & scale)
         {
-            Q1 = Q1 + y[4 * i] + 4.0 * y[4 * i + 2] + y[4 * i + 4];
+            return (0.0 == scale) ? std::abs(delta) : std::abs(delta / scale);
         }
-        for (unsigned i = 0 ; i < n / 2 ; ++i)
+
+        inline double deviation(const complex<double> & delta, const complex<double> & scale)
         {
-            Q2 = Q2 + y[2 * i] + 4.0 * y[2 * i + 1] + y[2 * i + 2];
+            return std::max(deviation(real(delta), real(scale)), deviation(imag(delta), imag(scale)));
         }
 
-        Q0 = (h / 3.0 * 4.0) * Q0;
-        Q1 = (h / 3.0 * 2.0) * Q1;
-        Q2 = (h / 3.0) * Q2;
+        template <std::size_t k>
+        double deviation(const std::array<double, k> & delta, const std::array<double, k> & scale)
+        {
+            double result = 0.0;
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                result = std::max(result, deviation(delta[i], scale[i]));
+            }
 
-        std::array<double, k> denom = Q0 + Q2 - 2.0 * Q1;
-        std::array<double, k> num = Q2 - Q1;
-        std::array<double, k> correction = divide(mult(num, num), denom);
+            return result;
+        }
 
-        bool correction_valid = true;
-        for (unsigned i = 0 ; i < k ; ++i)
+        template <typename T_>
+        T_ integrate1D(const std::function<T_ (const double &)> & f, unsigned n, const double & a, const double & b, unsigned & evaluations)
         {
-            if (std::isnan(correction[i]))
+            // bound the number of bisection rounds; beyond that we warn and return the plain Simpson estimate
+            static const unsigned max_refinements = 16;
+
+            // panels whose error estimate lies this far below the worst panel's one are considered converged
+            static const double negligible_deviation = 1.0e-3;
+
+            if (n & 0x1)
+                n += 1;
+
+            if (n < 16)
+                n = 16;
+
+            // every panel spans eight subintervals
+            n = (n + 7) & ~7u;
+
+            // step width
+            double h = (b - a) / n;
+
+            // evaluate function for every sampling point, and share the end points among neighbouring panels
+            std::vector<Integration1DPanel<T_>> panels(n / 8);
+            for (unsigned p = 0 ; p < n / 8 ; ++p)
             {
-                correction_valid = false;
-                break;
+                panels[p].x = a + 8 * p * h;
+                panels[p].h = h;
+                panels[p].y[0] = (0 == p) ? f(a) : panels[p - 1].y[8];
+
+                for (unsigned i = 1 ; i < 9 ; ++i)
+                {
+                    panels[p].y[i] = f(a + (8 * p + i) * h);
+                }
+            }
+            evaluations = n + 1;
+
+            const T_ zero = T_();
+            std::vector<T_> delta;
+            std::vector<double> deviations;
+            for (unsigned refinement = 0 ; ; ++refinement)
+            {
+                T_ Q0 = zero, Q1 = zero, Q2 = zero;
+
+                delta.resize(panels.size());
+                for (unsigned p = 0 ; p < panels.size() ; ++p)
+                {
+                    const auto & y = panels[p].y;
+                    const double & h_p = panels[p].h;
+
+                    T_ q0 = (h_p / 3.0 * 4.0) * (y[0] + 4.0 * y[4] + y[4]);
+                    T_ q1 = (h_p / 3.0 * 2.0) * (y[0] + 4.0 * y[2] + y[4] + y[4] + 4.0 * y[6] + y[8]);
+                    T_ q2 = (h_p / 3.0) * (y[0] + 4.0 * y[1] + y[2] + y[2] + 4.0 * y[3] + y[4]
+                            + y[4] + 4.0 * y[5] + y[6] + y[6] + 4.0 * y[7] + y[8]);
+
+                    Q0 = Q0 + q0;
+                    Q1 = Q1 + q1;
+                    Q2 = Q2 + q2;
+                    delta[p] = q2 - q1;
+                }
+
+                T_ result;
+                if (aitken(Q0, Q1, Q2, result))
+                    return result;
+
+                if (max_refinements == refinement)
+                {
+                    Log::instance()->message("integrate1D", ll_warning)
+                        << "Extrapolation on [" << a << ", " << b << "] did not converge within " << max_refinements
+                        << " refinements and " << evaluations << " evaluations of the integrand; returning the Simpson estimate";
+
+                    return Q2;
+                }
+
+                // bisect all panels with a non-negligible error estimate
+                deviations.resize(panels.size());
+                double max_deviation = 0.0;
+                for (unsigned p = 0 ; p < panels.size() ; ++p)
+                {
+                    deviations[p] = deviation(delta[p], Q2);
+                    max_deviation = std::max(max_deviation, deviations[p]);
+                }
+
+                std::vector<Integration1DPanel<T_>> refined_panels;
+                refined_panels.reserve(2 * panels.size());
+                for (unsigned p = 0 ; p < panels.size() ; ++p)
+                {
+                    const auto & panel = panels[p];
+
+                    if (deviations[p] < negligible_deviation * max_deviation)
+                    {
+                        refined_panels.push_back(panel);
+                        continue;
+                    }
+
+                    Integration1DPanel<T_> left, right;
+                    left.x = panel.x;
+                    left.h = panel.h / 2.0;
+                    right.x = panel.x + 4.0 * panel.h;
+                    right.h = panel.h / 2.0;
+
+                    for (unsigned i = 0 ; i < 5 ; ++i)
+                    {
+                        left.y[2 * i] = panel.y[i];
+                        right.y[2 * i] = panel.y[4 + i];
+                    }
+
+                    for (unsigned i = 0 ; i < 4 ; ++i)
+                    {
+                        left.y[2 * i + 1] = f(left.x + (2 * i + 1) * left.h);
+                        right.y[2 * i + 1] = f(right.x + (2 * i + 1) * right.h);
+                    }
+                    evaluations += 8;
+
+                    refined_panels.push_back(left);
+                    refined_panels.push_back(right);
+                }
+
+                panels.swap(refined_panels);
             }
         }
+    }
+
+    template <std::size_t k> std::array<double, k> integrate1D(const std::function<std::array<double, k> (const double &)> & f, unsigned n, const double & a, const double & b, unsigned & evaluations)
+    {
+        return impl::integrate1D<std::array<double, k>>(f, n, a, b, evaluations);
+    }
+
+    template <std::size_t k> std::array<double, k> integrate1D(const std::function<std::array<double, k> (const double &)> & f, unsigned n, const double & a, const double & b)
+    {
+        unsigned evaluations;
+
+        return impl::integrate1D<std::array<double, k>>(f, n, a, b, evaluations);
+    }
 
-        if (!correction_valid)
+    namespace impl
+    {
+        // nodes and weights of the 21-point Gauss-Kronrod rule, cf. QUADPACK's DQK21
+        struct GaussKronrod21
+        {
+            static const double xgk[11];
+            static const double wg[5];
+            static const double wgk[11];
+        };
+
+        // error estimate of a Gauss-Kronrod rule, cf. QUADPACK
+        double rescale_error(double err, const double & result_abs, const double & result_asc);
+
+        template <std::size_t k_> struct VectorIntegrationInterval
+        {
+            double a, b;
+
+            std::array<double, k_> result, error;
+        };
+
+        template <std::size_t k_>
+        VectorIntegrationInterval<k_> gauss_kronrod_21(const std::function<std::array<double, k_> (const double &)> & f, const double & a, const double & b)
         {
-            return Q2;
+            using GK = GaussKronrod21;
+
+            const double center = 0.5 * (a + b);
+            const double half_length = 0.5 * (b - a);
+            const double abs_half_length = std::abs(half_length);
+
+            std::array<std::array<double, k_>, 10> fv1, fv2;
+            const std::array<double, k_> f_center = f(center);
+
+            std::array<double, k_> result_gauss, result_kronrod, result_abs;
+            for (std::size_t i = 0 ; i < k_ ; ++i)
+            {
+                result_gauss[i] = 0.0;
+                result_kronrod[i] = f_center[i] * GK::wgk[10];
+                result_abs[i] = std::abs(result_kronrod[i]);
+            }
+
+            for (unsigned j = 0 ; j < 5 ; ++j)
+            {
+                const unsigned jtw = 2 * j + 1;
+                const double abscissa = half_length * GK::xgk[jtw];
+                fv1[jtw] = f(center - abscissa);
+                fv2[jtw] = f(center + abscissa);
+
+                for (std::size_t i = 0 ; i < k_ ; ++i)
+                {
+                    const double fsum = fv1[jtw][i] + fv2[jtw][i];
+                    result_gauss[i]   += GK::wg[j] * fsum;
+                    result_kronrod[i] += GK::wgk[jtw] * fsum;
+                    result_abs[i]     += GK::wgk[jtw] * (std::abs(fv1[jtw][i]) + std::abs(fv2[jtw][i]));
+                }
+            }
+
+            for (unsigned j = 0 ; j < 5 ; ++j)
+            {
+                const unsigned jtwm1 = 2 * j;
+                const double abscissa = half_length * GK::xgk[jtwm1];
+                fv1[jtwm1] = f(center - abscissa);
+                fv2[jtwm1] = f(center + abscissa);
+
+                for (std::size_t i = 0 ; i < k_ ; ++i)
+                {
+                    result_kronrod[i] += GK::wgk[jtwm1] * (fv1[jtwm1][i] + fv2[jtwm1][i]);
+                    result_abs[i]     += GK::wgk[jtwm1] * (std::abs(fv1[jtwm1][i]) + std::abs(fv2[jtwm1][i]));
+                }
+            }
+
+            VectorIntegrationInterval<k_> result{ a, b, { }, { } };
+            for (std::size_t i = 0 ; i < k_ ; ++i)
+            {
+                const double mean = 0.5 * result_kronrod[i];
+                double result_asc = GK::wgk[10] * std::abs(f_center[i] - mean);
+                for (unsigned j = 0 ; j < 10 ; ++j)
+                {
+                    result_asc += GK::wgk[j] * (std::abs(fv1[j][i] - mean) + std::abs(fv2[j][i] - mean));
+                }
+
+                result.result[i] = result_kronrod[i] * half_length;
+                result.error[i]  = rescale_error((result_kronrod[i] - result_gauss[i]) * half_length,
+                        result_abs[i] * abs_half_length, result_asc * abs_half_length);
+            }
+
+            return result;
         }
-        else
+    }
+
+    template <typename Method_, std::size_t k_>
+    std::array<double, k_> integrate(const std::function<std::array<double, k_> (const double &)> & f,
+                                     const double & a, const double & b,
+                                     const typename Method_::Config & config)
+    {
+        static_assert(std::is_same<Method_, GSL::QAG>::value, "vector-valued integration is only available for GSL::QAG");
+
+        using Interval = impl::VectorIntegrationInterval<k_>;
+
+        // the largest error of any component, in units of its requested accuracy
+        auto scaled_error = [&config] (const std::array<double, k_> & error, const std::array<double, k_> & result) -> double
         {
-            bool correction_small = true;
+            double worst = 0.0;
+            for (std::size_t i = 0 ; i < k_ ; ++i)
+            {
+                if (0.0 == error[i])
+                    continue;
 
-            for (unsigned i = 0 ; i < k ; ++i)
+                const double tolerance = std::max(config.epsabs(), config.epsrel() * std::abs(result[i]));
+                worst = std::max(worst, error[i] / tolerance);
+            }
+
+            return worst;
+        };
+
+        std::vector<Interval> intervals{ impl::gauss_kronrod_21(f, a, b) };
+        std::array<double, k_> result = intervals.front().result;
+        std::array<double, k_> error  = intervals.front().error;
+
+        const std::size_t limit = GSL::work_space.limit();
+        while (scaled_error(error, result) > 1.0)
+        {
+            if (intervals.size() >= std::max<std::size_t>(limit, 1))
+                throw IntegrationError("maximum number of subdivisions reached");
+
+            // bisect the subinterval with the largest error
+            std::size_t index = 0;
+            double largest = -1.0;
+            for (std::size_t n = 0 ; n < intervals.size() ; ++n)
             {
-                if ((abs(correction[i] / Q2[i])) > 1.0)
+                const double e = scaled_error(intervals[n].error, result);
+                if (e > largest)
                 {
-                    correction_small = false;
-                    break;
+                    largest = e;
+                    index = n;
                 }
             }
 
-            if (correction_small)
+            const Interval current = intervals[index];
+            const double middle = 0.5 * (current.a + current.b);
+            if ((middle <= current.a) || (current.b <= middle))
+                throw IntegrationError("bad integrand behavior found in the integration interval");
+
+            const Interval left = impl::gauss_kronrod_21(f, current.a, middle);
+            const Interval right = impl::gauss_kronrod_21(f, middle, current.b);
+            for (std::size_t i = 0 ; i < k_ ; ++i)
             {
-                return Q2 - correction;
+                result[i] += left.result[i] + right.result[i] - current.result[i];
+                error[i]  += left.error[i]  + right.error[i]  - current.error[i];
             }
-            else
+
+            intervals[index] = left;
+            intervals.push_back(right);
+        }
+
+        // sum up the subintervals afresh, to avoid the accumulation of rounding errors
+        result.fill(0.0);
+        for (const auto & interval : intervals)
+        {
+            for (std::size_t i = 0 ; i < k_ ; ++i)
             {
-#if 0
-                std::cerr << "Q0 = " << Q0 << std::endl;
-                std::cerr << "Q1 = " << Q1 << std::endl;
-                std::cerr << "Q2 = " << Q2 << std::endl;
-                std::cerr << "Reintegrating with twice the number of data points" << std::endl;
-#endif
-                return integrate1D(f, 2 * n, a, b);
+                result[i] += interval.result[i];
             }
         }
+
+        return result;
     }
 
     namespace cubature
     {
+        // evaluate f(i) for all points i < npt of one sweep, either sequentially or with the ThreadPool
+        template <typename Function_>
+        void for_each_point(const size_t & npt, const bool & parallel, const Function_ & f)
+        {
+            if (! parallel || (npt < 2))
+            {
+                for (size_t i = 0 ; i < npt ; ++i)
+                {
+                    f(i);
+                }
+
+                return;
+            }
+
+            ThreadPool::instance()->parallel_for(0, npt, 0, [&f] (const unsigned long & begin, const unsigned long & end)
+            {
+                for (unsigned long i = begin ; i < end ; ++i)
+                {
+                    f(i);
+                }
+            });
+        }
+
+        template <size_t dim_>
+        std::array<double, dim_> make_point(const double * x, const size_t & i)
+        {
+            // TODO use std::array_view once available
+            std::array<double, dim_> result;
+            std::copy(x + i * dim_, x + (i + 1) * dim_, result.data());
+
+            return result;
+        }
+
+        template <typename Integrand_>
+        struct IntegrandData
+        {
+            const Integrand_ & f;
+
+            bool parallel;
+
+            // the first exception raised by the integrand, rethrown once hcubature_v has returned
+            std::exception_ptr error;
+        };
+
+        // run one sweep, and report exceptions to hcubature_v as a failure rather than unwinding through it
+        template <typename Integrand_, typename Function_>
+        int guarded_sweep(IntegrandData<Integrand_> & d, const Function_ & sweep)
+        {
+            try
+            {
+                sweep();
+            }
+            catch (...)
+            {
+                d.error = std::current_exception();
+
+                return 1;
+            }
+
+            return 0;
+        }
+
+        template <typename Integrand_>
+        void check_result(const IntegrandData<Integrand_> & d, const int & status)
+        {
+            if (d.error)
+                std::rethrow_exception(d.error);
+
+            if (status)
+                throw IntegrationError("hcubature failed");
+        }
 
         template <size_t dim_>
-        int scalar_integrand(unsigned ndim , const double *x, void *data,
-                      unsigned fdim , double *fval)
+        int scalar_integrand(unsigned ndim, size_t npt, const double *x, void *data,
+                      unsigned fdim, double *fval)
         {
             assert(ndim == dim_);
             assert(fdim == 1);
 
-            auto& f = *static_cast<cubature::fdd<dim_> *>(data);
-            // TODO use std::array_view once available
-            std::array<double, dim_> args;
-            std::copy(x, x + dim_, args.data());
-            *fval = f(args);
+            auto & d = *static_cast<IntegrandData<fdd<dim_>> *>(data);
+            return guarded_sweep(d, [&] ()
+            {
+                for_each_point(npt, d.parallel, [&] (const size_t & i)
+                {
+                    fval[i] = d.f(make_point<dim_>(x, i));
+                });
+            });
+        }
 
-            return 0;
+        template <size_t dim_>
+        int batch_integrand(unsigned ndim, size_t npt, const double *x, void *data,
+                      unsigned fdim, double *fval)
+        {
+            assert(ndim == dim_);
+            assert(fdim == 1);
+
+            auto & d = *static_cast<IntegrandData<fdd_v<dim_>> *>(data);
+            auto evaluate = [&] (const unsigned long & begin, const unsigned long & end)
+            {
+                std::vector<std::array<double, dim_>> points;
+                points.reserve(end - begin);
+                for (unsigned long i = begin ; i < end ; ++i)
+                {
+                    points.push_back(make_point<dim_>(x, i));
+                }
+
+                std::vector<double> values(end - begin);
+                d.f(points, values);
+
+                if (values.size() != end - begin)
+                    throw IntegrationError("batch integrand returned " + stringify(values.size()) + " values for " + stringify(end - begin) + " points");
+
+                std::copy(values.cbegin(), values.cend(), fval + begin);
+            };
+
+            return guarded_sweep(d, [&] ()
+            {
+                if (! d.parallel || (npt < 2))
+                {
+                    evaluate(0, npt);
+                }
+                else
+                {
+                    ThreadPool::instance()->parallel_for(0, npt, 0, evaluate);
+                }
+            });
         }
 
+        template <size_t dim_, size_t fdim_>
+        int vector_integrand(unsigned ndim, size_t npt, const double *x, void *data,
+                      unsigned fdim, double *fval)
+        {
+            assert(ndim == dim_);
+            assert(fdim == fdim_);
+
+            auto & d = *static_cast<IntegrandData<fvd<dim_, fdim_>> *>(data);
+            return guarded_sweep(d, [&] ()
+            {
+                for_each_point(npt, d.parallel, [&] (const size_t & i)
+                {
+                    const std::array<double, fdim_> values = d.f(make_point<dim_>(x, i));
+                    std::copy(values.cbegin(), values.cend(), fval + i * fdim_);
+                });
+            });
+        }
     }
 
     template <size_t dim_>
@@ -149,16 +610,49 @@ namespace eos
         constexpr unsigned nintegrands = 1;
         double res;
         double err;
-        if (hcubature(nintegrands, &cubature::scalar_integrand<dim_>,
-                      &const_cast<cubature::fdd<dim_>&>(f), dim_, a.data(), b.data(),
-                      config.maxeval(), config.epsabs(), config.epsrel(), ERROR_L2, &res, &err))
-        {
-            throw IntegrationError("hcubature failed");
-        }
+        cubature::IntegrandData<cubature::fdd<dim_>> data{ f, config.parallel(), nullptr };
+        int status = hcubature_v(nintegrands, &cubature::scalar_integrand<dim_>,
+                                 &data, dim_, a.data(), b.data(),
+                                 config.maxeval(), config.epsabs(), config.epsrel(), ERROR_L2, &res, &err);
+        cubature::check_result(data, status);
+
+        return res;
+    }
+
+    template <size_t dim_>
+    double integrate(const cubature::fdd_v<dim_> & f,
+                     const std::array<double, dim_> &a,
+                     const std::array<double, dim_> &b,
+                     const cubature::Config &config)
+    {
+        constexpr unsigned nintegrands = 1;
+        double res;
+        double err;
+        cubature::IntegrandData<cubature::fdd_v<dim_>> data{ f, config.parallel(), nullptr };
+        int status = hcubature_v(nintegrands, &cubature::batch_integrand<dim_>,
+                                 &data, dim_, a.data(), b.data(),
+                                 config.maxeval(), config.epsabs(), config.epsrel(), ERROR_L2, &res, &err);
+        cubature::check_result(data, status);
 
         return res;
     }
 
+    template <size_t dim_, size_t fdim_>
+    std::array<double, fdim_> integrate(const cubature::fvd<dim_, fdim_> & f,
+                                        const std::array<double, dim_> &a,
+                                        const std::array<double, dim_> &b,
+                                        const cubature::Config &config)
+    {
+        std::array<double, fdim_> res;
+        std::array<double, fdim_> err;
+        cubature::IntegrandData<cubature::fvd<dim_, fdim_>> data{ f, config.parallel(), nullptr };
+        int status = hcubature_v(fdim_, &cubature::vector_integrand<dim_, fdim_>,
+                                 &data, dim_, a.data(), b.data(),
+                                 config.maxeval(), config.epsabs(), config.epsrel(), ERROR_INDIVIDUAL, res.data(), err.data());
+        cubature::check_result(data, status);
+
+        return res;
+    }
 }
 
 #endif
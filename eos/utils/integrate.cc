@@ -19,10 +19,13 @@
  */
 
 #include <eos/utils/integrate.hh>
+#include <eos/utils/integrate-impl.hh>
 #include <eos/utils/matrix.hh>
 
 #include <gsl/gsl_errno.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 
@@ -43,124 +46,87 @@ namespace eos
 
     double integrate1D(const std::function<double (const double &)> & f, unsigned n, const double & a, const double & b)
     {
-        if (n & 0x1)
-            n += 1;
+        unsigned evaluations;
 
-        if (n < 16)
-            n = 16;
-
-        double h = (b - a) / n;
-        std::vector<double> y;
-
-        for (unsigned k(0) ; k < n + 1 ; ++k)
-        {
-            y.push_back(f(a + k * h));
-        }
-
-        double Q0 = 0.0, Q1 = 0.0, Q2 = 0.0;
-        for (unsigned k(0) ; k < n / 8 ; ++k)
-        {
-            Q0 += y[8 * k] + 4.0 * y[8 * k + 4] + y[8 * k + 4];
-        }
-        for (unsigned k(0) ; k < n / 4 ; ++k)
-        {
-            Q1 += y[4 * k] + 4.0 * y[4 * k + 2] + y[4 * k + 4];
-        }
-        for (unsigned k(0) ; k < n / 2 ; ++k)
-        {
-            Q2 += y[2 * k] + 4.0 * y[2 * k + 1] + y[2 * k + 2];
-        }
-
-        Q0 = Q0 * h / 3.0 * 4.0;
-        Q1 = Q1 * h / 3.0 * 2.0;
-        Q2 = Q2 * h / 3.0;
-
-        double denom = (Q0 + Q2 - 2.0 * Q1);
-        double num = Q2 - Q1;
-        double correction = num * num / denom;
-        double result;
-
-        if (std::isnan(correction))
-        {
-            result = Q2;
-        }
-        else if (abs(correction / Q2) < 1.0)
-        {
-            result = Q2 - correction;
-        }
-        else
-        {
-#if 0
-            std::cerr << "Q0 = " << Q0 << std::endl;
-            std::cerr << "Q1 = " << Q1 << std::endl;
-            std::cerr << "Q2 = " << Q2 << std::endl;
-            std::cerr << "Reintegrating with twice the number of data points" << std::endl;
-#endif
-            result = integrate1D(f, 2 * n, a, b);
-        }
+        return impl::integrate1D<double>(f, n, a, b, evaluations);
+    }
 
-        return result;
+    double integrate1D(const std::function<double (const double &)> & f, unsigned n, const double & a, const double & b, unsigned & evaluations)
+    {
+        return impl::integrate1D<double>(f, n, a, b, evaluations);
     }
 
     complex<double> integrate1D(const std::function<complex<double> (const double &)> & f, unsigned n, const double & a, const double & b)
     {
-        if (n & 0x1)
-            n += 1;
-
-        if (n < 16)
-            n = 16;
+        unsigned evaluations;
 
-        double h = (b - a) / n;
-        std::vector<complex<double>> y;
-
-        for (unsigned k(0) ; k < n + 1 ; ++k)
-        {
-            y.push_back(f(a + k * h));
-        }
-
-        complex<double> Q0 = 0.0, Q1 = 0.0, Q2 = 0.0;
-        for (unsigned k(0) ; k < n / 8 ; ++k)
-        {
-            Q0 += y[8 * k] + 4.0 * y[8 * k + 4] + y[8 * k + 4];
-        }
-        for (unsigned k(0) ; k < n / 4 ; ++k)
-        {
-            Q1 += y[4 * k] + 4.0 * y[4 * k + 2] + y[4 * k + 4];
-        }
-        for (unsigned k(0) ; k < n / 2 ; ++k)
-        {
-            Q2 += y[2 * k] + 4.0 * y[2 * k + 1] + y[2 * k + 2];
-        }
-
-        Q0 = Q0 * h / 3.0 * 4.0;
-        Q1 = Q1 * h / 3.0 * 2.0;
-        Q2 = Q2 * h / 3.0;
+        return impl::integrate1D<complex<double>>(f, n, a, b, evaluations);
+    }
 
-        double denom_r = real(Q0 + Q2 - 2.0 * Q1), denom_i = imag(Q0 + Q2 - 2.0 * Q1);
-        double num_r = real(Q2 - Q1), num_i = imag(Q2 - Q1);
-        double correction_r = num_r * num_r / denom_r, correction_i = num_i * num_i / denom_i;
-        complex<double> result;
+    complex<double> integrate1D(const std::function<complex<double> (const double &)> & f, unsigned n, const double & a, const double & b, unsigned & evaluations)
+    {
+        return impl::integrate1D<complex<double>>(f, n, a, b, evaluations);
+    }
 
-        if (std::isnan(correction_r) || std::isnan(correction_i))
-        {
-            result = Q2;
-        }
-        else if ((abs(correction_r / real(Q2)) < 1.0) && (abs(correction_i / imag(Q2)) < 1.0))
-        {
-            result = Q2 - complex<double>(correction_r, correction_i);
-        }
-        else
-        {
-#if 0
-            std::cerr << "Q0 = " << Q0 << std::endl;
-            std::cerr << "Q1 = " << Q1 << std::endl;
-            std::cerr << "Q2 = " << Q2 << std::endl;
-            std::cerr << "Reintegrating with twice the number of data points" << std::endl;
-#endif
-            result = integrate1D(f, 2 * n, a, b);
+    namespace impl
+    {
+        const double GaussKronrod21::xgk[11] =
+        {
+            0.995657163025808080735527280689003,
+            0.973906528517171720077964012084452,
+            0.930157491355708226001207180059508,
+            0.865063366688984510732096688423493,
+            0.780817726586416897063717578345042,
+            0.679409568299024406234327365114874,
+            0.562757134668604683339000099272694,
+            0.433395394129247190799265943165784,
+            0.294392862701460198131126603103866,
+            0.148874338981631210884826001129720,
+            0.000000000000000000000000000000000
+        };
+
+        const double GaussKronrod21::wg[5] =
+        {
+            0.066671344308688137593568809893332,
+            0.149451349150580593145776339657697,
+            0.219086362515982043995534934228163,
+            0.269266719309996355091226921569469,
+            0.295524224714752870173892994651338
+        };
+
+        const double GaussKronrod21::wgk[11] =
+        {
+            0.011694638867371874278064396062192,
+            0.032558162307964727478818972459390,
+            0.054755896574351996031381300244580,
+            0.075039674810919952767043140916190,
+            0.093125454583697605535065465083366,
+            0.109387158802297641899210590325805,
+            0.123491976262065851077208005744735,
+            0.134709217311473325928054001771707,
+            0.142775938577060080797094273138717,
+            0.147739104901338491374841515972068,
+            0.149445554002916905664936468389821
+        };
+
+        double rescale_error(double err, const double & result_abs, const double & result_asc)
+        {
+            err = std::abs(err);
+
+            if ((0.0 != result_asc) && (0.0 != err))
+            {
+                const double scale = std::pow(200.0 * err / result_asc, 1.5);
+
+                err = (scale < 1.0) ? result_asc * scale : result_asc;
+            }
+
+            if (result_abs > std::numeric_limits<double>::min() / (50.0 * std::numeric_limits<double>::epsilon()))
+            {
+                err = std::max(err, 50.0 * std::numeric_limits<double>::epsilon() * result_abs);
+            }
+
+            return err;
         }
-
-        return result;
     }
 
     namespace GSL
@@ -286,7 +252,8 @@ namespace eos
     {
         Config::Config() :
             _qng(),
-            _maxeval(50000)
+            _maxeval(50000),
+            _parallel(false)
         {
         }
 
@@ -322,6 +289,17 @@ namespace eos
             _maxeval = x;
             return *this;
         }
+
+        bool Config::parallel() const
+        {
+            return _parallel;
+        }
+
+        Config & Config::parallel(const bool & x)
+        {
+            _parallel = x;
+            return *this;
+        }
     }
 
     IntegrationError::IntegrationError(const std::string & message) throw () :
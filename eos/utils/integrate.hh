@@ -32,6 +32,7 @@
 
 #include <array>
 #include <functional>
+#include <vector>
 
 namespace eos
 {
@@ -39,17 +40,26 @@ namespace eos
     /*!
      * Numerically integrate functions of one real-valued parameter.
      *
-     * Uses the Delta^2-Rule by Aitkin to refine the result.
+     * Uses the Delta^2-Rule by Aitkin to refine the result. If the
+     * extrapolation fails, only those panels of eight subintervals with a
+     * non-negligible error estimate are bisected. All previous samples of
+     * the integrand are reused. If the extrapolation still fails after 16
+     * rounds of bisection, a warning is logged and the finest Simpson
+     * estimate is returned.
      *
-     * @param f      Integrand.
-     * @param n      Number of evaluations, must be a power of 2.
-     * @param a      Lower limit of the domain of integration.
-     * @param b      Upper limit of the domain of integration.
+     * @param f           Integrand.
+     * @param n           Number of evaluations, must be a power of 2.
+     * @param a           Lower limit of the domain of integration.
+     * @param b           Upper limit of the domain of integration.
+     * @param evaluations Will be set to the number of calls to the integrand.
      */
     double integrate1D(const std::function<double (const double &)> & f, unsigned n, const double & a, const double & b);
+    double integrate1D(const std::function<double (const double &)> & f, unsigned n, const double & a, const double & b, unsigned & evaluations);
     complex<double> integrate1D(const std::function<complex<double> (const double &)> & f, unsigned n, const double & a, const double & b);
+    complex<double> integrate1D(const std::function<complex<double> (const double &)> & f, unsigned n, const double & a, const double & b, unsigned & evaluations);
 
     template <std::size_t k> std::array<double, k> integrate1D(const std::function<std::array<double, k> (const double &)> & f, unsigned n, const double & a, const double & b);
+    template <std::size_t k> std::array<double, k> integrate1D(const std::function<std::array<double, k> (const double &)> & f, unsigned n, const double & a, const double & b, unsigned & evaluations);
     /// @}
 
 namespace GSL
@@ -108,6 +118,20 @@ namespace GSL
         };
     };
 
+    /*!
+     * Globally adaptive integration with the 21-point Gauss-Kronrod rule, which repeatedly
+     * bisects the subinterval with the largest error. This is the algorithm of gsl_integration_qag
+     * with GSL_INTEG_GAUSS21, reimplemented for vector-valued integrands.
+     *
+     * Unlike gsl_integration_qags, there is no extrapolation by means of the epsilon algorithm.
+     * Integrable singularities at the end points of the interval therefore converge slowly,
+     * and strong ones exhaust the limit of subintervals, which causes an IntegrationError.
+     */
+    struct QAG
+    {
+        using Config = QNG::Config;
+    };
+
     static thread_local QAGS::Workspace work_space;
 }
 
@@ -124,11 +148,43 @@ namespace GSL
                      const double &a, const double &b,
                      const typename Method_::Config &config = typename Method_::Config());
 
+    /*!
+     * Numerically integrate vector-valued functions of one real-valued parameter.
+     *
+     * All components share one adaptive subdivision of the domain of integration,
+     * using the 21-point Gauss-Kronrod rule. The subinterval with the largest error
+     * relative to the requested accuracy, taken over all components, is bisected
+     * until every component has converged. Only GSL::QAG is supported; the
+     * number of subintervals is bounded by the limit of GSL::work_space.
+     */
+    template <typename Method_, std::size_t k_>
+    std::array<double, k_> integrate(const std::function<std::array<double, k_>(const double &)> & f,
+                                     const double &a, const double &b,
+                                     const typename Method_::Config &config = typename Method_::Config());
+
 namespace cubature
 {
     template <size_t dim_>
     using fdd = std::function<double(const std::array<double, dim_> &)>;
 
+    /*!
+     * A batch integrand, which receives all points of one sweep over the
+     * current subregions at once. It must store the integrand at x[i] in values[i];
+     * values is already of the same size as x.
+     *
+     * If cubature::Config::parallel() is set, each sweep is split into chunks, which are
+     * passed to concurrent calls of the integrand.
+     */
+    template <size_t dim_>
+    using fdd_v = std::function<void(const std::vector<std::array<double, dim_>> & x, std::vector<double> & values)>;
+
+    /*!
+     * A vector-valued integrand. All of its components are integrated on
+     * a common adaptive subdivision of the domain of integration.
+     */
+    template <size_t dim_, size_t fdim_>
+    using fvd = std::function<std::array<double, fdim_>(const std::array<double, dim_> &)>;
+
     class Config
     {
     public:
@@ -142,12 +198,21 @@ namespace cubature
 
         size_t maxeval() const;
         Config& maxeval(const size_t& x);
+
+        /*!
+         * Evaluate the points of one sweep over the subregions in parallel, using the ThreadPool.
+         * The integrand must then be safe to call from several threads at once.
+         */
+        bool parallel() const;
+        Config& parallel(const bool& x);
     private:
         GSL::QNG::Config _qng;
         size_t _maxeval;
+        bool _parallel;
     };
 }
 
+    /// @{
     /*!
      * Numerically integrate functions of one or more than one variable with
      * cubature methods.
@@ -158,6 +223,23 @@ namespace cubature
                      const std::array<double, dim_> &b,
                      const cubature::Config &config = cubature::Config());
 
+    template <size_t dim_>
+    double integrate(const cubature::fdd_v<dim_> & f,
+                     const std::array<double, dim_> &a,
+                     const std::array<double, dim_> &b,
+                     const cubature::Config &config = cubature::Config());
+
+    /*!
+     * The components of a vector-valued integrand converge individually,
+     * with respect to the absolute and relative accuracy of the configuration.
+     */
+    template <size_t dim_, size_t fdim_>
+    std::array<double, fdim_> integrate(const cubature::fvd<dim_, fdim_> & f,
+                                        const std::array<double, dim_> &a,
+                                        const std::array<double, dim_> &b,
+                                        const cubature::Config &config = cubature::Config());
+    /// @}
+
     class IntegrationError :
         public Exception
     {
@@ -19,9 +19,12 @@
 
 #include <test/test.hh>
 #include <eos/utils/integrate-impl.hh>
+#include <eos/utils/log.hh>
 
 #include <cmath>
 #include <limits>
+#include <sstream>
+#include <string>
 
 #include <iostream>
 
@@ -78,16 +81,80 @@ class IntegrateTest :
             std::cout << "\\int_0.0^exp(1) f4(x) dx = " << q4 << ", eps = " << std::abs(i4 - q4) / q4 << " over 16 points" << std::endl;
             TEST_CHECK_RELATIVE_ERROR(i4, q4, eps);
 
+            // integrand calls are reported, and previous samples are reused upon refinement
+            {
+                unsigned evaluations = 0;
+                integrate1D(std::function<double (const double &)>(&f1), 16, 0.0, 1.0, evaluations);
+                TEST_CHECK_EQUAL(17u, evaluations);
+
+                auto f5 = std::function<double (const double &)>([](const double & x) { return std::cos(25.0 * x); });
+                double q5 = integrate1D(f5, 16, 0.0, 1.0, evaluations), i5 = std::sin(25.0) / 25.0;
+                std::cout << "\\int_0.0^1.0 f5(x) dx = " << q5 << ", eps = " << std::abs(i5 - q5) / q5 << " over " << evaluations << " points" << std::endl;
+                TEST_CHECK_RELATIVE_ERROR(i5, q5, eps);
+                TEST_CHECK(17u < evaluations);
+                TEST_CHECK(17u + 33u > evaluations);
+
+                auto f6 = std::function<complex<double> (const double &)>([](const double & x) { return complex<double>(f1(x), std::cos(25.0 * x)); });
+                complex<double> q6 = integrate1D(f6, 16, 0.0, 1.0, evaluations);
+                TEST_CHECK_RELATIVE_ERROR(1.0, real(q6), eps);
+                TEST_CHECK_RELATIVE_ERROR(i5, imag(q6), eps);
+
+                auto f7 = std::function<std::array<double, 2> (const double &)>([](const double & x) { return std::array<double, 2>{{ f1(x), std::cos(25.0 * x) }}; });
+                std::array<double, 2> q7 = integrate1D(f7, 16, 0.0, 1.0, evaluations);
+                TEST_CHECK_RELATIVE_ERROR(1.0, q7[0], eps);
+                TEST_CHECK_RELATIVE_ERROR(i5, q7[1], eps);
+                TEST_CHECK(17u < evaluations);
+            }
+
+            // a warning is logged once the refinement budget is exhausted
+            {
+                // the values on the sampling grid are chosen such that the finest Simpson estimate
+                // always vanishes, while the coarser ones do not; the extrapolation never succeeds
+                auto f8 = std::function<double (const double &)>([](const double & x)
+                {
+                    int level = 0;
+                    for (double y = x ; y != std::floor(y) ; y *= 2.0)
+                    {
+                        ++level;
+                    }
+
+                    return (level <= 3) ? 1.0 : -std::ldexp(1.0, 7 - 2 * level);
+                });
+
+                std::stringstream log;
+                Log::instance()->set_log_stream(&log);
+
+                unsigned evaluations = 0;
+                integrate1D(f8, 16, 0.0, 1.0, evaluations);
+
+                Log::instance()->set_log_stream(&std::cerr);
+
+                TEST_CHECK(17u + 16u * 8u <= evaluations);
+                TEST_CHECK(std::string::npos != log.str().find("[WARNING integrate1D]"));
+            }
+
             auto config_QNG = GSL::QNG::Config().epsrel(eps);
             q4 = integrate<GSL::QNG>(f4obj, 1.0, std::exp(1), config_QNG);
             std::cout << "\\int_0.0^exp(1) f4(x) dx = " << q4 << ", eps = " << std::abs(i4 - q4) / q4 << " with QNG" << std::endl;
             TEST_CHECK_RELATIVE_ERROR(i4, q4, eps);
 
             auto config_QAGS = GSL::QAGS::Config().epsrel(1e-12);
+            auto config_QAG  = GSL::QAG::Config().epsrel(1e-12);
             q4 = integrate<GSL::QAGS>(f4obj, 1.0, std::exp(1), config_QAGS);
             std::cout << "\\int_0.0^exp(1) f4(x) dx = " << q4 << ", eps = " << std::abs(i4 - q4) / q4 << " with QAGS" << std::endl;
             TEST_CHECK_RELATIVE_ERROR(i4, q4, eps);
 
+            // vector-valued integrand on a common subdivision
+            {
+                std::function<std::array<double, 3> (const double &)> f = [](const double & x) -> std::array<double, 3> {
+                    return std::array<double, 3>{{ f4(x), x * x, 0.0 }};
+                };
+                const std::array<double, 3> q = integrate<GSL::QAG>(f, 1.0, std::exp(1), config_QAG);
+                TEST_CHECK_RELATIVE_ERROR(i4, q[0], 1e-12);
+                TEST_CHECK_RELATIVE_ERROR((std::exp(3) - 1.0) / 3.0, q[1], 1e-12);
+                TEST_CHECK_EQUAL(0.0, q[2]);
+            }
+
             auto config_cubature = cubature::Config().epsrel(eps);
             auto f4lam = [](const std::array<double, 1> &args) -> double {
                 return f4(args[0]);
@@ -111,5 +178,36 @@ class IntegrateTest :
             };
             auto q5 = integrate(cubature::fdd<dim>(f5lam), a_5, b_5, config_cubature);
             TEST_CHECK_RELATIVE_ERROR(q5, 1.0, eps);
+
+            // batch integrand
+            auto f5batch = [&f5lam](const std::vector<std::array<double, dim>> & x, std::vector<double> & values) {
+                for (size_t i = 0 ; i < x.size() ; ++i)
+                    values[i] = f5lam(x[i]);
+            };
+            auto q5_batch = integrate(cubature::fdd_v<dim>(f5batch), a_5, b_5, config_cubature);
+            TEST_CHECK_EQUAL(q5, q5_batch);
+
+            // parallel evaluation of the points
+            auto q5_parallel = integrate(cubature::fdd<dim>(f5lam), a_5, b_5, cubature::Config(config_cubature).parallel(true));
+            TEST_CHECK_EQUAL(q5, q5_parallel);
+
+            auto q5_batch_parallel = integrate(cubature::fdd_v<dim>(f5batch), a_5, b_5, cubature::Config(config_cubature).parallel(true));
+            TEST_CHECK_EQUAL(q5, q5_batch_parallel);
+
+            // exceptions raised by the integrand reach the caller
+            auto f5throw = [](const std::array<double, dim> &) -> double { throw InternalError("integrand failed"); };
+            TEST_CHECK_THROWS(InternalError, integrate(cubature::fdd<dim>(f5throw), a_5, b_5, config_cubature));
+            TEST_CHECK_THROWS(InternalError, integrate(cubature::fdd<dim>(f5throw), a_5, b_5, cubature::Config(config_cubature).parallel(true)));
+
+            auto f5short = [](const std::vector<std::array<double, dim>> &, std::vector<double> & values) { values.clear(); };
+            TEST_CHECK_THROWS(IntegrationError, integrate(cubature::fdd_v<dim>(f5short), a_5, b_5, config_cubature));
+
+            // vector-valued integrand on a common subdivision
+            auto f45lam = [&f5lam](const std::array<double, dim> & args) -> std::array<double, 2> {
+                return std::array<double, 2>{{ f5lam(args), 3.0 * args[0] * args[0] }};
+            };
+            auto q45 = integrate(cubature::fvd<dim, 2>(f45lam), a_5, b_5, config_cubature);
+            TEST_CHECK_RELATIVE_ERROR(q45[0], 1.0, eps);
+            TEST_CHECK_RELATIVE_ERROR(q45[1], 1.0, eps);
         }
 } model_test;
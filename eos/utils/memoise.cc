@@ -38,6 +38,14 @@ namespace eos
         _clear_functions.push_back(clear_function);
     }
 
+    void
+    MemoisationControl::register_statistics_function(const std::function<MemoisationStatistics ()> & statistics_function)
+    {
+        Lock l(*_mutex);
+
+        _statistics_functions.push_back(statistics_function);
+    }
+
     void
     MemoisationControl::clear()
     {
@@ -48,4 +56,18 @@ namespace eos
             (*c)();
         }
     }
+
+    MemoisationStatistics
+    MemoisationControl::statistics() const
+    {
+        Lock l(*_mutex);
+
+        MemoisationStatistics result;
+        for (auto s = _statistics_functions.cbegin(), s_end = _statistics_functions.cend() ; s != s_end ; ++s)
+        {
+            result += (*s)();
+        }
+
+        return result;
+    }
 }
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2013 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2013, 2020 Danny van Dyk
  * Copyright (c) 2010 Christian Wacker
  *
  * This file is part of the EOS project. EOS is free software;
@@ -26,6 +26,8 @@
 #include <eos/utils/lock.hh>
 #include <eos/utils/mutex.hh>
 
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <functional>
 #include <tuple>
@@ -49,12 +51,29 @@ namespace std
         }
     }
 
+    /* Finalisation step of the SplitMix64 generator, which lets every input bit affect every output bit. */
+    inline uint64_t __hash_mix(uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+
+        return x;
+    }
+
+    inline uint64_t __hash_combine(const uint64_t & seed, const uint64_t & value)
+    {
+        return seed ^ (__hash_mix(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    }
+
     template <unsigned n_, typename ... T_>
     struct __TupleHasher
     {
         static uint64_t hash(const std::tuple<T_ ...> & t)
         {
-            return __TupleHasher<n_ - 1, T_ ...>::hash(t) ^ __hash_one<decltype(std::get<n_>(t))>(std::get<n_>(t));
+            return __hash_combine(__TupleHasher<n_ - 1, T_ ...>::hash(t), __hash_one<decltype(std::get<n_>(t))>(std::get<n_>(t)));
         }
     };
 
@@ -63,7 +82,7 @@ namespace std
     {
         static uint64_t hash(const std::tuple<T_ ...> & t)
         {
-            return __hash_one<decltype(std::get<0>(t))>(std::get<0>(t));
+            return __hash_mix(__hash_one<decltype(std::get<0>(t))>(std::get<0>(t)));
         }
     };
 
@@ -94,8 +113,52 @@ namespace eos
         {
             typedef Result_ Type;
         };
+
+        template <typename T_> bool is_nan(const T_ &)
+        {
+            return false;
+        }
+
+        inline bool is_nan(const double & x)
+        {
+            return std::isnan(x);
+        }
+
+        inline bool any_is_nan()
+        {
+            return false;
+        }
+
+        template <typename T_, typename ... Rest_> bool any_is_nan(const T_ & t, const Rest_ & ... rest)
+        {
+            return is_nan(t) || any_is_nan(rest ...);
+        }
     }
 
+    /*!
+     * Counters for the accesses to one or more Memoiser objects.
+     */
+    struct MemoisationStatistics
+    {
+        /// Number of calls that were answered from the cache.
+        unsigned long hits = 0;
+
+        /// Number of calls that required a new evaluation.
+        unsigned long misses = 0;
+
+        /// Number of cached results that were discarded to make room for new ones.
+        unsigned long evictions = 0;
+
+        MemoisationStatistics & operator+= (const MemoisationStatistics & rhs)
+        {
+            hits += rhs.hits;
+            misses += rhs.misses;
+            evictions += rhs.evictions;
+
+            return *this;
+        }
+    };
+
     class MemoisationControl :
         public InstantiationPolicy<MemoisationControl, Singleton>
     {
@@ -104,6 +167,8 @@ namespace eos
 
             std::vector<std::function<void ()>> _clear_functions;
 
+            std::vector<std::function<MemoisationStatistics ()>> _statistics_functions;
+
         public:
             MemoisationControl();
 
@@ -111,9 +176,25 @@ namespace eos
 
             void register_clear_function(const std::function<void ()> & clear_function);
 
+            void register_statistics_function(const std::function<MemoisationStatistics ()> & statistics_function);
+
             void clear();
+
+            /// Retrieve the accumulated counters of all memoisers.
+            MemoisationStatistics statistics() const;
     };
 
+    /*!
+     * Memoiser caches the results of calls to one kind of function.
+     *
+     * The cache is split into shards, each of which is protected by its own mutex, so that concurrent
+     * callers rarely contend for the same lock. The function itself is evaluated outside of any lock.
+     * Each shard has a fixed capacity; once it is full, the shard's entries are evicted one at a
+     * time following the CLOCK (second chance) policy.
+     *
+     * The access statistics are kept per function. Calls with NaN arguments are evaluated, but not
+     * memoised, since their keys would never compare equal to any later call.
+     */
     template <typename Result_, typename ... Params_>
     class Memoiser :
         public InstantiationPolicy<Memoiser<Result_, Params_ ...>, Singleton>
@@ -123,56 +204,188 @@ namespace eos
             typedef std::tuple<FunctionType, Params_...> KeyType;
 
         private:
-            Mutex * const _mutex;
+            static constexpr unsigned number_of_shards = 16;
+
+            static constexpr unsigned capacity_per_shard = 100000u / number_of_shards;
+
+            struct Entry
+            {
+                KeyType key;
+
+                Result_ result;
+
+                bool referenced;
+            };
+
+            struct Shard
+            {
+                Mutex mutex;
+
+                // index into entries by key
+                std::unordered_map<KeyType, unsigned> index;
+
+                std::vector<Entry> entries;
+
+                // position of the CLOCK hand within entries
+                unsigned hand = 0;
+
+                std::unordered_map<FunctionType, MemoisationStatistics> statistics;
+            };
+
+            mutable std::array<Shard, number_of_shards> _shards;
+
+            Shard & shard(const KeyType & key) const
+            {
+                // the upper bits of the hash are least correlated with the bucket index within the shard
+                return _shards[(static_cast<uint64_t>(std::hash<KeyType>()(key)) >> 32) % number_of_shards];
+            }
+
+            void insert(Shard & s, const KeyType & key, const Result_ & result)
+            {
+                // another thread might have inserted the same key in the meantime
+                if (s.index.end() != s.index.find(key))
+                    return;
+
+                if (s.entries.size() < capacity_per_shard)
+                {
+                    s.index.emplace(key, s.entries.size());
+                    s.entries.push_back(Entry{ key, result, false });
 
-            std::unordered_map<KeyType, Result_> _memoisations;
+                    return;
+                }
+
+                // advance the hand, giving a second chance to all recently used entries
+                while (s.entries[s.hand].referenced)
+                {
+                    s.entries[s.hand].referenced = false;
+                    s.hand = (s.hand + 1) % capacity_per_shard;
+                }
+
+                Entry & victim = s.entries[s.hand];
+                const KeyType victim_key = victim.key;
+                s.index.erase(victim.key);
+                s.index.emplace(key, s.hand);
+                victim = Entry{ key, result, false };
+                s.hand = (s.hand + 1) % capacity_per_shard;
+
+                ++s.statistics[std::get<0>(victim_key)].evictions;
+            }
 
         public:
-            Memoiser() :
-                _mutex(new Mutex)
+            Memoiser()
             {
                 MemoisationControl::instance()->register_clear_function(std::bind(&Memoiser<Result_, Params_ ...>::clear, this));
+                MemoisationControl::instance()->register_statistics_function([this] () { return this->statistics(); });
             }
 
             ~Memoiser()
             {
-                delete _mutex;
             }
 
             Result_ operator() (const FunctionType & f, const Params_ & ... p)
             {
-                Lock l(*_mutex);
-
                 KeyType key(f, p ...);
-                auto i = _memoisations.find(key);
+                Shard & s = shard(key);
+
+                if (implementation::any_is_nan(p ...))
+                {
+                    {
+                        Lock l(s.mutex);
 
-                if (_memoisations.end() != i)
-                    return i->second;
+                        ++s.statistics[f].misses;
+                    }
 
-                Result_ result = f(p ...);
+                    return f(p ...);
+                }
 
-                if (_memoisations.size() > 100000u)
                 {
-                    _memoisations.clear();
+                    Lock l(s.mutex);
+
+                    auto i = s.index.find(key);
+                    if (s.index.end() != i)
+                    {
+                        Entry & e = s.entries[i->second];
+                        e.referenced = true;
+                        ++s.statistics[f].hits;
+
+                        return e.result;
+                    }
+
+                    ++s.statistics[f].misses;
                 }
 
-                _memoisations.insert(std::pair<KeyType, Result_>(key, result));
+                Result_ result = f(p ...);
+
+                {
+                    Lock l(s.mutex);
+
+                    insert(s, key, result);
+                }
 
                 return result;
             }
 
             void clear()
             {
-                Lock l(*_mutex);
+                for (auto & s : _shards)
+                {
+                    Lock l(s.mutex);
 
-                _memoisations.clear();
+                    s.index.clear();
+                    s.entries.clear();
+                    s.hand = 0;
+                }
             }
 
             unsigned number_of_memoisations() const
             {
-                Lock l(*_mutex);
+                unsigned result = 0;
+
+                for (auto & s : _shards)
+                {
+                    Lock l(s.mutex);
+
+                    result += s.entries.size();
+                }
+
+                return result;
+            }
+
+            /// Retrieve the counters of all functions.
+            MemoisationStatistics statistics() const
+            {
+                MemoisationStatistics result;
 
-                return _memoisations.size();
+                for (auto & s : _shards)
+                {
+                    Lock l(s.mutex);
+
+                    for (const auto & t : s.statistics)
+                    {
+                        result += t.second;
+                    }
+                }
+
+                return result;
+            }
+
+            /// Retrieve the counters of one function.
+            MemoisationStatistics statistics(const FunctionType & f) const
+            {
+                MemoisationStatistics result;
+
+                for (auto & s : _shards)
+                {
+                    Lock l(s.mutex);
+
+                    auto t = s.statistics.find(f);
+                    if (s.statistics.end() != t)
+                    {
+                        result += t->second;
+                    }
+                }
+
+                return result;
             }
     };
 
@@ -187,6 +400,12 @@ namespace eos
     {
         return Memoiser<typename implementation::ResultOf<FunctionType_>::Type, Params ...>::instance()->number_of_memoisations();
     }
+
+    template <typename FunctionType_, typename ... Params>
+    MemoisationStatistics memoisation_statistics(FunctionType_ f, const Params & ...)
+    {
+        return Memoiser<typename implementation::ResultOf<FunctionType_>::Type, Params ...>::instance()->statistics(f);
+    }
 }
 
 #endif
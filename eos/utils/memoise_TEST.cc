@@ -20,7 +20,9 @@
 #include <test/test.hh>
 #include <eos/utils/memoise.hh>
 
+#include <cmath>
 #include <complex>
+#include <limits>
 
 using namespace test;
 using namespace eos;
@@ -39,6 +41,11 @@ class MemoiseTest :
             return x / y;
         }
 
+        static double f3(const double & x, const double & y)
+        {
+            return x + y;
+        }
+
         static std::complex<double> f2(const double & x, const double & y)
         {
             return std::complex<double>(x, y);
@@ -92,6 +99,21 @@ class MemoiseTest :
                 TEST_CHECK_EQUAL(2, number_of_memoisations(f2, 0.0, 0.0));
             }
 
+            /* Test the access statistics */
+            {
+                // f1 was memoised twice, and retrieved twice from the cache
+                MemoisationStatistics statistics = memoisation_statistics(f1, 0.0, 0.0);
+                TEST_CHECK_EQUAL(2, statistics.hits);
+                TEST_CHECK_EQUAL(2, statistics.misses);
+                TEST_CHECK_EQUAL(0, statistics.evictions);
+
+                // f2 was memoised twice, and retrieved six times from the cache
+                statistics = MemoisationControl::instance()->statistics();
+                TEST_CHECK_EQUAL(8, statistics.hits);
+                TEST_CHECK_EQUAL(4, statistics.misses);
+                TEST_CHECK_EQUAL(0, statistics.evictions);
+            }
+
             /* Test clearing all memoisations */
             {
                 // There should be 2 memoisations per function
@@ -104,5 +126,55 @@ class MemoiseTest :
                 TEST_CHECK_EQUAL(0, number_of_memoisations(f1, 0.0, 0.0));
                 TEST_CHECK_EQUAL(0, number_of_memoisations(f2, 0.0, 0.0));
             }
+
+            /* Test eviction of old memoisations */
+            {
+                const unsigned n = 200000;
+                for (unsigned i = 0 ; i < n ; ++i)
+                {
+                    memoise(f1, double(i), 1.0);
+                }
+
+                // the number of memoisations is bounded
+                TEST_CHECK(number_of_memoisations(f1, 0.0, 0.0) <= 100000);
+                TEST_CHECK(number_of_memoisations(f1, 0.0, 0.0) > 0);
+
+                MemoisationStatistics statistics = memoisation_statistics(f1, 0.0, 0.0);
+                TEST_CHECK_EQUAL(2 + n, statistics.misses);
+                TEST_CHECK_EQUAL(n, number_of_memoisations(f1, 0.0, 0.0) + statistics.evictions);
+
+                // recent results are still correct
+                TEST_CHECK_EQUAL(double(n - 1), memoise(f1, double(n - 1), 1.0));
+            }
+
+            /* Test that functions of the same signature keep separate statistics */
+            {
+                const MemoisationStatistics before = memoisation_statistics(f1, 0.0, 0.0);
+
+                TEST_CHECK_EQUAL(3.0, memoise(f3, 1.0, 2.0));
+                TEST_CHECK_EQUAL(3.0, memoise(f3, 1.0, 2.0));
+
+                MemoisationStatistics statistics = memoisation_statistics(f3, 0.0, 0.0);
+                TEST_CHECK_EQUAL(1, statistics.hits);
+                TEST_CHECK_EQUAL(1, statistics.misses);
+
+                statistics = memoisation_statistics(f1, 0.0, 0.0);
+                TEST_CHECK_EQUAL(before.hits,   statistics.hits);
+                TEST_CHECK_EQUAL(before.misses, statistics.misses);
+            }
+
+            /* Test that calls with NaN arguments are evaluated, but not memoised */
+            {
+                MemoisationControl::instance()->clear();
+
+                const double nan = std::numeric_limits<double>::quiet_NaN();
+                TEST_CHECK(std::isnan(memoise(f3, nan, 1.0)));
+                TEST_CHECK(std::isnan(memoise(f3, nan, 1.0)));
+                TEST_CHECK_EQUAL(0, number_of_memoisations(f3, 0.0, 0.0));
+
+                MemoisationStatistics statistics = memoisation_statistics(f3, 0.0, 0.0);
+                TEST_CHECK_EQUAL(1, statistics.hits);
+                TEST_CHECK_EQUAL(3, statistics.misses);
+            }
         }
 } memoise_test;
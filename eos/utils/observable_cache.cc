@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011, 2016 Danny van Dyk
+ * Copyright (c) 2011, 2016, 2020 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
  *
  * This file is part of the EOS project. EOS is free software;
@@ -21,10 +21,12 @@
 #include <eos/utils/observable_cache.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/thread_pool.hh>
 
 #include <algorithm>
 #include <limits>
 #include <map>
+#include <numeric>
 #include <tuple>
 #include <vector>
 
@@ -42,8 +44,29 @@ namespace eos
         // Store values of observables
         std::vector<double> predictions;
 
+        // Evaluate the observables concurrently?
+        bool parallel;
+
+        // Only re-evaluate observables whose used parameters changed?
+        bool incremental;
+
+        // Generation of the parameters at the last update, and whether all predictions are valid
+        unsigned long last_generation;
+
+        bool valid;
+
+        // Flags which observables need to be re-evaluated in the current update
+        std::vector<char> dirty;
+
+        // Indices of the observables, grouped for concurrent evaluation
+        std::vector<std::vector<unsigned>> groups;
+
         Implementation(const Parameters & parameters) :
-            parameters(parameters)
+            parameters(parameters),
+            parallel(false),
+            incremental(false),
+            last_generation(0),
+            valid(false)
         {
         }
 
@@ -59,10 +82,135 @@ namespace eos
             if (result.second)
             {
                 predictions.push_back(std::numeric_limits<double>::quiet_NaN());
+                groups.clear();
+                valid = false;
             }
 
             return result.first;
         }
+
+        // Determine which observables need to be re-evaluated
+        void mark_dirty()
+        {
+            dirty.resize(observables.size());
+
+            if (! incremental || ! valid)
+            {
+                std::fill(dirty.begin(), dirty.end(), 1);
+                return;
+            }
+
+            auto d = dirty.begin();
+            for (auto o = observables.begin(), o_end = observables.end() ; o != o_end ; ++o, ++d)
+            {
+                // observables which do not report any used parameters are always re-evaluated
+                *d = ((*o)->begin() == (*o)->end()) || parameters.changed_since(**o, last_generation);
+            }
+        }
+
+        void update_serially()
+        {
+            auto p = predictions.begin();
+            auto d = dirty.cbegin();
+
+            for (auto o = observables.begin(), o_end = observables.end() ; o != o_end ; ++o, ++p, ++d)
+            {
+                if (! *d)
+                    continue;
+
+                *p = (*o)->evaluate();
+            }
+        }
+
+        /*
+         * Group the observables for concurrent evaluation.
+         *
+         * Observables that share any mutable object, e.g. a decay, end up in the same group,
+         * since they must not be evaluated concurrently. Groups are never split. Instead, they
+         * are distributed over two bins per thread, largest first into the currently smallest bin.
+         */
+        void make_groups(const unsigned & number_of_threads)
+        {
+            // union-find over the observables' indices
+            std::vector<unsigned> parent(observables.size());
+            std::iota(parent.begin(), parent.end(), 0u);
+
+            auto find = [&parent] (unsigned i)
+            {
+                while (parent[i] != i)
+                {
+                    parent[i] = parent[parent[i]];
+                    i = parent[i];
+                }
+
+                return i;
+            };
+
+            std::map<const void *, unsigned> owners;
+            for (unsigned i = 0 ; i < observables.size() ; ++i)
+            {
+                for (const void * object : observables[i]->shared_objects())
+                {
+                    auto o = owners.insert(std::make_pair(object, i));
+                    if (o.second)
+                        continue;
+
+                    parent[find(i)] = find(o.first->second);
+                }
+            }
+
+            std::map<unsigned, std::vector<unsigned>> groups_by_root;
+            for (unsigned i = 0 ; i < observables.size() ; ++i)
+            {
+                groups_by_root[find(i)].push_back(i);
+            }
+
+            std::vector<std::vector<unsigned>> atomic_groups;
+            atomic_groups.reserve(groups_by_root.size());
+            for (auto & g : groups_by_root)
+            {
+                atomic_groups.push_back(std::move(g.second));
+            }
+
+            std::stable_sort(atomic_groups.begin(), atomic_groups.end(),
+                    [] (const std::vector<unsigned> & a, const std::vector<unsigned> & b) { return a.size() > b.size(); });
+
+            const unsigned number_of_bins = std::min<unsigned>(atomic_groups.size(), 2 * number_of_threads);
+
+            groups.assign(number_of_bins, std::vector<unsigned>());
+            for (auto & g : atomic_groups)
+            {
+                auto bin = std::min_element(groups.begin(), groups.end(),
+                        [] (const std::vector<unsigned> & a, const std::vector<unsigned> & b) { return a.size() < b.size(); });
+
+                bin->insert(bin->end(), g.cbegin(), g.cend());
+            }
+        }
+
+        void update_concurrently()
+        {
+            ThreadPool * pool = ThreadPool::instance();
+
+            if ((pool->number_of_threads() < 2) || (observables.size() < 2))
+                return update_serially();
+
+            if (groups.empty())
+                make_groups(pool->number_of_threads());
+
+            pool->parallel_for(0, groups.size(), 1, [this] (const unsigned long & begin, const unsigned long & end)
+            {
+                for (auto g = begin ; g != end ; ++g)
+                {
+                    for (auto i : groups[g])
+                    {
+                        if (! dirty[i])
+                            continue;
+
+                        predictions[i] = observables[i]->evaluate();
+                    }
+                }
+            });
+        }
     };
 
     ObservableCache::ObservableCache(const Parameters & parameters) :
@@ -83,13 +231,46 @@ namespace eos
     void
     ObservableCache::update()
     {
-        // evaluate all observables
-        auto p = _imp->predictions.begin();
+        unsigned long generation = _imp->parameters.generation();
+
+        _imp->mark_dirty();
 
-        for (auto o = _imp->observables.begin(), o_end = _imp->observables.end() ; o != o_end ; ++o, ++p)
+        // evaluate all (changed) observables
+        if (_imp->parallel)
         {
-            *p = (*o)->evaluate();
+            _imp->update_concurrently();
         }
+        else
+        {
+            _imp->update_serially();
+        }
+
+        _imp->last_generation = generation;
+        _imp->valid = true;
+    }
+
+    void
+    ObservableCache::set_parallel(const bool & parallel)
+    {
+        _imp->parallel = parallel;
+    }
+
+    bool
+    ObservableCache::parallel() const
+    {
+        return _imp->parallel;
+    }
+
+    void
+    ObservableCache::set_incremental(const bool & incremental)
+    {
+        _imp->incremental = incremental;
+    }
+
+    bool
+    ObservableCache::incremental() const
+    {
+        return _imp->incremental;
     }
 
     Parameters
@@ -132,6 +313,8 @@ namespace eos
     ObservableCache::clone(const Parameters & parameters) const
     {
         ObservableCache result(parameters);
+        result._imp->parallel = _imp->parallel;
+        result._imp->incremental = _imp->incremental;
 
         for (auto o = _imp->observables.begin(), o_end = _imp->observables.end() ; o != o_end ; ++o)
         {
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011 Danny van Dyk
+ * Copyright (c) 2011, 2020 Danny van Dyk
  * Copyright (c) 2011 Frederik Beaujean
  *
  * This file is part of the EOS project. EOS is free software;
@@ -59,6 +59,37 @@ namespace eos
             /// Update the predictions for all observables.
             void update();
 
+            /*!
+             * Select whether update() evaluates the observables concurrently.
+             *
+             * In parallel mode, observables that share any mutable object (see Observable::shared_objects)
+             * are grouped, such that they are evaluated in sequence by one thread. The groups are never
+             * split, and are distributed across the ThreadPool.
+             *
+             * @param parallel If true, evaluate the observables concurrently.
+             */
+            void set_parallel(const bool & parallel);
+
+            /// Retrieve whether update() evaluates the observables concurrently.
+            bool parallel() const;
+
+            /*!
+             * Select whether update() re-evaluates only those observables whose used
+             * parameters changed since the last update.
+             *
+             * Changes are detected through the ids reported by each observable as a ParameterUser,
+             * and the generation counters of the common Parameters object. Observables that do not
+             * report any used parameters are always re-evaluated.
+             *
+             * @note Changes to the observables' kinematics are not detected in this mode.
+             *
+             * @param incremental If true, skip the evaluation of unchanged observables.
+             */
+            void set_incremental(const bool & incremental);
+
+            /// Retrieve whether update() skips the evaluation of unchanged observables.
+            bool incremental() const;
+
             /// Retrieve the cache's common Parameters object.
             Parameters parameters() const;
 
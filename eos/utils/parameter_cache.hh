@@ -0,0 +1,201 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_UTILS_PARAMETER_CACHE_HH
+#define EOS_GUARD_SRC_UTILS_PARAMETER_CACHE_HH 1
+
+#include <eos/utils/instantiation_policy.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/parameters.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Cache for results that depend on a fixed set of parameters.
+     *
+     * The results are keyed on the arguments of the cached computation. All entries
+     * are discarded as soon as any of the watched parameters changes its numeric value.
+     * Access is thread safe, while the computation itself runs without holding the lock.
+     * Each thread remembers its last result per cache type, so that repeated lookups of
+     * the same key within one generation neither take the lock nor search the entries.
+     *
+     * The watched parameters are either given explicitly, or as all the parameters used
+     * by a ParameterUser at the time of the lookup.
+     */
+    template <typename Key_, typename Value_>
+    class ParameterCache :
+        public InstantiationPolicy<ParameterCache<Key_, Value_>, NonCopyable>
+    {
+        private:
+            /// Largest generation at which any of the watched parameters changed.
+            std::function<unsigned long ()> _current_generation;
+
+            mutable Mutex _mutex;
+
+            mutable unsigned long _generation;
+
+            mutable std::map<Key_, Value_> _entries;
+
+            /// Unique identifier of this cache, used to tag the thread-local last lookup.
+            const unsigned long _id;
+
+            /// The last result retrieved by the current thread from any cache of this type.
+            struct LastLookup
+            {
+                unsigned long id = 0;
+                unsigned long generation = 0;
+                Key_ key;
+                Value_ value;
+            };
+
+            static unsigned long next_id()
+            {
+                static std::atomic<unsigned long> counter(0);
+
+                return ++counter;
+            }
+
+            static LastLookup & last_lookup()
+            {
+                static thread_local LastLookup result;
+
+                return result;
+            }
+
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param parameters The parameters on which the cached results depend.
+             */
+            ParameterCache(const std::initializer_list<Parameter> & parameters) :
+                _current_generation([parameters = std::vector<Parameter>(parameters)] ()
+                {
+                    unsigned long result = 0;
+                    for (const auto & p : parameters)
+                    {
+                        result = std::max(result, p.generation());
+                    }
+
+                    return result;
+                }),
+                _generation(0),
+                _id(next_id())
+            {
+            }
+
+            /*!
+             * Constructor.
+             *
+             * The ParameterUser must outlive the cache. Parameters that it starts to use
+             * after the construction of the cache are watched as well.
+             *
+             * @param parameters The parameters object from which the watched parameters are taken.
+             * @param user       The user of all parameters on which the cached results depend.
+             */
+            ParameterCache(const Parameters & parameters, const ParameterUser & user) :
+                _current_generation([parameters, &user] () { return parameters.generation(user); }),
+                _generation(0),
+                _id(next_id())
+            {
+            }
+            ///@}
+
+            /*!
+             * Retrieve the result for a given key, computing it if needed.
+             *
+             * @param key     The arguments of the cached computation.
+             * @param compute The computation that yields the result for this key.
+             */
+            template <typename Compute_>
+            Value_ operator() (const Key_ & key, const Compute_ & compute) const
+            {
+                static const unsigned max_entries = 64;
+
+                const unsigned long generation = _current_generation();
+
+                // lock-free fast path: repeated lookup of the same key by the same thread
+                LastLookup & last = last_lookup();
+                if ((last.id == _id) && (last.generation == generation) && (last.key == key))
+                    return last.value;
+
+                Value_ result;
+                bool found = false;
+                {
+                    Lock l(_mutex);
+
+                    if (generation != _generation)
+                    {
+                        _entries.clear();
+                        _generation = generation;
+                    }
+
+                    auto i = _entries.find(key);
+                    if (_entries.end() != i)
+                    {
+                        result = i->second;
+                        found = true;
+                    }
+                }
+
+                if (found)
+                {
+                    last.id = _id;
+                    last.generation = generation;
+                    last.key = key;
+                    last.value = result;
+
+                    return result;
+                }
+
+                result = compute();
+
+                {
+                    Lock l(_mutex);
+
+                    if (generation == _generation)
+                    {
+                        if (_entries.size() >= max_entries)
+                            _entries.clear();
+
+                        _entries.emplace(key, result);
+                    }
+                }
+
+                last.id = _id;
+                last.generation = generation;
+                last.key = key;
+                last.value = result;
+
+                return result;
+            }
+    };
+}
+
+#endif
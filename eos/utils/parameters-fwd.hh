@@ -26,6 +26,7 @@ namespace eos
     class Parameter;
     class ParameterGroup;
     class ParameterSection;
+    class ParameterUser;
 }
 
 #endif
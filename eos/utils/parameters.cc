@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2020 Danny van Dyk
  * Copyright (c) 2010 Christian Wacker
  *
  * This file is part of the EOS project. EOS is free software;
@@ -20,14 +20,20 @@
 
 #include <config.h>
 
+#include <eos/utils/binary-database.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/parameters.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qualified-name.hh>
 #include <eos/utils/stringify.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <map>
 #include <random>
 #include <vector>
@@ -180,24 +186,63 @@ namespace eos
         std::string latex;
     };
 
-    struct Parameter::Data :
-        Parameter::Template
+    struct Parameter::Data
     {
         double value;
 
-        Parameter::Id id;
+        // The generation of the parent Parameters object at the last change of value
+        unsigned long generation;
 
-        Data(const Parameter::Template & t, const Parameter::Id & i) :
-            Parameter::Template(t),
+        Data(const Parameter::Template & t) :
             value(t.central),
-            id(i)
+            generation(0)
         {
         }
     };
 
     struct Parameters::Data
     {
+        // The meta data of all parameters. It is shared among copies, and must be replaced rather than modified while shared.
+        std::shared_ptr<std::vector<Parameter::Template>> templates;
+
         std::vector<Parameter::Data> data;
+
+        // Incremented whenever any parameter's value changes
+        unsigned long generation = 0;
+
+        Data(const std::shared_ptr<std::vector<Parameter::Template>> & templates) :
+            templates(templates),
+            data(templates->cbegin(), templates->cend())
+        {
+        }
+
+        void set(const unsigned & index, const double & value)
+        {
+            Parameter::Data & d = data[index];
+
+            if (d.value == value)
+                return;
+
+            d.value = value;
+            d.generation = ++generation;
+        }
+
+        // Copy-on-write access to the meta data
+        std::vector<Parameter::Template> & unshared_templates()
+        {
+            if (templates.use_count() > 1)
+                templates = std::make_shared<std::vector<Parameter::Template>>(*templates);
+
+            return *templates;
+        }
+
+        unsigned append(const Parameter::Template & t)
+        {
+            unshared_templates().push_back(t);
+            data.push_back(Parameter::Data(t));
+
+            return data.size() - 1;
+        }
     };
 
     template <>
@@ -217,37 +262,379 @@ namespace eos
     template <>
     struct Implementation<Parameters>
     {
-        std::shared_ptr<Parameters::Data> parameters_data;
+        struct ParameterGroupTemplate
+        {
+            std::string name;
 
-        std::map<std::string, unsigned> parameters_map;
+            std::string description;
 
-        std::vector<Parameter> parameters;
+            std::vector<Parameter::Id> ids;
+        };
 
-        std::vector<ParameterSection> sections;
+        struct ParameterSectionTemplate
+        {
+            // the stem of the input file
+            std::string source;
+
+            std::string name;
+
+            std::string description;
+
+            std::vector<ParameterGroupTemplate> groups;
+        };
 
-        Implementation(const std::initializer_list<Parameter::Template> & list) :
-            parameters_data(new Parameters::Data)
+        /*!
+         * The default parameters as parsed from the parameter input files.
+         *
+         * The input files are parsed once per process. All objects returned by
+         * Parameters::Defaults() share the resulting meta data.
+         */
+        struct DefaultParameters :
+            public InstantiationPolicy<DefaultParameters, Singleton>
         {
-            unsigned idx(0);
-            for (auto i(list.begin()), i_end(list.end()) ; i != i_end ; ++i, ++idx)
+            std::shared_ptr<std::vector<Parameter::Template>> templates;
+
+            std::shared_ptr<std::map<std::string, unsigned>> parameters_map;
+
+            std::shared_ptr<std::vector<ParameterSectionTemplate>> sections;
+
+            DefaultParameters() :
+                DefaultParameters(base_directory(), true)
+            {
+            }
+
+            DefaultParameters(const fs::path & base, const bool & use_database) :
+                templates(std::make_shared<std::vector<Parameter::Template>>()),
+                parameters_map(std::make_shared<std::map<std::string, unsigned>>()),
+                sections(std::make_shared<std::vector<ParameterSectionTemplate>>())
+            {
+                if (! fs::exists(base))
+                {
+                    throw InternalError("Could not find the parameter input files");
+                }
+
+                if (! fs::is_directory(base))
+                {
+                    throw InternalError("Expect '" + base.string() + " to be a directory");
+                }
+
+                const std::string database_file = (base / "parameters.db").string();
+                if (use_database && BinaryDatabase::up_to_date(database_file, base.string()))
+                {
+                    try
+                    {
+                        read_database(database_file);
+
+                        return;
+                    }
+                    catch (Exception & e)
+                    {
+                        Log::instance()->message("[parameters.defaults]", ll_warning)
+                            << "Ignoring the parameter database: " << e.what();
+
+                        templates->clear();
+                        parameters_map->clear();
+                        sections->clear();
+                    }
+                }
+
+                read_yaml(base);
+            }
+
+            static fs::path base_directory()
+            {
+                if (std::getenv("EOS_TESTS_PARAMETERS"))
+                {
+                    std::string envvar = std::string(std::getenv("EOS_TESTS_PARAMETERS"));
+                    return fs::system_complete(envvar);
+                }
+                else if (std::getenv("EOS_HOME"))
+                {
+                    std::string envvar = std::string(std::getenv("EOS_HOME"));
+                    return fs::system_complete(envvar) / "parameters";
+                }
+                else
+                {
+                    return fs::system_complete(EOS_DATADIR "/eos/parameters/");
+                }
+            }
+
+            void add(const std::string & file, ParameterGroupTemplate & group, Parameter::Template && t)
+            {
+                if (parameters_map->end() != parameters_map->find(t.name))
+                {
+                    throw ParameterInputDuplicateError(file, t.name);
+                }
+
+                unsigned idx = templates->size();
+                parameters_map->insert(std::make_pair(t.name, idx));
+                templates->push_back(std::move(t));
+                group.ids.push_back(idx);
+            }
+
+            // One record per section, keyed by the stem of its input file
+            void read_database(const std::string & file)
+            {
+                BinaryDatabase database(file);
+
+                for (std::size_t i = 0 ; i < database.size() ; ++i)
+                {
+                    BinaryRecordReader reader(database.value(i));
+                    ParameterSectionTemplate section;
+                    std::uint64_t number_of_groups;
+
+                    section.source = database.key(i);
+                    reader >> section.name >> section.description >> number_of_groups;
+                    for (std::uint64_t j = 0 ; j < number_of_groups ; ++j)
+                    {
+                        ParameterGroupTemplate group;
+                        std::uint64_t number_of_parameters;
+
+                        reader >> group.name >> group.description >> number_of_parameters;
+                        for (std::uint64_t k = 0 ; k < number_of_parameters ; ++k)
+                        {
+                            Parameter::Template t;
+                            reader >> t.name >> t.min >> t.central >> t.max >> t.latex;
+
+                            add(file, group, std::move(t));
+                        }
+
+                        section.groups.push_back(std::move(group));
+                    }
+
+                    if (! reader.done())
+                        throw BinaryDatabaseError(file, "trailing data in section '" + section.name + "'");
+
+                    sections->push_back(std::move(section));
+                }
+            }
+
+            void write_database(const std::string & file, const std::uint64_t & digest) const
             {
-                parameters_data->data.push_back(Parameter::Data(*i, idx));
-                parameters_map[i->name] = idx;
-                parameters.push_back(Parameter(parameters_data, idx));
+                std::vector<std::pair<std::string, std::string>> records;
+
+                for (const auto & section : *sections)
+                {
+                    BinaryRecordWriter writer;
+
+                    writer << section.name << section.description << std::uint64_t(section.groups.size());
+                    for (const auto & group : section.groups)
+                    {
+                        writer << group.name << group.description << std::uint64_t(group.ids.size());
+                        for (const auto & id : group.ids)
+                        {
+                            const Parameter::Template & t = (*templates)[id];
+                            writer << t.name << t.min << t.central << t.max << t.latex;
+                        }
+                    }
+
+                    records.push_back(std::make_pair(section.source, writer.str()));
+                }
+
+                BinaryDatabase::write(file, records, digest);
+            }
+
+            void read_yaml(const fs::path & base)
+            {
+                for (fs::directory_iterator f(base), f_end ; f != f_end ; ++f)
+                {
+                    auto file_path = f->path();
+
+                    if (! fs::is_regular_file(status(file_path)))
+                        continue;
+
+                    if (".yaml" != file_path.extension().string())
+                        continue;
+
+                    std::string file = file_path.string();
+                    try
+                    {
+                        YAML::Node root_node = YAML::LoadFile(file);
+                        ParameterSectionTemplate section;
+                        section.source = file_path.stem().string();
+
+                        // parse the section metadata
+                        auto section_title_node = root_node["title"];
+                        if (! section_title_node)
+                            throw ParameterInputFileNodeError(file, "/", "has no entry named 'title'");
+                        if (YAML::NodeType::Scalar != section_title_node.Type())
+                            throw ParameterInputFileNodeError(file, "title", "is not a scalar");
+                        section.name = section_title_node.as<std::string>();
+
+                        auto section_desc_node = root_node["description"];
+                        if (! section_desc_node)
+                            throw ParameterInputFileNodeError(file, "/", "has no entry named 'description'");
+                        if (YAML::NodeType::Scalar != section_desc_node.Type())
+                            throw ParameterInputFileNodeError(file, "description", "is not a scalar");
+                        section.description = section_desc_node.as<std::string>();
+
+                        auto section_groups_node = root_node["groups"];
+                        if (! section_groups_node)
+                            throw ParameterInputFileNodeError(file, "/", "has no entry named 'group'");
+                        if (YAML::NodeType::Sequence != section_groups_node.Type())
+                            throw ParameterInputFileNodeError(file, "groups", "is not a sequence");
+
+                        // parse the section's groups
+                        for (auto && group_node : section_groups_node)
+                        {
+                            ParameterGroupTemplate group;
+
+                            auto group_title_node = group_node["title"];
+                            if (! group_title_node)
+                                throw ParameterInputFileNodeError(file, "", "has no entry named 'title'");
+                            if (YAML::NodeType::Scalar != group_title_node.Type())
+                                throw ParameterInputFileNodeError(file, "title", "is not a scalar");
+                            group.name = group_title_node.as<std::string>();
+
+                            auto group_desc_node = group_node["description"];
+                            if (! group_desc_node)
+                                throw ParameterInputFileNodeError(file, group.name, "has no entry named 'description'");
+                            if (YAML::NodeType::Scalar != group_desc_node.Type())
+                                throw ParameterInputFileNodeError(file, "'" + group.name + "'.description", "is not a scalar");
+                            group.description = group_desc_node.as<std::string>();
+
+                            auto group_parameters_node = group_node["parameters"];
+                            if (! group_parameters_node)
+                                throw ParameterInputFileNodeError(file, group.name, "has no entry named 'parameters'");
+                            if (YAML::NodeType::Map != group_parameters_node.Type())
+                                throw ParameterInputFileNodeError(file, "'" + group.name + "'.parameters", "is not a map");
+
+                            // parse the group's parameters
+                            for (auto && p : group_parameters_node)
+                            {
+                                std::string name = p.first.Scalar();
+
+                                double central, min, max;
+
+                                std::string latex;
+
+                                auto central_node = p.second["central"];
+                                if (! central_node)
+                                    throw ParameterInputFileNodeError(file, name, "has no entry named 'central'");
+                                if (YAML::NodeType::Scalar != central_node.Type())
+                                    throw ParameterInputFileNodeError(file, name + ".central", "is not a scalar");
+                                central = central_node.as<double>();
+
+                                auto min_node = p.second["min"];
+                                if (! min_node)
+                                    throw ParameterInputFileNodeError(file, name, "has no entry named 'min'");
+                                if (YAML::NodeType::Scalar != min_node.Type())
+                                    throw ParameterInputFileNodeError(file, name + ".min", "is not a scalar");
+                                min = min_node.as<double>();
+
+                                auto max_node = p.second["max"];
+                                if (! max_node)
+                                    throw ParameterInputFileNodeError(file, name, "has no entry named 'max'");
+                                if (YAML::NodeType::Scalar != max_node.Type())
+                                    throw ParameterInputFileNodeError(file, name + ".max", "is not a scalar");
+                                max = max_node.as<double>();
+
+                                auto latex_node = p.second["latex"];
+                                if (latex_node)
+                                {
+                                    if (YAML::NodeType::Scalar != latex_node.Type())
+                                        throw ParameterInputFileNodeError(file, name + ".latex", "is not a scalar");
+
+                                    latex = latex_node.as<std::string>();
+                                }
+
+                                add(file, group, Parameter::Template { name, min, central, max, latex });
+                            }
+
+                            section.groups.push_back(std::move(group));
+                        }
+                        sections->push_back(std::move(section));
+                    }
+                    catch (std::exception & e)
+                    {
+                        throw ParameterInputFileParseError(file, e.what());
+                    }
+                }
             }
+        };
+
+        std::shared_ptr<Parameters::Data> parameters_data;
+
+        // Shared among copies, and must be replaced rather than modified while shared
+        std::shared_ptr<std::map<std::string, unsigned>> parameters_map;
+
+        std::vector<Parameter> parameters;
+
+        std::shared_ptr<const std::vector<ParameterSectionTemplate>> section_templates;
+
+        // Created from the section templates upon first access, guarded by sections_mutex
+        mutable std::vector<ParameterSection> sections;
+
+        mutable Mutex sections_mutex;
+
+        Implementation(const DefaultParameters & defaults) :
+            parameters_data(new Parameters::Data(defaults.templates)),
+            parameters_map(defaults.parameters_map),
+            section_templates(defaults.sections)
+        {
+            make_parameters();
         }
 
         Implementation(const Implementation & other) :
             parameters_data(new Parameters::Data(*other.parameters_data)),
-            parameters_map(other.parameters_map)
+            parameters_map(other.parameters_map),
+            section_templates(other.section_templates)
+        {
+            make_parameters();
+        }
+
+        void
+        make_parameters()
         {
-            parameters.reserve(other.parameters.size());
-            for (unsigned i = 0 ; i != parameters.size() ; ++i)
+            parameters.reserve(parameters_data->data.size());
+            for (unsigned i = 0 ; i != parameters_data->data.size() ; ++i)
             {
                 parameters.push_back(Parameter(parameters_data, i));
             }
         }
 
+        unsigned
+        append(const Parameter::Template & t)
+        {
+            if (parameters_map.use_count() > 1)
+                parameters_map = std::make_shared<std::map<std::string, unsigned>>(*parameters_map);
+
+            auto idx = parameters_data->append(t);
+            parameters_map->insert(std::make_pair(t.name, idx));
+            parameters.push_back(Parameter(parameters_data, idx));
+
+            return idx;
+        }
+
+        const std::vector<ParameterSection> &
+        make_sections() const
+        {
+            // the sections are never modified once created, so the reference remains valid after unlocking
+            Lock l(sections_mutex);
+
+            if (! sections.empty() || ! section_templates)
+                return sections;
+
+            for (const auto & s : *section_templates)
+            {
+                std::vector<ParameterGroup> groups;
+                for (const auto & g : s.groups)
+                {
+                    std::vector<Parameter> entries;
+                    for (const auto & id : g.ids)
+                    {
+                        entries.push_back(Parameter(parameters_data, id));
+                    }
+
+                    groups.push_back(ParameterGroup(new Implementation<ParameterGroup>(g.name, g.description, std::move(entries))));
+                }
+
+                sections.push_back(ParameterSection(new Implementation<ParameterSection>(s.name, s.description, std::move(groups))));
+            }
+
+            return sections;
+        }
+
         void
         override_from_file(const std::string & file)
         {
@@ -311,26 +698,25 @@ namespace eos
                         latex = p.second["latex"].as<std::string>();
                     }
 
-                    auto i = parameters_map.find(name);
-                    if (parameters_map.end() != i)
+                    auto i = parameters_map->find(name);
+                    if (parameters_map->end() != i)
                     {
                         Log::instance()->message("[parameters.override]", ll_informational)
                             << "Overriding existing parameter '" << name << "' with central value '" << central << "'";
 
-                        parameters_data->data[i->second].value = central;
-                        parameters_data->data[i->second].min = min;
-                        parameters_data->data[i->second].max = max;
-                        parameters_data->data[i->second].latex = latex;
+                        parameters_data->set(i->second, central);
+
+                        Parameter::Template & t = parameters_data->unshared_templates()[i->second];
+                        t.min = min;
+                        t.max = max;
+                        t.latex = latex;
                     }
                     else
                     {
                         Log::instance()->message("[parameters.override]", ll_informational)
                             << "Adding new parameter '" << name << "' with central value '" << central << "'";
 
-                        auto idx = parameters_data->data.size();
-                        parameters_data->data.push_back(Parameter::Data(Parameter::Template { name, min, central, max, latex }, idx));
-                        parameters_map[name] = idx;
-                        parameters.push_back(Parameter(parameters_data, idx));
+                        append(Parameter::Template { name, min, central, max, latex });
                     }
                 }
             }
@@ -339,161 +725,6 @@ namespace eos
                 throw ParameterInputFileParseError(file, e.what());
             }
         }
-
-        void
-        load_defaults()
-        {
-            fs::path base;
-            if (std::getenv("EOS_TESTS_PARAMETERS"))
-            {
-                std::string envvar = std::string(std::getenv("EOS_TESTS_PARAMETERS"));
-                base = fs::system_complete(envvar);
-            }
-            else if (std::getenv("EOS_HOME"))
-            {
-                std::string envvar = std::string(std::getenv("EOS_HOME"));
-                base = fs::system_complete(envvar) / "parameters";
-            }
-            else
-            {
-                base = fs::system_complete(EOS_DATADIR "/eos/parameters/");
-            }
-
-            if (! fs::exists(base))
-            {
-                throw InternalError("Could not find the parameter input files");
-            }
-
-            if (! fs::is_directory(base))
-            {
-                throw InternalError("Expect '" + base.string() + " to be a directory");
-            }
-
-            unsigned idx = parameters.size();
-            for (fs::directory_iterator f(base), f_end ; f != f_end ; ++f)
-            {
-                auto file_path = f->path();
-
-                if (! fs::is_regular_file(status(file_path)))
-                    continue;
-
-                if (".yaml" != file_path.extension().string())
-                    continue;
-
-                std::string file = file_path.string();
-                try
-                {
-                    YAML::Node root_node = YAML::LoadFile(file);
-                    std::vector<ParameterGroup> section_groups;
-
-                    // parse the section metadata
-                    auto section_title_node = root_node["title"];
-                    if (! section_title_node)
-                        throw ParameterInputFileNodeError(file, "/", "has no entry named 'title'");
-                    if (YAML::NodeType::Scalar != section_title_node.Type())
-                        throw ParameterInputFileNodeError(file, "title", "is not a scalar");
-                    std::string section_title = section_title_node.as<std::string>();
-
-                    auto section_desc_node = root_node["description"];
-                    if (! section_desc_node)
-                        throw ParameterInputFileNodeError(file, "/", "has no entry named 'description'");
-                    if (YAML::NodeType::Scalar != section_desc_node.Type())
-                        throw ParameterInputFileNodeError(file, "description", "is not a scalar");
-                    std::string section_desc = section_desc_node.as<std::string>();
-
-                    auto section_groups_node = root_node["groups"];
-                    if (! section_groups_node)
-                        throw ParameterInputFileNodeError(file, "/", "has no entry named 'group'");
-                    if (YAML::NodeType::Sequence != section_groups_node.Type())
-                        throw ParameterInputFileNodeError(file, "groups", "is not a sequence");
-
-                    // parse the section's groups
-                    for (auto && group_node : section_groups_node)
-                    {
-                        std::vector<Parameter> group_parameters;
-
-                        auto group_title_node = group_node["title"];
-                        if (! group_title_node)
-                            throw ParameterInputFileNodeError(file, "", "has no entry named 'title'");
-                        if (YAML::NodeType::Scalar != group_title_node.Type())
-                            throw ParameterInputFileNodeError(file, "title", "is not a scalar");
-                        std::string group_title = group_title_node.as<std::string>();
-
-                        auto group_desc_node = group_node["description"];
-                        if (! group_desc_node)
-                            throw ParameterInputFileNodeError(file, group_title, "has no entry named 'description'");
-                        if (YAML::NodeType::Scalar != group_desc_node.Type())
-                            throw ParameterInputFileNodeError(file, "'" + group_title + "'.description", "is not a scalar");
-                        std::string group_desc = group_desc_node.as<std::string>();
-
-                        auto group_parameters_node = group_node["parameters"];
-                        if (! group_parameters_node)
-                            throw ParameterInputFileNodeError(file, group_title, "has no entry named 'parameters'");
-                        if (YAML::NodeType::Map != group_parameters_node.Type())
-                            throw ParameterInputFileNodeError(file, "'" + group_title + "'.parameters", "is not a map");
-
-                        // parse the group's parameters
-                        for (auto && p : group_parameters_node)
-                        {
-                            std::string name = p.first.Scalar();
-
-                            double central, min, max;
-
-                            std::string latex;
-
-                            auto central_node = p.second["central"];
-                            if (! central_node)
-                                throw ParameterInputFileNodeError(file, name, "has no entry named 'central'");
-                            if (YAML::NodeType::Scalar != central_node.Type())
-                                throw ParameterInputFileNodeError(file, name + ".central", "is not a scalar");
-                            central = central_node.as<double>();
-
-                            auto min_node = p.second["min"];
-                            if (! min_node)
-                                throw ParameterInputFileNodeError(file, name, "has no entry named 'min'");
-                            if (YAML::NodeType::Scalar != min_node.Type())
-                                throw ParameterInputFileNodeError(file, name + ".min", "is not a scalar");
-                            min = min_node.as<double>();
-
-                            auto max_node = p.second["max"];
-                            if (! max_node)
-                                throw ParameterInputFileNodeError(file, name, "has no entry named 'max'");
-                            if (YAML::NodeType::Scalar != max_node.Type())
-                                throw ParameterInputFileNodeError(file, name + ".max", "is not a scalar");
-                            max = max_node.as<double>();
-
-                            auto latex_node = p.second["latex"];
-                            if (latex_node)
-                            {
-                                if (YAML::NodeType::Scalar != latex_node.Type())
-                                    throw ParameterInputFileNodeError(file, name + ".latex", "is not a scalar");
-
-                                latex = latex_node.as<std::string>();
-                            }
-
-                            if (parameters_map.end() != parameters_map.find(name))
-                            {
-                                throw ParameterInputDuplicateError(file, name);
-                            }
-
-                            parameters_data->data.push_back(Parameter::Data(Parameter::Template { name, min, central, max, latex }, idx));
-                            parameters_map[name] = idx;
-                            parameters.push_back(Parameter(parameters_data, idx));
-                            group_parameters.push_back(Parameter(parameters_data, idx));
-
-                            ++idx;
-                        }
-
-                        section_groups.push_back(ParameterGroup(new Implementation<ParameterGroup>(group_title, group_desc, std::move(group_parameters))));
-                    }
-                    sections.push_back(ParameterSection(new Implementation<ParameterSection>(section_title, section_desc, std::move(section_groups))));
-                }
-                catch (std::exception & e)
-                {
-                    throw ParameterInputFileParseError(file, e.what());
-                }
-            }
-        }
     };
 
     Parameters::Parameters(Implementation<Parameters> * imp) :
@@ -514,9 +745,9 @@ namespace eos
     Parameter
     Parameters::operator[] (const std::string & name) const
     {
-        auto i(_imp->parameters_map.find(name));
+        auto i(_imp->parameters_map->find(name));
 
-        if (_imp->parameters_map.end() == i)
+        if (_imp->parameters_map->end() == i)
             throw UnknownParameterError(name);
 
         return Parameter(_imp->parameters_data, i->second);
@@ -535,28 +766,25 @@ namespace eos
     Parameters::declare(const std::string & name, double value)
     {
         // return existing parameter
-        auto i(_imp->parameters_map.find(name));
-        if (_imp->parameters_map.end() != i)
+        auto i(_imp->parameters_map->find(name));
+        if (_imp->parameters_map->end() != i)
             return Parameter(_imp->parameters_data, i->second);
 
         // create new parameter
-        unsigned idx = _imp->parameters.size();
-        _imp->parameters_data->data.push_back(Parameter::Data(Parameter::Template { name, value, value, value, "LaTeX display not supported for run-time declared parameters" }, idx));
-        _imp->parameters_map[name] = idx;
-        _imp->parameters.push_back(Parameter(_imp->parameters_data, idx));
+        auto idx = _imp->append(Parameter::Template { name, value, value, value, "LaTeX display not supported for run-time declared parameters" });
 
-        return _imp->parameters.back();
+        return _imp->parameters[idx];
     }
 
     void
     Parameters::set(const std::string & name, const double & value)
     {
-        auto i(_imp->parameters_map.find(name));
+        auto i(_imp->parameters_map->find(name));
 
-        if (_imp->parameters_map.end() == i)
+        if (_imp->parameters_map->end() == i)
             throw UnknownParameterError(name);
 
-        _imp->parameters_data->data[i->second].value = value;
+        _imp->parameters_data->set(i->second, value);
     }
 
     Parameters::Iterator
@@ -574,13 +802,13 @@ namespace eos
     Parameters::SectionIterator
     Parameters::begin_sections() const
     {
-        return _imp->sections.begin();
+        return _imp->make_sections().begin();
     }
 
     Parameters::SectionIterator
     Parameters::end_sections() const
     {
-        return _imp->sections.end();
+        return _imp->make_sections().end();
     }
 
     bool
@@ -589,13 +817,59 @@ namespace eos
         return rhs._imp.get() != this->_imp.get();
     }
 
+    bool
+    Parameters::operator< (const Parameters & rhs) const
+    {
+        return std::less<const void *>()(this->_imp.get(), rhs._imp.get());
+    }
+
     Parameters
     Parameters::Defaults()
     {
-        auto imp = new Implementation<Parameters>{};
-        imp->load_defaults();
+        return Parameters(new Implementation<Parameters>(*Implementation<Parameters>::DefaultParameters::instance()));
+    }
+
+    void
+    Parameters::compile_database(const std::string & directory, const std::string & file)
+    {
+        // compute the digest before reading the input files, such that a concurrent modification leaves the database stale
+        const std::uint64_t digest = BinaryDatabase::input_digest(fs::system_complete(directory).string());
+
+        Implementation<Parameters>::DefaultParameters(fs::system_complete(directory), false).write_database(file, digest);
+    }
+
+    unsigned long
+    Parameters::generation() const
+    {
+        return _imp->parameters_data->generation;
+    }
+
+    bool
+    Parameters::changed_since(const ParameterUser & user, const unsigned long & generation) const
+    {
+        const auto & data = _imp->parameters_data->data;
 
-        return Parameters(imp);
+        for (auto i = user.begin(), i_end = user.end() ; i != i_end ; ++i)
+        {
+            if (data[*i].generation > generation)
+                return true;
+        }
+
+        return false;
+    }
+
+    unsigned long
+    Parameters::generation(const ParameterUser & user) const
+    {
+        const auto & data = _imp->parameters_data->data;
+
+        unsigned long result = 0;
+        for (auto i = user.begin(), i_end = user.end() ; i != i_end ; ++i)
+        {
+            result = std::max(result, data[*i].generation);
+        }
+
+        return result;
     }
 
     void
@@ -616,6 +890,15 @@ namespace eos
     {
     }
 
+    Parameter &
+    Parameter::operator= (const Parameter & other)
+    {
+        _parameters_data = other._parameters_data;
+        _index = other._index;
+
+        return *this;
+    }
+
     Parameter::~Parameter()
     {
     }
@@ -646,7 +929,7 @@ namespace eos
     const Parameter &
     Parameter::operator= (const double & value)
     {
-        _parameters_data->data[_index].value = value;
+        _parameters_data->set(_index, value);
 
         return *this;
     }
@@ -654,43 +937,49 @@ namespace eos
     void
     Parameter::set(const double & value)
     {
-        _parameters_data->data[_index].value = value;
+        _parameters_data->set(_index, value);
     }
 
     const double &
     Parameter::central() const
     {
-        return _parameters_data->data[_index].central;
+        return (*_parameters_data->templates)[_index].central;
     }
 
     const double &
     Parameter::max() const
     {
-        return _parameters_data->data[_index].max;
+        return (*_parameters_data->templates)[_index].max;
     }
 
     const double &
     Parameter::min() const
     {
-        return _parameters_data->data[_index].min;
+        return (*_parameters_data->templates)[_index].min;
     }
 
     const std::string &
     Parameter::name() const
     {
-        return _parameters_data->data[_index].name;
+        return (*_parameters_data->templates)[_index].name;
     }
 
     const std::string &
     Parameter::latex() const
     {
-        return _parameters_data->data[_index].latex;
+        return (*_parameters_data->templates)[_index].latex;
     }
 
     Parameter::Id
     Parameter::id() const
     {
-        return _parameters_data->data[_index].id;
+        return _index;
+    }
+
+    unsigned long
+    Parameter::generation() const
+    {
+        return _parameters_data->data[_index].generation;
     }
 
     /* ParameterUser */
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2012, 2013, 2019 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2012, 2013, 2019, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -114,6 +114,18 @@ namespace eos
              */
             static Parameters Defaults();
 
+            /*!
+             * Compile the parameter input files into a binary database.
+             *
+             * Defaults() reads the file 'parameters.db' instead of the input files,
+             * if it is present and was compiled from the current input files, as
+             * determined by a digest of their names and contents.
+             *
+             * @param directory The directory of the parameter input files.
+             * @param file      The name of the database file.
+             */
+            static void compile_database(const std::string & directory, const std::string & file);
+
             Parameters clone() const;
             /*!
              * Destructor.
@@ -179,6 +191,33 @@ namespace eos
             void override_from_file(const std::string & file);
             ///@}
 
+            ///@name Change Tracking
+            ///@{
+            /*!
+             * Retrieve the current generation of this Parameters object.
+             *
+             * The generation is incremented whenever the numeric value of any of the parameters changes.
+             */
+            unsigned long generation() const;
+
+            /*!
+             * Determine if any parameter used by a ParameterUser changed its numeric value
+             * after a given generation.
+             *
+             * @param user       The ParameterUser whose used parameters shall be checked.
+             * @param generation The generation against which changes shall be detected.
+             */
+            bool changed_since(const ParameterUser & user, const unsigned long & generation) const;
+
+            /*!
+             * Retrieve the largest generation at which any parameter used by a ParameterUser
+             * changed its numeric value.
+             *
+             * @param user       The ParameterUser whose used parameters shall be checked.
+             */
+            unsigned long generation(const ParameterUser & user) const;
+            ///@}
+
             /*!
              * Compare two instances of Parameters on inequality of their
              * underlying implementations.
@@ -186,6 +225,14 @@ namespace eos
              * @param rhs   The right hand side of the binary != operator.
              */
             bool operator!= (const Parameters & rhs) const;
+
+            /*!
+             * Order two instances of Parameters by the identity of their underlying
+             * implementations, e.g. for use as keys of an ordered container.
+             *
+             * @param rhs   The right hand side of the binary < operator.
+             */
+            bool operator< (const Parameters & rhs) const;
     };
 
     extern template class WrappedForwardIterator<Parameters::IteratorTag, Parameter>;
@@ -226,6 +273,14 @@ namespace eos
             /// Copy-constructor.
             Parameter(const Parameter & other);
 
+            /*!
+             * Copy-assignment.
+             *
+             * Rebinds this object to the other parameter. The numeric values of
+             * both parameters remain unchanged.
+             */
+            Parameter & operator= (const Parameter & other);
+
             /// Destructor.
             ~Parameter();
 
@@ -270,6 +325,9 @@ namespace eos
 
             /// Retrieve the Parameter's name as a LaTeX representation
             const std::string & latex() const;
+
+            /// Retrieve the generation of the parent Parameters object at the last change of the numeric value.
+            unsigned long generation() const;
             ///@}
     };
 
@@ -17,9 +17,16 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <config.h>
 #include <test/test.hh>
+#include <eos/utils/binary-database.hh>
 #include <eos/utils/parameters.hh>
 
+#include <cstdio>
+#include <iterator>
+#include <thread>
+#include <vector>
+
 using namespace test;
 using namespace eos;
 
@@ -48,6 +55,20 @@ class ParametersTest :
                 TEST_CHECK_EQUAL(m_c(), m_c.central());
             }
 
+            // Rebinding
+            {
+                Parameters parameters = Parameters::Defaults();
+                Parameter m = parameters["mass::mu"];
+                const double m_mu = parameters["mass::mu"](), m_e = parameters["mass::e"]();
+                const unsigned long generation = parameters.generation();
+
+                m = parameters["mass::e"];
+                TEST_CHECK_EQUAL(m.name(), "mass::e");
+                TEST_CHECK_EQUAL(m(), m_e);
+                TEST_CHECK_EQUAL(parameters["mass::mu"](), m_mu);
+                TEST_CHECK_EQUAL(parameters.generation(), generation);
+            }
+
             // Cloning
             {
                 Parameters original = Parameters::Defaults();
@@ -71,5 +92,135 @@ class ParametersTest :
                 TEST_CHECK_EQUAL(m_c_original(), 0.0);
                 TEST_CHECK_EQUAL(m_c_clone(), m_c_clone.central());
             }
+
+            // Change tracking
+            {
+                Parameters parameters = Parameters::Defaults();
+                Parameter m_b = parameters["mass::b(MSbar)"];
+                Parameter m_c = parameters["mass::c"];
+
+                ParameterUser user;
+                user.uses(m_c.id());
+
+                const unsigned long generation = parameters.generation();
+                TEST_CHECK(! parameters.changed_since(user, generation));
+
+                // setting the current value is not a change
+                m_c = m_c();
+                TEST_CHECK_EQUAL(parameters.generation(), generation);
+                TEST_CHECK(! parameters.changed_since(user, generation));
+
+                // changing an unused parameter
+                m_b = 4.0;
+                TEST_CHECK_EQUAL(parameters.generation(), generation + 1);
+                TEST_CHECK_EQUAL(m_b.generation(), generation + 1);
+                TEST_CHECK(! parameters.changed_since(user, generation));
+
+                // changing a used parameter
+                parameters.set("mass::c", 1.0);
+                TEST_CHECK_EQUAL(parameters.generation(), generation + 2);
+                TEST_CHECK_EQUAL(m_c.generation(), generation + 2);
+                TEST_CHECK(parameters.changed_since(user, generation));
+                TEST_CHECK(parameters.changed_since(user, generation + 1));
+                TEST_CHECK(! parameters.changed_since(user, generation + 2));
+            }
+
+            // Independence of default parameters that share their meta data
+            {
+                Parameters first = Parameters::Defaults();
+                Parameters second = Parameters::Defaults();
+
+                first["mass::c"] = 0.0;
+                first.declare("test::declared", 17.0);
+                TEST_CHECK_EQUAL(second["mass::c"](), second["mass::c"].central());
+                TEST_CHECK_THROWS(UnknownParameterError, second["test::declared"]);
+                TEST_CHECK_THROWS(UnknownParameterError, Parameters::Defaults()["test::declared"]);
+
+                Parameters clone = first.clone();
+                TEST_CHECK_EQUAL(clone["mass::c"](), 0.0);
+                TEST_CHECK_EQUAL(clone["test::declared"](), 17.0);
+                TEST_CHECK_EQUAL(clone["mass::c"].id(), first["mass::c"].id());
+
+                unsigned size = 0;
+                for (auto p = clone.begin(), p_end = clone.end() ; p != p_end ; ++p, ++size)
+                {
+                    TEST_CHECK_EQUAL(size, p->id());
+                }
+                TEST_CHECK(first["test::declared"].id() + 1 == size);
+
+                // the parameters of the sections belong to their respective parent object
+                for (auto s = second.begin_sections(), s_end = second.end_sections() ; s != s_end ; ++s)
+                {
+                    for (auto & g : *s)
+                    {
+                        for (auto & p : g)
+                        {
+                            if ("mass::c" != p.name())
+                                continue;
+
+                            TEST_CHECK_EQUAL(p(), p.central());
+                            second["mass::c"] = 1.0;
+                            TEST_CHECK_EQUAL(p(), 1.0);
+                        }
+                    }
+                }
+                TEST_CHECK_EQUAL(second["mass::c"](), 1.0);
+            }
+
+            // The sections can be created concurrently
+            {
+                Parameters parameters = Parameters::Defaults();
+
+                std::vector<unsigned> counts(4, 0);
+                std::vector<std::thread> threads;
+                for (unsigned t = 0 ; t < counts.size() ; ++t)
+                {
+                    threads.push_back(std::thread([&parameters, &counts, t] ()
+                    {
+                        for (auto s = parameters.begin_sections(), s_end = parameters.end_sections() ; s != s_end ; ++s)
+                        {
+                            ++counts[t];
+                        }
+                    }));
+                }
+
+                for (auto & t : threads)
+                {
+                    t.join();
+                }
+
+                const unsigned size = std::distance(parameters.begin_sections(), parameters.end_sections());
+                TEST_CHECK(size > 0);
+                for (auto c : counts)
+                {
+                    TEST_CHECK_EQUAL(size, c);
+                }
+            }
+
+            // Compiling the parameter database
+            {
+                static const std::string filename(EOS_BUILDDIR "/eos/utils/parameters_TEST.db");
+
+                Parameters::compile_database(EOS_SRCDIR "/eos/parameters", filename);
+
+                BinaryDatabase database(filename);
+                Parameters parameters = Parameters::Defaults();
+
+                // one record per section, in the same order
+                std::size_t i = 0;
+                for (auto s = parameters.begin_sections(), s_end = parameters.end_sections() ; s != s_end ; ++s, ++i)
+                {
+                    TEST_CHECK(i < database.size());
+
+                    std::string name, description;
+                    BinaryRecordReader reader(database.value(i));
+                    reader >> name >> description;
+                    TEST_CHECK_EQUAL(s->name(), name);
+                    TEST_CHECK_EQUAL(s->description(), description);
+                }
+                TEST_CHECK_EQUAL(i, database.size());
+
+                std::remove(filename.c_str());
+            }
         }
 } parameters_test;
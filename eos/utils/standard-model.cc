@@ -176,12 +176,19 @@ namespace implementation
         _m_c_MSbar__qcd(p["mass::c"], u),
         _m_s_MSbar__qcd(p["mass::s(2GeV)"], u),
         _m_ud_MSbar__qcd(p["mass::ud(2GeV)"], u),
-        _m_Z__qcd(p["mass::Z"], u)
+        _m_Z__qcd(p["mass::Z"], u),
+        _alpha_s_cache({ _alpha_s_Z__qcd, _mu_t__qcd, _mu_b__qcd, _mu_c__qcd, _lambda_qcd__qcd, _m_Z__qcd })
     {
     }
 
     double
     SMComponent<components::QCD>::alpha_s(const double & mu) const
+    {
+        return _alpha_s_cache(mu, [&] () { return this->_alpha_s(mu); });
+    }
+
+    double
+    SMComponent<components::QCD>::_alpha_s(const double & mu) const
     {
         double alpha_s_0 = _alpha_s_Z__qcd, mu_0 = _m_Z__qcd;
 
@@ -439,7 +446,9 @@ namespace implementation
         _m_W__deltabs1(p["mass::W"], u),
         _m_Z__deltabs1(p["mass::Z"], u),
         _mu_0c__deltabs1(p["b->s::mu_0c"], u),
-        _mu_0t__deltabs1(p["b->s::mu_0t"], u)
+        _mu_0t__deltabs1(p["b->s::mu_0t"], u),
+        _wilson_coefficients_b_to_s_cache({ _alpha_s_Z__deltabs1, _mu_t__deltabs1, _mu_b__deltabs1, _mu_c__deltabs1, _sw2__deltabs1,
+                _m_t_pole__deltabs1, _m_W__deltabs1, _m_Z__deltabs1, _mu_0c__deltabs1, _mu_0t__deltabs1 })
     {
     }
 
@@ -549,7 +558,14 @@ namespace implementation
 }
 
     WilsonCoefficients<BToS>
-    SMComponent<components::DeltaBS1>::wilson_coefficients_b_to_s(const double & mu, const std::string & /*lepton_flavour*/, const bool & /*cp_conjugate*/) const
+    SMComponent<components::DeltaBS1>::wilson_coefficients_b_to_s(const double & mu, const std::string & lepton_flavour, const bool & cp_conjugate) const
+    {
+        return _wilson_coefficients_b_to_s_cache(std::make_tuple(mu, lepton_flavour, cp_conjugate),
+                [&] () { return this->_wilson_coefficients_b_to_s(mu); });
+    }
+
+    WilsonCoefficients<BToS>
+    SMComponent<components::DeltaBS1>::_wilson_coefficients_b_to_s(const double & mu) const
     {
         /*
          * In the SM all Wilson coefficients are real-valued -> all weak phases are zero.
@@ -23,8 +23,11 @@
 #define EOS_GUARD_SRC_UTILS_STANDARD_MODEL_HH 1
 
 #include <eos/utils/model.hh>
+#include <eos/utils/parameter_cache.hh>
 #include <eos/utils/private_implementation_pattern.hh>
 
+#include <tuple>
+
 namespace eos
 {
     template <typename Tag> class SMComponent;
@@ -73,6 +76,11 @@ namespace eos
             UsedParameter _m_ud_MSbar__qcd;
             UsedParameter _m_Z__qcd;
 
+            /* Cache of alpha_s, keyed on mu */
+            ParameterCache<double, double> _alpha_s_cache;
+
+            double _alpha_s(const double & mu) const;
+
         public:
             SMComponent(const Parameters &, ParameterUser &);
 
@@ -113,6 +121,11 @@ namespace eos
             UsedParameter _mu_0c__deltabs1;
             UsedParameter _mu_0t__deltabs1;
 
+            /* Cache of the Wilson coefficients, keyed on mu, lepton flavour and CP conjugation */
+            ParameterCache<std::tuple<double, std::string, bool>, WilsonCoefficients<BToS>> _wilson_coefficients_b_to_s_cache;
+
+            WilsonCoefficients<BToS> _wilson_coefficients_b_to_s(const double & mu) const;
+
         public:
             SMComponent(const Parameters &, ParameterUser &);
 
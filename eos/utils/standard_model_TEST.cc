@@ -438,5 +438,31 @@ class WilsonCoefficientsBToSTest :
                 TEST_CHECK_NEARLY_EQUAL(parameters["b->smumu::Im{c9}"],     imag(wc.c9()),  eps);
                 TEST_CHECK_NEARLY_EQUAL(parameters["b->smumu::Im{c10}"],    imag(wc.c10()), eps);
             }
+
+            /* Test that cached results follow changes of the parameters */
+            {
+                static const double eps = 1e-8;
+                static const double mu = 4.2;
+
+                Parameters parameters = reference_parameters();
+                StandardModel model(parameters);
+
+                const double alpha_s_old = model.alpha_s(mu);
+                const WilsonCoefficients<BToS> wc_old = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                TEST_CHECK_EQUAL(alpha_s_old, model.alpha_s(mu));
+                TEST_CHECK_EQUAL(real(wc_old.c9()), real(model.wilson_coefficients_b_to_s(mu, "mu", false).c9()));
+
+                parameters["QCD::alpha_s(MZ)"] = 0.1200;
+                parameters["b->s::mu_0t"] = 160.0;
+
+                StandardModel reference(parameters);
+                const double alpha_s_new = model.alpha_s(mu);
+                const WilsonCoefficients<BToS> wc_new = model.wilson_coefficients_b_to_s(mu, "mu", false);
+                TEST_CHECK(std::abs(alpha_s_new - alpha_s_old) > eps);
+                TEST_CHECK(std::abs(real(wc_new.c9() - wc_old.c9())) > eps);
+                TEST_CHECK_NEARLY_EQUAL(reference.alpha_s(mu),                                        alpha_s_new,        eps);
+                TEST_CHECK_NEARLY_EQUAL(real(reference.wilson_coefficients_b_to_s(mu, "mu", false).c7()), real(wc_new.c7()), eps);
+                TEST_CHECK_NEARLY_EQUAL(real(reference.wilson_coefficients_b_to_s(mu, "mu", false).c9()), real(wc_new.c9()), eps);
+            }
         }
 } wilson_coefficients_b_to_s_test;
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -18,6 +18,8 @@
  */
 
 #include <eos/utils/condition_variable.hh>
+#include <eos/utils/destringify.hh>
+#include <eos/utils/exception.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
 #include <eos/utils/lock.hh>
 #include <eos/utils/mutex.hh>
@@ -25,118 +27,263 @@
 #include <eos/utils/thread.hh>
 #include <eos/utils/thread_pool.hh>
 
-#include <list>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <vector>
 
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 
 namespace eos
 {
+    namespace
+    {
+        // Index of the calling worker thread within the pool, or -1 for all other threads
+        thread_local int worker_index = -1;
+
+        // Configuration prior to the instantiation of the pool
+        struct Configuration
+        {
+            unsigned number_of_threads = 0;
+
+            bool pin_threads = false;
+
+            bool instantiated = false;
+        };
+
+        Configuration & configuration()
+        {
+            static Configuration result;
+
+            return result;
+        }
+
+        Mutex & configuration_mutex()
+        {
+            static Mutex result;
+
+            return result;
+        }
+    }
+
     template <>
     struct Implementation<ThreadPool>
     {
+        typedef std::function<void (void)> Job;
+
+        struct Worker
+        {
+            Mutex mutex;
+
+            std::deque<Job> jobs;
+        };
+
         unsigned number_of_threads;
         unsigned long nominal_capacity;
         unsigned long stop_capacity;
 
+        bool pin_threads;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        // Number of jobs in all of the workers' queues
+        std::atomic<unsigned long> queued_jobs;
+
+        // Number of workers waiting for job arrival
+        std::atomic<unsigned> sleeping_workers;
+
+        // Round-robin counter for jobs submitted from outside of the pool
+        std::atomic<unsigned> next_worker;
+
         // Thread termination
-        Mutex * const terminate_mutex;
+        std::atomic<bool> terminate;
+
+        Mutex sleep_mutex;
+
+        ConditionVariable job_arrival;
+
+        // Number of threads waiting in wait_for_free_capacity()
+        std::atomic<unsigned> waiting_producers;
+
+        Mutex capacity_mutex;
 
-        bool terminate;
+        ConditionVariable capacity_available;
 
-        // Job handling
-        Mutex * const job_mutex;
+        std::vector<Thread *> threads;
 
-        ConditionVariable * const job_arrival;
-        ConditionVariable * const job_capacity;
+        static unsigned default_number_of_threads()
+        {
+            if (std::getenv("EOS_NUMBER_OF_THREADS"))
+            {
+                unsigned result = destringify<unsigned>(std::getenv("EOS_NUMBER_OF_THREADS"));
+
+                if (0 == result)
+                    throw InternalError("ThreadPool: EOS_NUMBER_OF_THREADS must be positive");
+
+                return result;
+            }
+
+            return std::max(1l, sysconf(_SC_NPROCESSORS_ONLN));
+        }
 
-        unsigned long waiting_for_jobs;
-        unsigned long pending_jobs;
+        static bool default_pin_threads()
+        {
+            return std::getenv("EOS_PIN_THREADS") && (std::string("1") == std::getenv("EOS_PIN_THREADS"));
+        }
 
-        std::list<std::pair<Ticket, std::function<void (void)> *>> queue;
+        void pin(const unsigned & index)
+        {
+#if defined(__linux__)
+            unsigned number_of_processors = std::max(1l, sysconf(_SC_NPROCESSORS_ONLN));
 
-        std::list<Thread *> threads;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(index % number_of_processors, &set);
 
-        void thread_function()
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+#endif
+        }
+
+        void job_taken()
         {
-            std::function<void (void)> * job;
-            Ticket ticket;
+            --queued_jobs;
 
-            do
+            if ((waiting_producers > 0) && (queued_jobs <= nominal_capacity))
             {
-                {
-                    Lock l(*terminate_mutex);
-                    if (terminate)
-                        break;
-                }
+                Lock l(capacity_mutex);
+                capacity_available.broadcast();
+            }
+        }
 
-                job = 0;
+        // Take a job from the back of the own queue
+        bool pop_own(const int & index, Job & job)
+        {
+            if (index < 0)
+                return false;
 
-                {
-                    Lock l(*job_mutex);
+            Worker & w = *workers[index];
+            Lock l(w.mutex);
 
-                    if (queue.empty())
-                    {
-                        waiting_for_jobs += 1;
-                        job_arrival->wait(*job_mutex);
-                        waiting_for_jobs -= 1;
-                    }
+            if (w.jobs.empty())
+                return false;
 
-                    if (queue.empty())
-                    {
-                        Lock l(*terminate_mutex);
-                        if (terminate)
-                            break;
-                        else
-                            continue;
-                    }
+            job = std::move(w.jobs.back());
+            w.jobs.pop_back();
+            job_taken();
 
-                    ticket = queue.front().first;
-                    job = queue.front().second;
-                    queue.pop_front();
-                }
+            return true;
+        }
 
-                (*job)();
-                {
-                    Lock l(*job_mutex);
-                    pending_jobs -= 1;
+        // Take a job from the back of the own queue, or steal one from the front of another queue
+        bool pop(const int & index, Job & job)
+        {
+            if (pop_own(index, job))
+                return true;
 
-                    if (pending_jobs == nominal_capacity)
-                        job_capacity->signal();
+            unsigned first = (index >= 0) ? index + 1 : next_worker.load();
+            for (unsigned i = 0 ; i < number_of_threads ; ++i)
+            {
+                Worker & w = *workers[(first + i) % number_of_threads];
+                Lock l(w.mutex);
 
+                if (w.jobs.empty())
+                    continue;
+
+                job = std::move(w.jobs.front());
+                w.jobs.pop_front();
+                job_taken();
+
+                return true;
+            }
+
+            return false;
+        }
+
+        void push(const Job & job)
+        {
+            unsigned index = (worker_index >= 0) ? worker_index : (next_worker++ % number_of_threads);
+
+            {
+                Worker & w = *workers[index];
+                Lock l(w.mutex);
+
+                w.jobs.push_back(job);
+            }
+
+            ++queued_jobs;
+
+            if (sleeping_workers > 0)
+            {
+                Lock l(sleep_mutex);
+                job_arrival.signal();
+            }
+        }
+
+        void thread_function(const unsigned & index)
+        {
+            worker_index = index;
+
+            if (pin_threads)
+                pin(index);
+
+            Job job;
+            while (true)
+            {
+                if (pop(index, job))
+                {
+                    job();
+                    job = nullptr;
+
+                    continue;
                 }
-                ticket.mark();
+
+                Lock l(sleep_mutex);
+
+                if (terminate)
+                    break;
+
+                ++sleeping_workers;
+
+                if ((0 == queued_jobs) && ! terminate)
+                    job_arrival.wait(sleep_mutex);
+
+                --sleeping_workers;
             }
-            while (true);
         }
 
-        Implementation() :
-            number_of_threads(sysconf(_SC_NPROCESSORS_CONF)),
+        Implementation(const unsigned & number_of_threads, const bool & pin_threads) :
+            number_of_threads(number_of_threads),
             nominal_capacity(number_of_threads * 10),
             stop_capacity(nominal_capacity * 2),
-            terminate_mutex(new Mutex),
+            pin_threads(pin_threads),
+            queued_jobs(0),
+            sleeping_workers(0),
+            next_worker(0),
             terminate(false),
-            job_mutex(new Mutex),
-            job_arrival(new ConditionVariable),
-            job_capacity(new ConditionVariable),
-            waiting_for_jobs(0),
-            pending_jobs(0)
+            waiting_producers(0)
         {
             for (unsigned i(0) ; i < number_of_threads ; ++i)
             {
-                threads.push_back(new Thread(std::bind(&Implementation<ThreadPool>::thread_function, this)));
+                workers.push_back(std::unique_ptr<Worker>(new Worker));
+            }
+
+            for (unsigned i(0) ; i < number_of_threads ; ++i)
+            {
+                threads.push_back(new Thread(std::bind(&Implementation<ThreadPool>::thread_function, this, i)));
             }
         }
 
         ~Implementation()
         {
             {
-                Lock l(*terminate_mutex);
+                Lock l(sleep_mutex);
                 terminate = true;
-            }
-
-            {
-                Lock l(*job_mutex);
-                job_arrival->broadcast();
+                job_arrival.broadcast();
             }
 
             for (auto t(threads.begin()), t_end(threads.end()) ; t != t_end ; ++t)
@@ -146,9 +293,25 @@ namespace eos
         }
     };
 
+    namespace
+    {
+        Implementation<ThreadPool> * make_thread_pool_implementation()
+        {
+            Lock l(configuration_mutex());
+
+            Configuration & c = configuration();
+            c.instantiated = true;
+
+            unsigned number_of_threads = (c.number_of_threads > 0) ? c.number_of_threads : Implementation<ThreadPool>::default_number_of_threads();
+            bool pin_threads = c.pin_threads || Implementation<ThreadPool>::default_pin_threads();
+
+            return new Implementation<ThreadPool>(number_of_threads, pin_threads);
+        }
+    }
+
     ThreadPool::ThreadPool() :
         InstantiationPolicy<ThreadPool, Singleton>(),
-        PrivateImplementationPattern<ThreadPool>(new Implementation<ThreadPool>)
+        PrivateImplementationPattern<ThreadPool>(make_thread_pool_implementation())
     {
     }
 
@@ -156,21 +319,28 @@ namespace eos
     {
     }
 
+    void
+    ThreadPool::configure(const unsigned & number_of_threads, const bool & pin_threads)
+    {
+        Lock l(configuration_mutex());
+
+        Configuration & c = configuration();
+
+        if (c.instantiated)
+            throw InternalError("ThreadPool::configure() must be called before the first use of the ThreadPool");
+
+        c.number_of_threads = number_of_threads;
+        c.pin_threads = pin_threads;
+    }
+
     Ticket
     ThreadPool::enqueue(const std::function<void (void)> & job)
     {
-        std::pair<Ticket, std::function<void (void)> *> item(Ticket(), new std::function<void (void)>(job));
-
-        {
-            Lock l(*_imp->job_mutex);
-            _imp->queue.push_back(item);
-            _imp->pending_jobs += 1;
+        Ticket ticket;
 
-            if (_imp->waiting_for_jobs > 0)
-                _imp->job_arrival->signal();
-        }
+        _imp->push([ticket, job] () mutable { job(); ticket.mark(); });
 
-        return item.first;
+        return ticket;
     }
 
     ThreadPool *
@@ -182,12 +352,26 @@ namespace eos
     void
     ThreadPool::wait_for_free_capacity()
     {
-        Lock l(*_imp->job_mutex);
-
-        if (_imp->pending_jobs < _imp->stop_capacity)
+        if (_imp->queued_jobs < _imp->stop_capacity)
             return;
 
-        _imp->job_capacity->wait(*_imp->job_mutex);
+        // a worker thread helps only with the jobs in its own queue, which it submitted itself
+        Implementation<ThreadPool>::Job job;
+        while ((_imp->queued_jobs > _imp->nominal_capacity) && _imp->pop_own(worker_index, job))
+        {
+            job();
+            job = nullptr;
+        }
+
+        Lock l(_imp->capacity_mutex);
+        ++_imp->waiting_producers;
+
+        while (_imp->queued_jobs > _imp->nominal_capacity)
+        {
+            _imp->capacity_available.wait(_imp->capacity_mutex);
+        }
+
+        --_imp->waiting_producers;
     }
 
     unsigned
@@ -195,5 +379,210 @@ namespace eos
     {
         return _imp->number_of_threads;
     }
-}
 
+    bool
+    ThreadPool::is_worker_thread() const
+    {
+        return worker_index >= 0;
+    }
+
+    void
+    ThreadPool::submit(const std::function<void (void)> & job)
+    {
+        _imp->push(job);
+    }
+
+    bool
+    ThreadPool::run_one()
+    {
+        Implementation<ThreadPool>::Job job;
+
+        if (! _imp->pop(worker_index, job))
+            return false;
+
+        job();
+
+        return true;
+    }
+
+    void
+    ThreadPool::parallel_for(const unsigned long & begin, const unsigned long & end, const unsigned long & grain,
+            const std::function<void (const unsigned long &, const unsigned long &)> & f)
+    {
+        if (end <= begin)
+            return;
+
+        const unsigned long size = end - begin;
+        const unsigned long chunk_size = (grain > 0) ? grain : std::max(1ul, (size + 4 * _imp->number_of_threads - 1) / (4 * _imp->number_of_threads));
+
+        if (size <= chunk_size)
+            return f(begin, end);
+
+        TaskGroup group;
+        for (unsigned long chunk_begin = begin ; chunk_begin < end ; chunk_begin += chunk_size)
+        {
+            unsigned long chunk_end = std::min(chunk_begin + chunk_size, end);
+
+            group.run([&f, chunk_begin, chunk_end] () { f(chunk_begin, chunk_end); });
+        }
+
+        group.wait();
+    }
+
+    void
+    ThreadPool::parallel_for_parts(const unsigned long & size, const unsigned long & number_of_parts,
+            const std::function<void (const unsigned long &, const unsigned long &, const unsigned long &)> & f)
+    {
+        const unsigned long parts = std::min(size, number_of_parts);
+
+        parallel_for(0, parts, 1, [&] (const unsigned long & p_begin, const unsigned long & p_end)
+        {
+            for (auto p = p_begin ; p != p_end ; ++p)
+            {
+                f(p, size * p / parts, size * (p + 1) / parts);
+            }
+        });
+    }
+
+    template <>
+    struct Implementation<TaskGroup>
+    {
+        struct Job
+        {
+            std::function<void (void)> function;
+
+            // set by the first thread that starts executing the job
+            std::atomic<bool> claimed;
+
+            Job(const std::function<void (void)> & function) :
+                function(function),
+                claimed(false)
+            {
+            }
+        };
+
+        Mutex mutex;
+
+        ConditionVariable completion;
+
+        unsigned long pending_jobs = 0;
+
+        // jobs of this group, in order of submission, that might not have been started yet
+        std::deque<std::shared_ptr<Job>> unstarted_jobs;
+
+        std::exception_ptr error;
+
+        void execute(const std::shared_ptr<Job> & job)
+        {
+            std::exception_ptr job_error;
+
+            try
+            {
+                job->function();
+            }
+            catch (...)
+            {
+                job_error = std::current_exception();
+            }
+
+            job->function = nullptr;
+
+            Lock l(mutex);
+
+            if (job_error && ! error)
+                error = job_error;
+
+            --pending_jobs;
+
+            if (0 == pending_jobs)
+                completion.broadcast();
+        }
+
+        // help only with this group's own jobs, so that waiting never picks up unrelated work
+        void wait_for_completion()
+        {
+            while (true)
+            {
+                std::shared_ptr<Job> job;
+
+                {
+                    Lock l(mutex);
+
+                    if (0 == pending_jobs)
+                    {
+                        unstarted_jobs.clear();
+                        return;
+                    }
+
+                    while (! unstarted_jobs.empty())
+                    {
+                        std::shared_ptr<Job> j = std::move(unstarted_jobs.back());
+                        unstarted_jobs.pop_back();
+
+                        if (! j->claimed.exchange(true))
+                        {
+                            job = std::move(j);
+                            break;
+                        }
+                    }
+
+                    // all of our pending jobs are being executed by other threads
+                    if (! job)
+                    {
+                        completion.wait(mutex);
+                        continue;
+                    }
+                }
+
+                execute(job);
+            }
+        }
+    };
+
+    TaskGroup::TaskGroup() :
+        PrivateImplementationPattern<TaskGroup>(new Implementation<TaskGroup>)
+    {
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        _imp->wait_for_completion();
+    }
+
+    void
+    TaskGroup::run(const std::function<void (void)> & job)
+    {
+        std::shared_ptr<Implementation<TaskGroup>::Job> j(new Implementation<TaskGroup>::Job(job));
+
+        {
+            Lock l(_imp->mutex);
+            ++_imp->pending_jobs;
+            _imp->unstarted_jobs.push_back(j);
+        }
+
+        std::shared_ptr<Implementation<TaskGroup>> imp = _imp;
+        ThreadPool::instance()->submit([imp, j] ()
+        {
+            // the job might have been executed by a waiting thread already
+            if (j->claimed.exchange(true))
+                return;
+
+            imp->execute(j);
+        });
+    }
+
+    void
+    TaskGroup::wait()
+    {
+        _imp->wait_for_completion();
+
+        std::exception_ptr error;
+        {
+            Lock l(_imp->mutex);
+            std::swap(error, _imp->error);
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
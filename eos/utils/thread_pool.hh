@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011, 2015 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2015, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -28,6 +28,18 @@
 
 namespace eos
 {
+    /*!
+     * ThreadPool executes jobs on a fixed set of worker threads.
+     *
+     * Each worker owns a double-ended job queue. Workers take jobs from the back of their own queue,
+     * and steal jobs from the front of the other workers' queues once their own queue runs empty.
+     * Jobs that are submitted from within a worker are placed in that worker's queue.
+     *
+     * The number of threads defaults to the number of online processors. It can be changed either
+     * through the environment variable EOS_NUMBER_OF_THREADS, or through configure() prior to the
+     * first use of the pool. Pinning the worker threads to processors is enabled by setting the
+     * environment variable EOS_PIN_THREADS to 1, or through configure().
+     */
     class ThreadPool :
         public InstantiationPolicy<ThreadPool, Singleton>,
         public PrivateImplementationPattern<ThreadPool>
@@ -37,13 +49,99 @@ namespace eos
 
             ~ThreadPool();
 
+            /*!
+             * Configure the pool. Must be called before the first call to instance().
+             *
+             * @param number_of_threads The number of worker threads. If 0, the default is used.
+             * @param pin_threads       If true, worker i is pinned to processor i (modulo the number of processors).
+             */
+            static void configure(const unsigned & number_of_threads, const bool & pin_threads = false);
+
             Ticket enqueue(const std::function<void (void)> & work);
 
             static ThreadPool * instance();
 
+            /*!
+             * Block while many jobs are queued, until the queues have drained to their nominal capacity.
+             *
+             * A worker thread first executes the jobs in its own queue, but never picks up jobs
+             * submitted by other threads.
+             */
             void wait_for_free_capacity();
 
             unsigned number_of_threads() const;
+
+            /// Return whether the calling thread is one of the pool's worker threads.
+            bool is_worker_thread() const;
+
+            /*!
+             * Apply a function to all chunks of an index range concurrently, and wait for its completion.
+             *
+             * The calling thread participates in the execution. Exceptions thrown by the function are
+             * rethrown in the calling thread.
+             *
+             * @param begin The first index of the range.
+             * @param end   The index past the last index of the range.
+             * @param grain The maximal number of indices per chunk. If 0, the range is split into four chunks per thread.
+             * @param f     The function, which is called as f(chunk_begin, chunk_end).
+             */
+            void parallel_for(const unsigned long & begin, const unsigned long & end, const unsigned long & grain,
+                    const std::function<void (const unsigned long &, const unsigned long &)> & f);
+
+            /*!
+             * Split an index range into contiguous parts of nearly equal size, process the parts
+             * concurrently, and wait for their completion.
+             *
+             * Each part is processed by a single call of the function, so the part index can select
+             * per-thread state such as a clone of an object that is not thread safe. Parts are
+             * never empty. Exceptions thrown by the function are rethrown in the calling thread.
+             *
+             * @param size            The size of the index range [0, size).
+             * @param number_of_parts The maximal number of parts. At most size parts are used.
+             * @param f               The function, which is called as f(part, part_begin, part_end).
+             */
+            void parallel_for_parts(const unsigned long & size, const unsigned long & number_of_parts,
+                    const std::function<void (const unsigned long &, const unsigned long &, const unsigned long &)> & f);
+
+            ///@name Internal functions
+            ///@{
+            /// Submit a job to the pool's queues.
+            void submit(const std::function<void (void)> & job);
+
+            /// Execute one queued job on the calling thread, if any. Return true if a job was executed.
+            bool run_one();
+            ///@}
+    };
+
+    /*!
+     * TaskGroup keeps track of the completion of a set of jobs executed by the ThreadPool.
+     */
+    class TaskGroup :
+        public InstantiationPolicy<TaskGroup, NonCopyable>,
+        public PrivateImplementationPattern<TaskGroup>
+    {
+        public:
+            ///@name Basic Functions
+            ///@{
+            /// Constructor.
+            TaskGroup();
+
+            /// Destructor. Waits for all jobs of the group.
+            ~TaskGroup();
+            ///@}
+
+            /// Submit a job to the ThreadPool as part of this group.
+            void run(const std::function<void (void)> & job);
+
+            /*!
+             * Wait for the completion of all jobs of this group.
+             *
+             * The calling thread helps to execute this group's jobs that have not been started yet,
+             * so wait() can safely be called from within a job. It never executes jobs of other
+             * groups or of the ThreadPool. The first exception thrown by any of the group's jobs
+             * is rethrown.
+             */
+            void wait();
     };
 }
 
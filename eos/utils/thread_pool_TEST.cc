@@ -0,0 +1,277 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class ThreadPoolTest :
+    public TestCase
+{
+    public:
+        ThreadPoolTest() :
+            TestCase("thread_pool_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            ThreadPool * pool = ThreadPool::instance();
+
+            TEST_CHECK(pool->number_of_threads() > 0);
+            TEST_CHECK(! pool->is_worker_thread());
+
+            // Configuration after first use fails
+            {
+                TEST_CHECK_THROWS(InternalError, ThreadPool::configure(2));
+            }
+
+            // Tickets
+            {
+                Mutex mutex;
+                unsigned counter = 0;
+
+                std::vector<Ticket> tickets;
+                for (unsigned i = 0 ; i < 1000 ; ++i)
+                {
+                    pool->wait_for_free_capacity();
+                    tickets.push_back(pool->enqueue([&] () { Lock l(mutex); ++counter; }));
+                }
+
+                for (auto & t : tickets)
+                {
+                    t.wait();
+                }
+
+                TEST_CHECK_EQUAL(1000u, counter);
+            }
+
+            // parallel_for covers the range exactly once
+            {
+                std::vector<unsigned> visits(10007, 0);
+
+                pool->parallel_for(0, visits.size(), 0, [&] (const unsigned long & begin, const unsigned long & end)
+                {
+                    for (auto i = begin ; i != end ; ++i)
+                    {
+                        visits[i] += 1;
+                    }
+                });
+
+                for (auto v : visits)
+                {
+                    TEST_CHECK_EQUAL(1u, v);
+                }
+
+                pool->parallel_for(13, 13, 1, [&] (const unsigned long &, const unsigned long &)
+                {
+                    visits[0] += 1;
+                });
+                TEST_CHECK_EQUAL(1u, visits[0]);
+            }
+
+            // parallel_for_parts covers the range with contiguous, non-empty parts, once each
+            {
+                for (unsigned long size : { 0ul, 3ul, 10007ul })
+                {
+                    const unsigned long number_of_parts = 2 * pool->number_of_threads() + 1;
+                    const unsigned long parts = std::min(size, number_of_parts);
+
+                    std::vector<unsigned> visits(size, 0);
+                    std::vector<std::pair<unsigned long, unsigned long>> ranges(parts, std::make_pair(0ul, 0ul));
+                    std::atomic<unsigned> calls(0);
+
+                    pool->parallel_for_parts(size, number_of_parts, [&] (const unsigned long & part, const unsigned long & begin, const unsigned long & end)
+                    {
+                        ++calls;
+                        ranges[part] = std::make_pair(begin, end);
+                        for (auto i = begin ; i != end ; ++i)
+                        {
+                            visits[i] += 1;
+                        }
+                    });
+
+                    TEST_CHECK_EQUAL(parts, calls);
+                    for (auto v : visits)
+                    {
+                        TEST_CHECK_EQUAL(1u, v);
+                    }
+
+                    unsigned long next = 0;
+                    for (const auto & r : ranges)
+                    {
+                        TEST_CHECK_EQUAL(next, r.first);
+                        TEST_CHECK(r.first < r.second);
+                        next = r.second;
+                    }
+                    TEST_CHECK_EQUAL(size, next);
+                }
+            }
+
+            // Nested task groups do not dead lock
+            {
+                Mutex mutex;
+                unsigned counter = 0;
+
+                TaskGroup outer;
+                for (unsigned i = 0 ; i < 4 * pool->number_of_threads() ; ++i)
+                {
+                    outer.run([&] ()
+                    {
+                        TaskGroup inner;
+                        for (unsigned j = 0 ; j < 16 ; ++j)
+                        {
+                            inner.run([&] () { Lock l(mutex); ++counter; });
+                        }
+                        inner.wait();
+                    });
+                }
+                outer.wait();
+
+                TEST_CHECK_EQUAL(4 * pool->number_of_threads() * 16, counter);
+            }
+
+            // Waiting for a task group does not execute unrelated jobs
+            {
+                std::atomic<bool> release(false);
+                std::atomic<unsigned> blocked_workers(0);
+                std::atomic<bool> unrelated_job_executed(false);
+
+                // occupy all workers
+                TaskGroup blockers;
+                for (unsigned i = 0 ; i < pool->number_of_threads() ; ++i)
+                {
+                    blockers.run([&] ()
+                    {
+                        ++blocked_workers;
+                        while (! release)
+                        {
+                            std::this_thread::yield();
+                        }
+                    });
+                }
+
+                while (blocked_workers < pool->number_of_threads())
+                {
+                    std::this_thread::yield();
+                }
+
+                Ticket unrelated_job = pool->enqueue([&] () { unrelated_job_executed = true; });
+
+                unsigned counter = 0;
+                TaskGroup group;
+                group.run([&] () { ++counter; });
+                group.wait();
+
+                const bool executed_while_waiting = unrelated_job_executed;
+
+                release = true;
+                blockers.wait();
+                unrelated_job.wait();
+
+                TEST_CHECK_EQUAL(1u, counter);
+                TEST_CHECK(! executed_while_waiting);
+                TEST_CHECK(unrelated_job_executed);
+            }
+
+            // Waiting for free capacity does not execute jobs of other threads
+            {
+                std::atomic<bool> release(false);
+                std::atomic<unsigned> blocked_workers(0);
+
+                // occupy all workers
+                TaskGroup blockers;
+                for (unsigned i = 0 ; i < pool->number_of_threads() ; ++i)
+                {
+                    blockers.run([&] ()
+                    {
+                        ++blocked_workers;
+                        while (! release)
+                        {
+                            std::this_thread::yield();
+                        }
+                    });
+                }
+
+                while (blocked_workers < pool->number_of_threads())
+                {
+                    std::this_thread::yield();
+                }
+
+                std::thread::id producer_id;
+                std::atomic<bool> producer_started(false);
+                std::atomic<bool> executed_by_producer(false);
+
+                std::vector<Ticket> tickets;
+                for (unsigned i = 0 ; i < 30 * pool->number_of_threads() ; ++i)
+                {
+                    tickets.push_back(pool->enqueue([&] ()
+                    {
+                        if (std::this_thread::get_id() == producer_id)
+                            executed_by_producer = true;
+                    }));
+                }
+
+                std::thread producer([&] ()
+                {
+                    producer_id = std::this_thread::get_id();
+                    producer_started = true;
+                    pool->wait_for_free_capacity();
+                });
+
+                while (! producer_started)
+                {
+                    std::this_thread::yield();
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+                release = true;
+                producer.join();
+                blockers.wait();
+
+                for (auto & t : tickets)
+                {
+                    t.wait();
+                }
+
+                TEST_CHECK(! executed_by_producer);
+            }
+
+            // Exceptions are propagated to the waiting thread
+            {
+                TaskGroup group;
+                group.run([] () { throw InternalError("thrown from within a task"); });
+                group.run([] () { });
+
+                TEST_CHECK_THROWS(InternalError, group.wait());
+            }
+        }
+} thread_pool_test;
@@ -110,6 +110,130 @@ namespace impl
         }
     };
 
+    // view on a C-contiguous buffer of doubles, e.g., from a NumPy array
+    class DoubleBuffer
+    {
+        private:
+            Py_buffer _buffer;
+
+        public:
+            DoubleBuffer(object o, bool writable)
+            {
+                const int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+                if (0 != PyObject_GetBuffer(o.ptr(), &_buffer, flags))
+                    throw_error_already_set();
+
+                if ((nullptr == _buffer.format) || (std::string("d") != _buffer.format))
+                {
+                    PyBuffer_Release(&_buffer);
+                    PyErr_SetString(PyExc_TypeError, "expected a contiguous buffer of doubles");
+                    throw_error_already_set();
+                }
+            }
+
+            // the buffer is released exactly once, by its owner
+            DoubleBuffer(const DoubleBuffer &) = delete;
+            DoubleBuffer & operator= (const DoubleBuffer &) = delete;
+
+            ~DoubleBuffer()
+            {
+                PyBuffer_Release(&_buffer);
+            }
+
+            double * data() const
+            {
+                return static_cast<double *>(_buffer.buf);
+            }
+
+            std::size_t ndim() const
+            {
+                return _buffer.ndim;
+            }
+
+            std::size_t shape(const std::size_t & i) const
+            {
+                return _buffer.shape[i];
+            }
+
+            std::size_t size() const
+            {
+                return _buffer.len / sizeof(double);
+            }
+    };
+
+    // release the global interpreter lock for the lifetime of this object
+    class ReleaseGIL
+    {
+        private:
+            PyThreadState * _state;
+
+        public:
+            ReleaseGIL() :
+                _state(PyEval_SaveThread())
+            {
+            }
+
+            ~ReleaseGIL()
+            {
+                PyEval_RestoreThread(_state);
+            }
+    };
+
+    // evaluate the log(posterior) for an (N, dim) array of points into an array of N values
+    void
+    LogPosterior_evaluate_batch(const LogPosterior & log_posterior, object points, object values)
+    {
+        DoubleBuffer in(points, false), out(values, true);
+
+        if (2 != in.ndim())
+        {
+            PyErr_SetString(PyExc_ValueError, "expected the points as a two-dimensional array");
+            throw_error_already_set();
+        }
+
+        const std::size_t n = in.shape(0), dim = in.shape(1);
+        if (out.size() != n)
+        {
+            PyErr_SetString(PyExc_ValueError, "expected one value per point");
+            throw_error_already_set();
+        }
+
+        ReleaseGIL release;
+        log_posterior.evaluate_batch(in.data(), n, dim, out.data());
+    }
+
+    // evaluate an observable on an array of kinematic points, with one column per variable
+    object
+    Observable_evaluate_grid(const Observable & observable, list variables, object values)
+    {
+        object numpy = import("numpy");
+
+        std::vector<std::string> names;
+        for (unsigned i = 0 ; i < len(variables) ; ++i)
+        {
+            names.push_back(extract<std::string>(variables[i]));
+        }
+
+        object points = numpy.attr("ascontiguousarray")(values, "float64");
+        DoubleBuffer in(points, false);
+        if (names.empty() || (in.ndim() > 2) || ((in.ndim() == 2) && (in.shape(1) != names.size())) || ((in.ndim() < 2) && (names.size() != 1)))
+        {
+            PyErr_SetString(PyExc_ValueError, "expected the points as an array with one column per kinematic variable");
+            throw_error_already_set();
+        }
+
+        const std::size_t n = in.size() / names.size();
+        object result = numpy.attr("empty")(n);
+        DoubleBuffer out(result, true);
+
+        {
+            ReleaseGIL release;
+            observable.evaluate_grid(names, in.data(), n, out.data());
+        }
+
+        return result;
+    }
+
     const char *
     version(void)
     {
@@ -180,6 +304,7 @@ BOOST_PYTHON_MODULE(_eos)
         .staticmethod("Defaults")
         .def("__getitem__", (Parameter (Parameters::*)(const std::string &) const) &Parameters::operator[])
         .def("by_id", (Parameter (Parameters::*)(const Parameter::Id &) const) &Parameters::operator[])
+        .def("generation", (unsigned long (Parameters::*)() const) &Parameters::generation)
         .def("__iter__", range(&Parameters::begin, &Parameters::end))
         .def("declare", &Parameters::declare, return_value_policy<return_by_value>())
         .def("sections", range(&Parameters::begin_sections, &Parameters::end_sections))
@@ -264,6 +389,10 @@ BOOST_PYTHON_MODULE(_eos)
     // ObservableCache
     class_<ObservableCache>("ObservableCache", no_init)
         .def("__iter__", range(&ObservableCache::begin, &ObservableCache::end))
+        .def("set_parallel", &ObservableCache::set_parallel)
+        .def("parallel", &ObservableCache::parallel)
+        .def("set_incremental", &ObservableCache::set_incremental)
+        .def("incremental", &ObservableCache::incremental)
         ;
     // }}}
 
@@ -318,6 +447,7 @@ BOOST_PYTHON_MODULE(_eos)
     class_<LogPosterior>("LogPosterior", init<LogLikelihood>())
         .def("add", &LogPosterior::add)
         .def("evaluate", &LogPosterior::evaluate)
+        .def("evaluate_batch", &impl::LogPosterior_evaluate_batch)
         ;
 
     // test_statistics::ChiSquare
@@ -343,6 +473,7 @@ BOOST_PYTHON_MODULE(_eos)
         .def("make", &Observable::make, return_value_policy<return_by_value>())
         .staticmethod("make")
         .def("evaluate", &Observable::evaluate)
+        .def("evaluate_grid", &impl::Observable_evaluate_grid)
         .def("name", &Observable::name, return_value_policy<copy_const_reference>())
         .def("options", &Observable::options)
         ;
@@ -188,6 +188,23 @@ class Analysis:
         return(-self.log_posterior.evaluate())
 
 
+    def log_pdf_batch(self, x):
+        """
+        Evaluates the log(posterior) at many parameter points at once, using all threads of EOS' thread pool.
+
+        The parameter values of this analysis are left unchanged.
+
+        :param x: Parameter points as an array of shape (N, D), with the D elements of each point in the same order as in eos.Analysis.varied_parameters.
+        :type x: array-like
+        :return: The log(posterior) values as an array of size N.
+        """
+        points = np.ascontiguousarray(x, dtype=np.float64)
+        result = np.empty(points.shape[0])
+        self.log_posterior.evaluate_batch(points, result)
+
+        return result
+
+
     def sample(self, N=1000, stride=5, pre_N=150, preruns=3, cov_scale=0.1, observables=None, start_point=None):
         """
         Return samples of the parameters, log(weights), and optionally posterior-predictive samples for a sequence of observables.
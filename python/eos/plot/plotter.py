@@ -248,10 +248,14 @@ class Plotter:
                 raise KeyError('neither kinematic variable nor parameter found; do not know how to map x to a variable')
             if ('kinematic' in item or 'variable' in item) and 'parameter' in item:
                 raise KeyError('both kinematic variable and parameter found; do not know how to map x to a variable')
+            kinematic_name = None
             if 'kinematic' in item:
-                var = kinematics.declare(item['kinematic'], np.nan)
+                kinematic_name = item['kinematic']
             elif 'variable' in item:
-                var = kinematics.declare(item['variable'], np.nan)
+                kinematic_name = item['variable']
+
+            if kinematic_name:
+                var = kinematics.declare(kinematic_name, np.nan)
             else:
                 var = parameters.declare(item['parameter'], np.nan)
 
@@ -266,10 +270,13 @@ class Plotter:
             observable = eos.Observable.make(oname, parameters, kinematics, options)
 
             xvalues = np.linspace(self.xlo, self.xhi, self.xsamples + 1)
-            ovalues = np.array([])
-            for xvalue in xvalues:
-                var.set(xvalue)
-                ovalues = np.append(ovalues, observable.evaluate())
+            if kinematic_name:
+                ovalues = observable.evaluate_grid([kinematic_name], xvalues)
+            else:
+                ovalues = np.empty(len(xvalues))
+                for i, xvalue in enumerate(xvalues):
+                    var.set(xvalue)
+                    ovalues[i] = observable.evaluate()
 
             plt.plot(xvalues, ovalues, alpha=self.alpha, color=self.color, label=self.label, ls=self.style)
 
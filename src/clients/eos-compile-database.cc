@@ -0,0 +1,122 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2020 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "cli_handler.hh"
+#include "cli_error.hh"
+
+#include <eos/constraint.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/parameters.hh>
+
+#include <iostream>
+
+using namespace eos;
+
+using std::cerr;
+using std::cout;
+using std::endl;
+
+struct CommandLine :
+    cli::DefaultHandler
+{
+    virtual std::string app_name() const { return "eos-compile-database"; }
+
+    virtual std::string app_synopsis() const
+    {
+        return "A commandline client to compile the constraint or parameter input files into a binary database.";
+    }
+
+    virtual std::string app_description() const
+    {
+        return "The database is used in place of the input files, if it resides in the same directory and is "
+            "was compiled from the current contents of the input files. Name it 'constraints.db' or 'parameters.db', respectively.";
+    }
+
+    cli::Group g_input_options;
+    cli::StringArg a_constraints;
+    cli::StringArg a_parameters;
+
+    cli::Group g_output_options;
+    cli::StringArg a_output;
+
+    CommandLine() :
+        g_input_options(main_options_section(), "Input Options", "Options that select the input files"),
+        a_constraints(&g_input_options, "constraints", 'c', "compile the constraint input files in this directory"),
+        a_parameters(&g_input_options,  "parameters",  'p', "compile the parameter input files in this directory"),
+
+        g_output_options(main_options_section(), "Output Options", "Options that control the output"),
+        a_output(&g_output_options, "output", 'o', "the name of the database file")
+    {
+    }
+};
+
+int main(int argc, char ** argv)
+{
+    try
+    {
+        CommandLine cmdline;
+        cmdline.run(argc, argv, "eos-compile-database");
+        if (cmdline.a_help.specified())
+        {
+            cout << cmdline;
+            return EXIT_SUCCESS;
+        }
+        else if (cmdline.a_version.specified())
+        {
+            cout << "0.0";
+            cout << endl;
+            return EXIT_SUCCESS;
+        }
+
+        if (cmdline.a_constraints.specified() == cmdline.a_parameters.specified())
+            throw cli::DoHelp("exactly one of --constraints and --parameters must be specified");
+
+        if (! cmdline.a_output.specified())
+            throw cli::DoHelp("no output file specified");
+
+        if (cmdline.a_constraints.specified())
+        {
+            Constraints::compile_database(cmdline.a_constraints.argument(), cmdline.a_output.argument());
+        }
+        else
+        {
+            Parameters::compile_database(cmdline.a_parameters.argument(), cmdline.a_output.argument());
+        }
+
+        return EXIT_SUCCESS;
+    }
+    catch (const cli::DoHelp & h)
+    {
+        if (h.message.empty())
+            cout << "Usage: " << argv[0] << " [--constraints DIR | --parameters DIR] --output FILE" << endl;
+        else
+            cerr << "Usage error: " << h.message << endl;
+
+        return EXIT_FAILURE;
+    }
+    catch (const Exception & e)
+    {
+        cerr << endl;
+        cerr << "Error:" << endl;
+        cerr << "  * " << e.what() << endl;
+        cerr << endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2010, 2011 Danny van Dyk
+ * Copyright (c) 2010, 2011, 2020 Danny van Dyk
  *
  * This file is part of the EOS project. EOS is free software;
  * you can redistribute it and/or modify it under the terms of the GNU General
@@ -20,10 +20,15 @@
 #include <eos/observable.hh>
 #include <eos/utils/cartesian-product.hh>
 #include <eos/utils/destringify.hh>
+#include <eos/utils/hdf5.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/join.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/power_of.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -78,6 +83,8 @@ class CommandLine :
 
         int precision;
 
+        std::shared_ptr<hdf5::File> output_file;
+
         CommandLine() :
             parameters(Parameters::Defaults()),
             budgets{std::make_tuple(std::string("delta"), std::vector<Parameter>())},
@@ -103,6 +110,14 @@ class CommandLine :
                 	continue;
                 }
 
+                if ("--output" == argument)
+                {
+                    std::string filename(*(++a));
+                    output_file.reset(new hdf5::File(hdf5::File::Create(filename)));
+
+                    continue;
+                }
+
                 if ("--kinematics" == argument)
                 {
                     std::string name = std::string(*(++a));
@@ -208,113 +223,223 @@ class CommandLine :
         }
 };
 
-void evaluate_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluation_input)
+// one clone of the observable per thread, with its own kinematics and parameters
+struct Worker
 {
-    // print headlines
-    std::cout << "# " << evaluation_input->observable->name()
-              << ": " << evaluation_input->observable->options().as_string() << std::endl;
+    ObservablePtr observable;
+
+    std::vector<KinematicVariable> kinematics;
 
-    std::cout << "# ";
-    for (std::size_t i = 0 ; i < evaluation_input->kinematic_names.size() ; ++i)
+    // the varied parameters of all budgets, in order
+    std::vector<Parameter> variations;
+
+    Worker(const EvaluationInput & evaluation_input) :
+        observable(evaluation_input.observable->clone())
     {
-        std::cout << evaluation_input->kinematic_names[i] << '\t';
+        Kinematics k = observable->kinematics();
+        for (const auto & n : evaluation_input.kinematic_names)
+        {
+            kinematics.push_back(k[n]);
+        }
+
+        Parameters p = observable->parameters();
+        for (const auto & b : CommandLine::instance()->budgets)
+        {
+            for (const auto & v : std::get<1>(b))
+            {
+                variations.push_back(p[v.id()]);
+            }
+        }
     }
-    std::cout << "central";
-    for (auto b = CommandLine::instance()->budgets.begin() ; b != CommandLine::instance()->budgets.end(); ++b)
+};
+
+/*
+ * Evaluate the observable for a block of kinematic points. For each point, the central value
+ * is followed by the values with each varied parameter raised to its maximum and lowered to its minimum.
+ */
+void evaluate_block(std::vector<Worker> & workers, const std::vector<std::vector<double>> & points,
+        const std::size_t & begin, const std::size_t & end, std::vector<double> & values)
+{
+    const std::size_t evaluations = 1 + 2 * workers.front().variations.size();
+    const std::size_t units = (end - begin) * evaluations;
+
+    values.resize(units);
+
+    // contiguous ranges of evaluations, one per worker
+    ThreadPool::instance()->parallel_for_parts(units, workers.size(), [&] (const unsigned long & w, const unsigned long & u_begin, const unsigned long & u_end)
     {
-        std::cout << '\t' << std::get<0>(*b) << "_min\t" << std::get<0>(*b) << "_max";
+        Worker & worker = workers[w];
+
+        for (auto u = u_begin ; u != u_end ; ++u)
+        {
+            const auto & point = points[begin + u / evaluations];
+            for (std::size_t i = 0 ; i < point.size() ; ++i)
+            {
+                worker.kinematics[i] = point[i];
+            }
+
+            const std::size_t e = u % evaluations;
+            if (0 == e)
+            {
+                values[u] = worker.observable->evaluate();
+                continue;
+            }
+
+            Parameter & v = worker.variations[(e - 1) / 2];
+            const double old_v = v();
+            v = (1 == e % 2) ? v.max() : v.min();
+            values[u] = worker.observable->evaluate();
+            v = old_v;
+        }
+    });
+}
+
+void evaluate_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluation_input, const unsigned & index)
+{
+    const auto & budgets = CommandLine::instance()->budgets;
+    auto output_file = CommandLine::instance()->output_file;
+
+    std::vector<std::string> column_names(evaluation_input->kinematic_names);
+    column_names.push_back("central");
+    for (auto b = budgets.begin() ; b != budgets.end(); ++b)
+    {
+        column_names.push_back(std::get<0>(*b) + "_min");
+        column_names.push_back(std::get<0>(*b) + "_max");
     }
-    std::cout << "\tdelta_min\tdelta_max" << std::endl;
+    column_names.push_back("delta_min");
+    column_names.push_back("delta_max");
 
-    int precision = CommandLine::instance()->precision;
-    // set requested precision
-    if (precision != -1)
-        std::cout.precision(precision);
+    std::shared_ptr<hdf5::DataSet<hdf5::Array<1, double>>> data_set;
+    if (output_file)
+    {
+        data_set.reset(new hdf5::DataSet<hdf5::Array<1, double>>(output_file->create_data_set("/data/" + stringify(index),
+                hdf5::Array<1, double>("evaluation", { column_names.size() }))));
 
-    bool ranges_empty = false;
-    // check if the kinematical ranges are empty
-    if (evaluation_input->ranges.size() == 0)
+        auto attr_name = data_set->create_attribute("name", hdf5::Scalar<const char *>("name"));
+        attr_name = evaluation_input->observable->name().str().c_str();
+
+        auto attr_options = data_set->create_attribute("options", hdf5::Scalar<const char *>("options"));
+        attr_options = evaluation_input->observable->options().as_string().c_str();
+
+        auto attr_columns = data_set->create_attribute("columns", hdf5::Scalar<const char *>("columns"));
+        attr_columns = join(column_names.cbegin(), column_names.cend(), ",").c_str();
+    }
+    else
     {
-        ranges_empty = true;
+        // print headlines
+        std::cout << "# " << evaluation_input->observable->name()
+                  << ": " << evaluation_input->observable->options().as_string() << std::endl;
+
+        std::cout << "# ";
+        for (std::size_t i = 0 ; i < evaluation_input->kinematic_names.size() ; ++i)
+        {
+            std::cout << evaluation_input->kinematic_names[i] << '\t';
+        }
+        std::cout << "central";
+        for (auto b = budgets.begin() ; b != budgets.end(); ++b)
+        {
+            std::cout << '\t' << std::get<0>(*b) << "_min\t" << std::get<0>(*b) << "_max";
+        }
+        std::cout << "\tdelta_min\tdelta_max" << std::endl;
 
-        // create a vector with a single entry
-        std::vector<double> range(1, 1.0);
-        // insert a dummy value for the for-loop
-        evaluation_input->ranges.over(range);
+        int precision = CommandLine::instance()->precision;
+        // set requested precision
+        if (precision != -1)
+            std::cout.precision(precision);
     }
 
-    // iterate over all kinematical ranges
-    for (auto r = evaluation_input->ranges.begin() ; r != evaluation_input->ranges.end() ; ++r)
+    // collect all kinematic points; without kinematic ranges, evaluate once
+    std::vector<std::vector<double>> points;
+    if (evaluation_input->ranges.size() == 0)
+    {
+        points.push_back(std::vector<double>());
+    }
+    else
     {
-        if (!ranges_empty)
+        for (auto r = evaluation_input->ranges.begin() ; r != evaluation_input->ranges.end() ; ++r)
         {
-            // set the kinematics
-            // for every dimension
-            for (std::size_t i = 0 ; i < (*r).size() ; ++i)
-            {
-                evaluation_input->kinematics->set(evaluation_input->kinematic_names[i], (*r)[i]);
-                std::cout << (*r)[i] << '\t';
-            }
+            points.push_back(*r);
         }
+    }
+
+    std::vector<Worker> workers;
+    for (unsigned i = 0 ; i < ThreadPool::instance()->number_of_threads() ; ++i)
+    {
+        workers.emplace_back(*evaluation_input);
+    }
 
-        double central = evaluation_input->observable->evaluate();
+    const std::size_t evaluations = 1 + 2 * workers.front().variations.size();
 
-        std::cout << central;
+    // evaluate in blocks of points, and write the results of each block in order
+    const std::size_t block_size = 64 * workers.size();
+    std::vector<double> values;
+    std::vector<double> row;
+    for (std::size_t block_begin = 0 ; block_begin < points.size() ; block_begin += block_size)
+    {
+        const std::size_t block_end = std::min(block_begin + block_size, points.size());
+        evaluate_block(workers, points, block_begin, block_end, values);
 
-        // do the variations
-        double delta_max = 0.0, delta_min = 0.0;
-        for (auto b = CommandLine::instance()->budgets.begin() ; b != CommandLine::instance()->budgets.end() ; ++b)
+        for (std::size_t p = block_begin ; p != block_end ; ++p)
         {
-            double budget_min = 0.0;
-            double budget_max = 0.0;
+            auto value = values.cbegin() + (p - block_begin) * evaluations;
+            const double central = *value;
+            ++value;
 
-            std::vector<Parameter> variations = std::get<1>(*b);
+            row = points[p];
+            row.push_back(central);
 
-            for (auto v = variations.begin(), v_end = variations.end() ; v != v_end ; ++v)
+            double delta_max = 0.0, delta_min = 0.0;
+            for (auto b = budgets.begin() ; b != budgets.end() ; ++b)
             {
-                double old_v = *v;
-
-                // raise value
-                *v = v->max();
-
-                double value = evaluation_input->observable->evaluate();
+                double budget_min = 0.0;
+                double budget_max = 0.0;
 
-                if (value > central)
+                // raised value, then lowered value of each variation
+                for (std::size_t i = 0, i_end = 2 * std::get<1>(*b).size() ; i != i_end ; ++i, ++value)
                 {
-                    budget_max += power_of<2>(value - central);
-                }
-                else if (value < central)
-                {
-                    budget_min += power_of<2>(value - central);
+                    if (*value > central)
+                    {
+                        budget_max += power_of<2>(*value - central);
+                    }
+                    else if (*value < central)
+                    {
+                        budget_min += power_of<2>(*value - central);
+                    }
                 }
 
-                // lower value
-                *v = v->min();
+                delta_min += budget_min;
+                delta_max += budget_max;
 
-                value = evaluation_input->observable->evaluate();
+                row.push_back(std::sqrt(budget_min));
+                row.push_back(std::sqrt(budget_max));
+            }
 
-                if (value > central)
-                {
-                    budget_max += power_of<2>(value - central);
-                }
-                else if (value < central)
-                {
-                    budget_min += power_of<2>(value - central);
-                }
+            row.push_back(std::sqrt(delta_min));
+            row.push_back(std::sqrt(delta_max));
 
-                *v = old_v;
+            if (data_set)
+            {
+                *data_set << row;
+                continue;
             }
 
-            delta_min += budget_min;
-            delta_max += budget_max;
+            for (std::size_t i = 0 ; i < points[p].size() ; ++i)
+            {
+                std::cout << points[p][i] << '\t';
+            }
 
-            std::cout << '\t' << std::sqrt(budget_min) << '\t' << std::sqrt(budget_max);
-        }
+            std::cout << central;
 
-        std::cout
-            << '\t' << std::sqrt(delta_min) << '\t' << std::sqrt(delta_max)
-            << "   (-" << std::abs(std::sqrt(delta_min) / central) * 100 << "% / +" << std::abs(std::sqrt(delta_max) / central) * 100 << "%)"
-            << std::endl;
+            for (std::size_t i = points[p].size() + 1 ; i < row.size() - 2 ; i += 2)
+            {
+                std::cout << '\t' << row[i] << '\t' << row[i + 1];
+            }
+
+            std::cout
+                << '\t' << std::sqrt(delta_min) << '\t' << std::sqrt(delta_max)
+                << "   (-" << std::abs(std::sqrt(delta_min) / central) * 100 << "% / +" << std::abs(std::sqrt(delta_max) / central) * 100 << "%)"
+                << std::endl;
+        }
     }
 }
 
@@ -329,9 +454,10 @@ main(int argc, char * argv[])
         if (CommandLine::instance()->evaluation_inputs.empty())
             throw DoUsage("No input specified");
 
-        for (auto i = CommandLine::instance()->evaluation_inputs.cbegin(), i_end = CommandLine::instance()->evaluation_inputs.cend() ; i != i_end ; ++i)
+        const auto & evaluation_inputs = CommandLine::instance()->evaluation_inputs;
+        for (unsigned i = 0 ; i < evaluation_inputs.size() ; ++i)
         {
-            evaluate_with_sum_of_squares(*i);
+            evaluate_with_sum_of_squares(evaluation_inputs[i], i);
         }
     }
     catch(DoUsage & e)
@@ -339,6 +465,7 @@ main(int argc, char * argv[])
         std::cout << e.what() << std::endl;
         std::cout << "Usage: eos-evaluate" << std::endl;
         std::cout << "  [--precision PRECISION]" << std::endl;
+        std::cout << "  [--output HDF5FILE]" << std::endl;
         std::cout << "  [--vary PARAMETER]*" << std::endl;
         std::cout << "  [{--budget BUDGET[--parameter PARAMETER]*}*|{--parameter PARAMETER}*]" << std::endl;
         std::cout << "  [[--kinematics NAME VALUE|--range NAME MIN MAX POINTS]* --observable OBSERVABLE]*" << std::endl;
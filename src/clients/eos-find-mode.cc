@@ -390,6 +390,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--parallel-observables" == argument)
+                {
+                    likelihood.observable_cache().set_parallel(true);
+
+                    continue;
+                }
+
                 if ("--print-args" == argument)
                 {
                     // print arguments and quit
@@ -644,6 +651,7 @@ int main(int argc, char * argv[])
         std::cout << "  [--fix PARAMETER VALUE]+" << std::endl;
         std::cout << "  [--starting-point [{ PAR_VALUE1 PAR_VALUE2 ... PAR_VALUEN }]]" << std::endl;
         std::cout << "  [--max-iterations VALUE]" << std::endl;
+        std::cout << "  [--parallel-observables]" << std::endl;
         std::cout << "  [--target-precision VALUE]" << std::endl;
 
         std::cout << std::endl;
@@ -1,7 +1,7 @@
 /* vim: set sw=4 sts=4 et foldmethod=syntax : */
 
 /*
- * Copyright (c) 2011, 2013 Danny van Dyk
+ * Copyright (c) 2011, 2013, 2020 Danny van Dyk
  * Copyright (c) 2013 Frederik Beaujean
  *
  * This file is part of the EOS project. EOS is free software;
@@ -235,6 +235,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--asynchronous" == argument)
+                {
+                    mcmc_config.asynchronous = true;
+
+                    continue;
+                }
+
                 if ("--chains" == argument)
                 {
                     mcmc_config.number_of_chains = destringify<unsigned>(*(++a));
@@ -309,6 +316,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--incremental-observables" == argument)
+                {
+                    likelihood.observable_cache().set_incremental(true);
+
+                    continue;
+                }
+
                 if ("--no-prerun" == argument)
                 {
                     mcmc_config.need_prerun = false;
@@ -354,6 +368,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--parallel-observables" == argument)
+                {
+                    likelihood.observable_cache().set_parallel(true);
+
+                    continue;
+                }
+
                 // todo rename here and in scripts
                 if ("--prerun-chains-per-partition" == argument)
                 {
@@ -551,13 +572,16 @@ int main(int argc, char * argv[])
         std::cout << "  [ [--kinematics NAME VALUE]* --observable NAME LOWER CENTRAL UPPER]+" << std::endl;
         std::cout << "  [--constraint NAME]+" << std::endl;
         std::cout << "  [ [ [--scan PARAMETER MIN MAX] | [--nuisance PARAMETER MIN MAX] ] --prior [flat | [gaussian LOWER CENTRAL UPPER] ] ]+" << std::endl;
+        std::cout << "  [--asynchronous]" << std::endl;
         std::cout << "  [--chains VALUE]" << std::endl;
         std::cout << "  [--chunks VALUE]" << std::endl;
         std::cout << "  [--chunksize VALUE]" << std::endl;
         std::cout << "  [--debug]" << std::endl;
         std::cout << "  [--fix PARAMETER VALUE]+" << std::endl;
+        std::cout << "  [--incremental-observables]" << std::endl;
         std::cout << "  [--no-prerun]" << std::endl;
         std::cout << "  [--output FILENAME]" << std::endl;
+        std::cout << "  [--parallel-observables]" << std::endl;
         std::cout << "  [--scale VALUE]" << std::endl;
         std::cout << "  [--seed LONG_VALUE]" << std::endl;
         std::cout << "  [--store-prerun]" << std::endl;
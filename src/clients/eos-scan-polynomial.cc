@@ -285,8 +285,6 @@ class WilsonScannerPolynomial
 
         std::vector<std::tuple<ObservablePtr, double, double, double, std::vector<std::tuple<ObservablePtr, ObservablePtr>>>> _observables;
 
-        std::vector<Ticket> _tickets;
-
         ScanFile _output;
 
         std::vector<ScanFile::DataSet> _data_sets;
@@ -530,6 +528,8 @@ class WilsonScannerPolynomial
 
         void scan()
         {
+            TaskGroup scans;
+
             // Find chunk size for N chunks
             unsigned chunk_size = _points.size() / ThreadPool::instance()->number_of_threads();
 
@@ -550,7 +550,7 @@ class WilsonScannerPolynomial
                 }
                 f->name("posterior");
 
-                _tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&WilsonScannerPolynomial::scan_range, this, begin, end, i)));
+                scans.run(std::bind(&WilsonScannerPolynomial::scan_range, this, begin, end, i));
             }
 
             // Enqueue an extra job for the remains
@@ -561,13 +561,10 @@ class WilsonScannerPolynomial
                 f->name(p->name());
             }
             f->name("posterior");
-            _tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&WilsonScannerPolynomial::scan_range, this, c, _points.end(), i)));
+            scans.run(std::bind(&WilsonScannerPolynomial::scan_range, this, c, _points.end(), i));
 
             // Wait for job completion
-            for (auto t = _tickets.begin(), t_end = _tickets.end() ; t != t_end ; ++t)
-            {
-                t->wait();
-            }
+            scans.wait();
         }
 };
 
@@ -204,21 +204,21 @@ class WilsonScan
                     << std::endl;
             }
 
-            TicketList tickets;
+            TaskGroup scans;
             unsigned long jobs = 0;
             for (auto bin = bins.begin() ; bins.end() != bin ; ++bin)
             {
                 for (auto w = cp.begin() ; cp.end() != w ; ++w)
                 {
                     ThreadPool::instance()->wait_for_free_capacity();
-                    tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&WilsonScan::calc_chi_square, this, bin->first, bin->second, w)));
+                    scans.run(std::bind(&WilsonScan::calc_chi_square, this, bin->first, bin->second, w));
                     ++jobs;
                     if (jobs % 100 == 0)
                         std::cerr << '[' << jobs << '/' << cp.size() << ']' << std::endl;
                 }
             }
 
-            tickets.wait();
+            scans.wait();
 
             std::cout << std::scientific << std::setprecision(7);
             for (auto r = results.cbegin(), r_end = results.cend() ; r != r_end ; ++r)